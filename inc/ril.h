@@ -1,24 +1,115 @@
 #ifndef _RIL_H_
 #define _RIL_H_
 
-#define RIL_RX_STREAM_SIZE  256
-#define RIL_TX_STREAM_SIZE  256
-
+#include "ril_config.h"
 #include "usart.h"
+#include <stdbool.h>
 #include "StreamBuffer.h"
 #include "ril_error.h"
+#include "ril_stats.h"
+#include "ril_prefix.h"
+#include "ril_pool.h"
 
 /*******************************************************************************
 * RIL_SendATCmd response callback type
+* line is null terminated and does not include the trailing CR/LF.
+* The callback receives every intermediate line of the response, final result
+* codes and URCs are consumed by RIL. Return RIL_AT_RSP_FAILED to make
+* RIL_SendATCmd fail once the final result code arrives.
 ******************************************************************************/
 typedef uint32_t (*Callback_ATResponse)(char* line, uint32_t len, void* userData);
 
+/*******************************************************************************
+* RIL_SendATCmdAsync completion callback type, result is what RIL_SendATCmd
+* would have returned
+******************************************************************************/
+typedef void (*Callback_ATDone)(RIL_ATSndError result, void* userData);
+
+/*******************************************************************************
+* URC handler type, id is RIL_PREFIX_NONE for lines with an unknown prefix
+* that arrived while no command was running
+******************************************************************************/
+typedef void (*Callback_URC)(const char* line, uint32_t len, RIL_PrefixId id, void* userData);
+
+typedef enum {
+    RIL_POOL_COMMAND    = 0,    /**< Descriptors of RIL_SendATCmdAsync, RIL_CMD_POOL_SIZE */
+    RIL_POOL_URC        = 1,    /**< URC lines waiting for dispatch, RIL_URC_POOL_SIZE */
+} RIL_PoolId;
+
+#if RIL_FEATURE_NUMERIC_RESULT
+/*******************************************************************************
+* Final result code format, the value is the <n> of ATV<n>
+******************************************************************************/
+typedef enum {
+    RIL_RESULT_NUMERIC      = 0, /**< ATV0: "0\r" for OK, "4\r" for ERROR */
+    RIL_RESULT_VERBOSE      = 1, /**< ATV1: "\r\nOK\r\n" */
+} RIL_ResultFormat;
+
+#define RIL_RESULT_FORMAT_ANY   ((1U << RIL_RESULT_NUMERIC) | (1U << RIL_RESULT_VERBOSE))
+
+/*******************************************************************************
+ * @brief Selects the result code format RIL_initialize configures with ATV<n>.
+ *  Call it before RIL_initialize, the default is RIL_RESULT_VERBOSE.
+ *  The parser accepts both formats until the modem confirmed the selection.
+ ******************************************************************************/
+void RIL_setResultFormat(RIL_ResultFormat format);
+RIL_ResultFormat RIL_getResultFormat(void);
+#endif
+
+#if RIL_FEATURE_ECHO
+/*******************************************************************************
+* Command echo handling during RIL_initialize
+******************************************************************************/
+typedef enum {
+    RIL_ECHO_KEEP           = 0, /**< Leave the modem setting alone, saves the ATE round trip */
+    RIL_ECHO_OFF            = 1, /**< Send ATE0 and verify the next command is not echoed */
+    RIL_ECHO_ON             = 2, /**< Send ATE1 and verify the next command is echoed */
+} RIL_EchoMode;
+
+/*******************************************************************************
+ * @brief Selects the echo mode RIL_initialize applies, default is RIL_ECHO_KEEP.
+ *  Echoed commands are matched against the sent bytes and dropped in every mode,
+ *  so responses are parsed the same with echo on or off.
+ ******************************************************************************/
+void RIL_setEchoMode(RIL_EchoMode mode);
+
+/*******************************************************************************
+ * @brief Returns whether the modem echoed the last command.
+ ******************************************************************************/
+bool RIL_echoEnabled(void);
+#endif
+
 /*******************************************************************************
  * @brief This function initializes RIl-related functions.
  * Set the initial AT commands, please refer to "m_InitCmds".
  ******************************************************************************/
 RIL_ATSndError RIL_initialize(UART_HandleTypeDef* uart);
 
+#if RIL_FEATURE_SESSION
+/*******************************************************************************
+* @brief Writes the session state into blob before the MCU sleeps: result
+*   format, echo mode, capability flags, vendor profile, open sockets and the
+*   command cache. Keep it in backup SRAM or a file and hand it to RIL_resume.
+*   URC handlers are not part of it, register them again after RIL_resume,
+*   RIL_socket_init included.
+* @param size RIL_SESSION_SIZE holds everything with the default sizing,
+*   cached responses that do not fit are left out
+* @return bytes written, 0 while commands or URCs are pending, while a socket
+*   is busy (see RIL_socket_suspend) or when the fixed part does not fit
+******************************************************************************/
+uint32_t RIL_suspend(void* blob, uint32_t size);
+
+/*******************************************************************************
+* @brief Starts RIL from a RIL_suspend blob instead of RIL_initialize: the
+*   state is restored and one "AT" confirms the modem still answers.
+* @param sleptMs time spent asleep, cached responses older than their
+*   CacheAge are dropped. Pass 0 when the tick kept running.
+* @return RIL_AT_INVALID_PARAM when the blob is damaged or from another
+*   build, the result of the "AT" otherwise. On failure call RIL_initialize.
+******************************************************************************/
+RIL_ATSndError RIL_resume(UART_HandleTypeDef* uart, const void* blob, uint32_t len, uint32_t sleptMs);
+#endif
+
 /*******************************************************************************
 * @brief call in interrupt or RxCplt callback for Async Receive
 * @return Stream_Result
@@ -45,10 +136,111 @@ Stream_Result RIL_txCpltHandle(void);
 * @param timeOut [in]Timeout for the AT command, unit in ms. 
 *                    *If set it to 0, RIL uses the default timeout time (3min).
 *
+* The command is written to the TX stream from atCmd, followed by CRLF, without
+* an intermediate copy. It must fit RIL_TX_STREAM_SIZE together with the CRLF.
+* While earlier bytes still fill the stream the command waits for room, a
+* wait longer than timeOut ends with RIL_AT_TIMEOUT.
+*
 * @return A member of RIL_ATSndError enum
 ******************************************************************************/
-RIL_ATSndError RIL_SendATCmd(char*  atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack, void* userData, uint32_t timeOut);
+RIL_ATSndError RIL_SendATCmd(const char* atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack, void* userData, uint32_t timeOut);
+
+/******************************************************************************
+* @brief Queues an AT command and returns at once. The command goes out after
+*   the ones queued before it, the response is handled from RIL_process:
+*   atRsp_callBack gets the intermediate lines and done the result.
+*   The command is copied, atCmd does not have to outlive the call.
+*
+* @return RIL_AT_SUCCESS when queued, RIL_AT_BUSY when the command pool is
+*   exhausted, RIL_AT_INVALID_PARAM when the command exceeds RIL_CMD_LEN
+******************************************************************************/
+RIL_ATSndError RIL_SendATCmdAsync(const char* atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut);
+
+#if RIL_FEATURE_PAYLOAD
+/*******************************************************************************
+* Raw data of a response, see RIL_readPayload. data points into the RX stream
+* and is only valid during the call.
+******************************************************************************/
+typedef void (*Callback_ATData)(const uint8_t* data, uint32_t len, void* userData);
+
+/**
+ * Raw data around a command, e.g. AT+QISEND=<id>,<len> and AT+QIRD=<id>,<len>
+ */
+typedef struct {
+    const void*         Data;       /**< Written after Prompt, must stay valid until done runs, NULL for none */
+    uint32_t            Len;
+    /* Response line that carries its data inline after the first quote, e.g. "+USORD:".
+       The line is cut at the quote, so the callback can call RIL_readPayload */
+    const char*         Inline;
+    char                Prompt;     /**< Sent by the modem when it takes Data, 0 to write it right after the command */
+} RIL_Payload;
+
+/******************************************************************************
+* @brief RIL_SendATCmdAsync with raw data: Data is written from the caller's
+*   buffer once the modem sent Prompt, without a copy or hex encoding.
+*   Final results like "SEND OK" complete the command as usual.
+*
+* @return same as RIL_SendATCmdAsync
+******************************************************************************/
+RIL_ATSndError RIL_SendATCmdPayload(const char* atCmd, uint32_t atCmdLen, const RIL_Payload* payload,
+                                    Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut);
+
+/******************************************************************************
+* @brief Called from a response callback: the len bytes after the current line
+*   are raw data, they go to sink in spans as they arrive instead of through
+*   the line parser. A line terminator between the line and the data is
+*   dropped, as is the closing quote of Inline data.
+******************************************************************************/
+void RIL_readPayload(uint32_t len, Callback_ATData sink, void* userData);
+
+/******************************************************************************
+* @brief Sets the handler that sees every URC line as soon as the parser has
+*   it, before the line is queued for RIL_process to dispatch. It may call
+*   RIL_readPayload for data the modem pushes right behind the line, like
+*   +QIURC: "recv",<id>,<len> in direct push mode. The URC handlers still get
+*   the line afterwards. NULL removes it.
+******************************************************************************/
+void RIL_setURCDataHandler(Callback_URC handler, void* userData);
+#endif
+
+/******************************************************************************
+* @brief Runs the engine: sends queued commands, parses received lines,
+*   enforces timeouts and dispatches URCs. Call it from the main loop.
+*   RIL_SendATCmd must not be called from callbacks running inside it.
+******************************************************************************/
+void RIL_process(void);
+
+/******************************************************************************
+* @brief Returns true when no command is queued or running and no URC waits.
+******************************************************************************/
+bool RIL_isIdle(void);
 
+/******************************************************************************
+* @brief Registers a URC handler, every handler sees every URC.
+* @return RIL_AT_BUSY when all RIL_URC_HANDLERS slots are taken
+******************************************************************************/
+RIL_ATSndError RIL_addURCHandler(Callback_URC handler, void* userData);
+void RIL_removeURCHandler(Callback_URC handler, void* userData);
+
+/******************************************************************************
+* @brief Returns usage, peak and exhaustion counters of a RIL object pool.
+******************************************************************************/
+RIL_PoolStats RIL_getPoolStats(RIL_PoolId id);
+
+#if RIL_FEATURE_BUFFER_STATS
+/******************************************************************************
+* @brief Returns the high-water mark, time above 75% and near-overrun counters
+*   of a RIL buffer. Pass them to RIL_bufferStats_recommend to size the buffer
+*   from a long-running session.
+* @return statistics of the buffer, NULL for an invalid id
+******************************************************************************/
+const RIL_BufferStats* RIL_getBufferStats(RIL_BufferId id);
+
+/******************************************************************************
+* @brief Restarts statistics collection, RIL_initialize calls it too.
+******************************************************************************/
+void RIL_resetBufferStats(void);
+#endif
 
 /******************************************************************************  
 * @brief This function retrieves the specific error code after executing AT failed.
@@ -0,0 +1,354 @@
+/**
+ * @file ril.hpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Header-only C++17 interface of RIL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Commands are std::string_view, callbacks are lambdas kept in fixed-size
+ * InplaceFunction storage. No heap, no virtual calls, no exceptions or RTTI
+ * needed: builds with -fno-exceptions -fno-rtti. Raw data is a ByteSpan,
+ * std::span<const std::byte> when built as C++20.
+ */
+
+#ifndef _RIL_HPP_
+#define _RIL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 202002L
+    #include <span>
+#endif
+
+extern "C" {
+#include "ril.h"
+}
+
+namespace ril {
+
+/**
+ * Move-only callable wrapper with inline storage of Capacity bytes.
+ * A callable that does not fit is rejected at compile time.
+ */
+template <typename Signature, std::size_t Capacity = RIL_CPP_CALLBACK_SIZE>
+class InplaceFunction;
+
+template <typename R, typename... Args, std::size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+public:
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+    InplaceFunction(F&& fn) noexcept {
+        using Fn = std::decay_t<F>;
+        static_assert(std::is_invocable_r_v<R, Fn&, Args...>, "callable does not match the signature of the callback");
+        static_assert(sizeof(Fn) <= Capacity, "callable captures too much, raise RIL_CPP_CALLBACK_SIZE");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable is over-aligned");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "callable must be nothrow movable");
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+        ops_ = &OpsFor<Fn>::Table;
+    }
+
+    InplaceFunction(InplaceFunction&& other) noexcept {
+        moveFrom(other);
+    }
+
+    InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction(const InplaceFunction&) = delete;
+    InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+    ~InplaceFunction() {
+        reset();
+    }
+
+    explicit operator bool() const noexcept {
+        return ops_ != nullptr;
+    }
+
+    R operator()(Args... args) {
+        return ops_->Invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    void reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->Destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        R (*Invoke)(void* fn, Args&&... args);
+        void (*Move)(void* dst, void* src) noexcept;
+        void (*Destroy)(void* fn) noexcept;
+    };
+
+    template <typename Fn>
+    struct OpsFor {
+        static R invoke(void* fn, Args&&... args) {
+            return (*static_cast<Fn*>(fn))(std::forward<Args>(args)...);
+        }
+        static void move(void* dst, void* src) noexcept {
+            ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+            static_cast<Fn*>(src)->~Fn();
+        }
+        static void destroy(void* fn) noexcept {
+            static_cast<Fn*>(fn)->~Fn();
+        }
+        static constexpr Ops Table = { invoke, move, destroy };
+    };
+
+    void moveFrom(InplaceFunction& other) noexcept {
+        if (other.ops_ != nullptr) {
+            other.ops_->Move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    const Ops* ops_ = nullptr;
+};
+
+using Result = RIL_ATSndError;
+/** Gets every intermediate line, returns RIL_AT_RSP_FAILED to fail the command */
+using LineCallback = InplaceFunction<RIL_ATRspError(std::string_view line)>;
+using DoneCallback = InplaceFunction<void(Result result)>;
+using UrcCallback = InplaceFunction<void(std::string_view line, RIL_PrefixId id)>;
+
+#if __cplusplus >= 202002L
+using ByteSpan = std::span<const std::byte>;
+#else
+/**
+ * Read-only view of raw bytes, std::span<const std::byte> from C++20 on
+ */
+class ByteSpan {
+public:
+    constexpr ByteSpan() noexcept = default;
+    constexpr ByteSpan(const std::byte* data, std::size_t size) noexcept : data_(data), size_(size) {}
+    template <std::size_t N>
+    constexpr ByteSpan(const std::byte (&data)[N]) noexcept : data_(data), size_(N) {}
+
+    constexpr const std::byte* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr const std::byte* begin() const noexcept { return data_; }
+    constexpr const std::byte* end() const noexcept { return data_ + size_; }
+    constexpr const std::byte& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+private:
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+#endif
+
+#if RIL_FEATURE_PAYLOAD
+/** Gets the raw data armed by Ril::readPayload, in spans as it arrives */
+using DataCallback = InplaceFunction<void(ByteSpan data)>;
+#endif
+
+namespace detail {
+
+/**
+ * What a line callback may return: RIL_ATRspError or a plain integer of its values
+ */
+template <typename T>
+inline constexpr bool IsLineResult = std::is_same_v<T, RIL_ATRspError> ||
+                                     (std::is_integral_v<T> && !std::is_same_v<T, bool>);
+
+/**
+ * Callbacks of a command queued by Ril::sendAsync
+ */
+struct AsyncSlot {
+    LineCallback    OnLine;
+    DoneCallback    OnDone;
+    bool            Used = false;
+};
+
+} // namespace detail
+
+/**
+ * Static interface over the RIL engine, there is one engine per firmware
+ */
+class Ril {
+public:
+    static Result init(UART_HandleTypeDef* uart) {
+        return RIL_initialize(uart);
+    }
+
+    static void process() {
+        RIL_process();
+    }
+
+    static bool idle() {
+        return RIL_isIdle();
+    }
+
+    /**
+     * Sends a command and waits for its final result code
+     */
+    static Result send(std::string_view cmd, uint32_t timeOut = 0) {
+        return RIL_SendATCmd(cmd.data(), static_cast<uint32_t>(cmd.size()), nullptr, nullptr, timeOut);
+    }
+
+    /**
+     * Sends a command and waits, onLine is called in place for every intermediate
+     * line: the callable is never copied, so it may capture anything.
+     */
+    template <typename F, typename = std::enable_if_t<std::is_invocable_v<F&, std::string_view>>>
+    static Result send(std::string_view cmd, F&& onLine, uint32_t timeOut = 0) {
+        using Fn = std::remove_reference_t<F>;
+        static_assert(detail::IsLineResult<std::invoke_result_t<F&, std::string_view>>,
+                      "onLine must return RIL_ATRspError, RIL_AT_RSP_FAILED fails the command");
+        return RIL_SendATCmd(cmd.data(), static_cast<uint32_t>(cmd.size()), &lineTrampoline<Fn>,
+                             const_cast<void*>(static_cast<const void*>(&onLine)), timeOut);
+    }
+
+    /**
+     * Queues a command, the callbacks run from process().
+     * @return RIL_AT_BUSY when all RIL_CMD_POOL_SIZE slots are in use
+     */
+    static Result sendAsync(std::string_view cmd, LineCallback&& onLine, DoneCallback&& onDone, uint32_t timeOut = 0) {
+        return queue(cmd, nullptr, std::move(onLine), std::move(onDone), timeOut);
+    }
+
+#if RIL_FEATURE_PAYLOAD
+    /**
+     * Queues a command with raw data, written once the modem sent prompt,
+     * 0 to write it right after the command. data must stay valid until onDone ran.
+     */
+    static Result sendPayload(std::string_view cmd, ByteSpan data, char prompt, LineCallback&& onLine,
+                              DoneCallback&& onDone, uint32_t timeOut = 0) {
+        RIL_Payload payload = {};
+        payload.Data = data.data();
+        payload.Len = static_cast<uint32_t>(data.size());
+        payload.Prompt = prompt;
+        return queue(cmd, &payload, std::move(onLine), std::move(onDone), timeOut);
+    }
+
+    /**
+     * Called from a line callback: the len bytes after the current line are raw
+     * data and go to onData instead of the line parser, see RIL_readPayload
+     */
+    static void readPayload(uint32_t len, DataCallback&& onData) {
+        payloadSink_ = std::move(onData);
+        RIL_readPayload(len, payloadSink_ ? &payloadTrampoline : nullptr, &payloadSink_);
+    }
+#endif
+
+    /**
+     * Registers a URC handler.
+     * @return handle for removeUrcHandler, or -1 when all RIL_URC_HANDLERS slots are taken
+     */
+    static int addUrcHandler(UrcCallback&& onUrc) {
+        for (std::size_t i = 0; i < RIL_URC_HANDLERS; i++) {
+            if (!urcSlots_[i]) {
+                urcSlots_[i] = std::move(onUrc);
+                if (RIL_addURCHandler(&urcTrampoline, &urcSlots_[i]) != RIL_AT_SUCCESS) {
+                    urcSlots_[i].reset();
+                    return -1;
+                }
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    static void removeUrcHandler(int handle) {
+        if (handle >= 0 && static_cast<std::size_t>(handle) < RIL_URC_HANDLERS) {
+            RIL_removeURCHandler(&urcTrampoline, &urcSlots_[handle]);
+            urcSlots_[handle].reset();
+        }
+    }
+
+    static RIL_Error lastError() {
+        return Ql_RIL_AT_GetErrCode();
+    }
+
+private:
+    using AsyncSlot = detail::AsyncSlot;
+
+    static Result queue(std::string_view cmd, const void* payload, LineCallback&& onLine, DoneCallback&& onDone,
+                        uint32_t timeOut) {
+        for (AsyncSlot& slot : asyncSlots_) {
+            if (!slot.Used) {
+                Callback_ATResponse lineFn = onLine ? &asyncLineTrampoline : nullptr;
+                Result result;
+            #if RIL_FEATURE_PAYLOAD
+                if (payload != nullptr) {
+                    result = RIL_SendATCmdPayload(cmd.data(), static_cast<uint32_t>(cmd.size()),
+                                                  static_cast<const RIL_Payload*>(payload), lineFn,
+                                                  &asyncDoneTrampoline, &slot, timeOut);
+                }
+                else
+            #endif
+                {
+                    (void) payload;
+                    result = RIL_SendATCmdAsync(cmd.data(), static_cast<uint32_t>(cmd.size()), lineFn,
+                                                &asyncDoneTrampoline, &slot, timeOut);
+                }
+                if (result == RIL_AT_SUCCESS) {
+                    slot.Used = true;
+                    slot.OnLine = std::move(onLine);
+                    slot.OnDone = std::move(onDone);
+                }
+                return result;
+            }
+        }
+        return RIL_AT_BUSY;
+    }
+
+    template <typename Fn>
+    static uint32_t lineTrampoline(char* line, uint32_t len, void* userData) {
+        return static_cast<uint32_t>((*static_cast<Fn*>(userData))(std::string_view(line, len)));
+    }
+
+    static uint32_t asyncLineTrampoline(char* line, uint32_t len, void* userData) {
+        return static_cast<uint32_t>(static_cast<AsyncSlot*>(userData)->OnLine(std::string_view(line, len)));
+    }
+
+    static void asyncDoneTrampoline(RIL_ATSndError result, void* userData) {
+        AsyncSlot* slot = static_cast<AsyncSlot*>(userData);
+        // Release the slot first, the callback may queue the next command
+        DoneCallback onDone = std::move(slot->OnDone);
+        slot->OnLine.reset();
+        slot->Used = false;
+        if (onDone) {
+            onDone(result);
+        }
+    }
+
+    static void urcTrampoline(const char* line, uint32_t len, RIL_PrefixId id, void* userData) {
+        (*static_cast<UrcCallback*>(userData))(std::string_view(line, len), id);
+    }
+
+#if RIL_FEATURE_PAYLOAD
+    static void payloadTrampoline(const uint8_t* data, uint32_t len, void* userData) {
+        (*static_cast<DataCallback*>(userData))(ByteSpan(reinterpret_cast<const std::byte*>(data), len));
+    }
+
+    /* The engine reads one payload at a time */
+    inline static DataCallback payloadSink_;
+#endif
+
+    inline static AsyncSlot asyncSlots_[RIL_CMD_POOL_SIZE];
+    inline static UrcCallback urcSlots_[RIL_URC_HANDLERS];
+};
+
+} // namespace ril
+
+#endif //_RIL_HPP_
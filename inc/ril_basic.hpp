@@ -0,0 +1,245 @@
+/**
+ * @file ril_basic.hpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Statically polymorphic C++17 RIL engine
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * BasicRil<Transport, Clock, Config> is the engine of ril.c as a class
+ * template: the transport and clock are template parameters, the sizes and
+ * features come from Config, so the byte path has no function pointers and
+ * feature branches are resolved at compile time. Each object is a separate
+ * engine, instances on different transports live side by side:
+ *
+ *     ril::BasicRil<ril::StreamTransport, ril::HalClock> modem(usart1);
+ *     ril::BasicRil<ril::PosixTransport<>, ril::SteadyClock, HostConfig> sim(pty);
+ *
+ * Transport needs:
+ *     uint32_t readable();                        contiguous received bytes, never blocks
+ *     const uint8_t* readPtr();                   first of them
+ *     void consume(uint32_t len);                 drops len bytes
+ *     bool write(const uint8_t* data, uint32_t len);
+ * Clock needs:
+ *     static uint32_t now();                      milliseconds
+ *
+ * Commands are blocking, URCs go to the handler set by setUrcHandler, from
+ * inside send() or poll(). See ril_transport.hpp for ready made transports.
+ */
+
+#ifndef _RIL_BASIC_HPP_
+#define _RIL_BASIC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "ril.hpp"
+
+extern "C" {
+#include "ril_scan.h"
+#include "ril_line.h"
+}
+
+namespace ril {
+
+/**
+ * Config of BasicRil, derive from it and override what differs
+ */
+struct BasicConfig {
+    /** Longest response line kept, including the null terminator */
+    static constexpr std::size_t    LineLen = RIL_LINE_LEN;
+    /** Longest AT command is CmdLen - 3 */
+    static constexpr std::size_t    CmdLen = RIL_CMD_LEN;
+    static constexpr uint32_t       DefaultTimeOut = 180000;
+    static constexpr uint16_t       InitRetry = RIL_INIT_RETRY;
+    /** ATV0 single digit result codes, requires RIL_FEATURE_NUMERIC_RESULT */
+    static constexpr bool           NumericResult = false;
+    /** Echo matching, without it init sends ATE0 */
+    static constexpr bool           Echo = RIL_FEATURE_ECHO;
+};
+
+template <typename Transport, typename Clock, typename Config = BasicConfig>
+class BasicRil {
+public:
+    static_assert(Config::LineLen >= 16, "LineLen too small for result codes");
+    static_assert(Config::CmdLen >= 8, "CmdLen too small for the init sequence");
+    static_assert(!Config::NumericResult || RIL_FEATURE_NUMERIC_RESULT, "NumericResult needs RIL_FEATURE_NUMERIC_RESULT");
+
+    explicit BasicRil(Transport& transport) noexcept : transport_(transport) {}
+
+    BasicRil(const BasicRil&) = delete;
+    BasicRil& operator=(const BasicRil&) = delete;
+
+    /**
+     * Syncs with "AT", then sets the result format, echo and AT+CMEE=1
+     */
+    Result init() {
+        Result result = RIL_AT_FAILED;
+        for (uint16_t retry = Config::InitRetry; retry > 0; retry--) {
+            result = send("AT", 500);
+            if (result == RIL_AT_SUCCESS) {
+                send(Config::NumericResult ? "ATV0" : "ATV1", 500);
+                if constexpr (!Config::Echo) {
+                    send("ATE0", 500);
+                }
+                return send("AT+CMEE=1", 500);
+            }
+        }
+        return result;
+    }
+
+    Result send(std::string_view cmd, uint32_t timeOut = 0) {
+        return send(cmd, [](std::string_view) { return RIL_AT_RSP_CONTINUE; }, timeOut);
+    }
+
+    /**
+     * Sends a command and waits for its final result, onLine is called in place
+     * for every intermediate line and may return RIL_AT_RSP_FAILED to fail it.
+     */
+    template <typename F, typename = std::enable_if_t<std::is_invocable_v<F&, std::string_view>>>
+    Result send(std::string_view cmd, F&& onLine, uint32_t timeOut = 0) {
+        if (cmd.size() + 3 > Config::CmdLen) {
+            return RIL_AT_INVALID_PARAM;
+        }
+        // A URC handler can not wait for its own engine
+        if (busy_) {
+            return RIL_AT_BUSY;
+        }
+
+        std::memcpy(cmd_, cmd.data(), cmd.size());
+        cmd_[cmd.size()] = '\r';
+        cmd_[cmd.size() + 1] = '\n';
+        cmdLen_ = static_cast<uint32_t>(cmd.size());
+        if (!transport_.write(reinterpret_cast<const uint8_t*>(cmd_), cmdLen_ + 2)) {
+            setError(RIL_ERROR_AT, static_cast<uint32_t>(RIL_AT_FAILED));
+            return RIL_AT_FAILED;
+        }
+
+        busy_ = true;
+        echoPending_ = Config::Echo;
+        Result result = RIL_AT_SUCCESS;
+        const uint32_t deadline = Clock::now() + (timeOut != 0 ? timeOut : Config::DefaultTimeOut);
+        for (;;) {
+            int32_t len = readLine();
+            if (len < 0) {
+                if (static_cast<int32_t>(Clock::now() - deadline) >= 0) {
+                    result = RIL_AT_TIMEOUT;
+                    break;
+                }
+                continue;
+            }
+
+            const RIL_Prefix* prefix = classify(len);
+            RIL_LineKind kind = prefix != nullptr ? static_cast<RIL_LineKind>(prefix->Kind) : RIL_LINE_INFO;
+            if constexpr (Config::Echo) {
+                if (echoPending_ && kind != RIL_LINE_URC) {
+                    echoPending_ = false;
+                    if (RIL_lineIsEcho(line_, len, static_cast<uint32_t>(Config::LineLen), cmd_, cmdLen_)) {
+                        continue;
+                    }
+                }
+            }
+            if (kind == RIL_LINE_URC && RIL_lineIsResponseOf(prefix, cmd_, cmdLen_)) {
+                kind = RIL_LINE_INFO;
+            }
+
+            if (kind == RIL_LINE_FINAL_OK) {
+                break;
+            }
+            if (kind == RIL_LINE_FINAL_ERROR) {
+                setError(RIL_ERROR_AT, RIL_lineErrCode(prefix, line_));
+                result = RIL_AT_FAILED;
+                break;
+            }
+            if (kind == RIL_LINE_URC) {
+                deliverUrc(prefix, len);
+            }
+            else if (onLine(std::string_view(line_, static_cast<std::size_t>(len))) == RIL_AT_RSP_FAILED) {
+                result = RIL_AT_FAILED;
+            }
+        }
+        busy_ = false;
+        return result;
+    }
+
+    /**
+     * Hands the URCs received while no command runs to the handler
+     */
+    void poll() {
+        if (busy_) {
+            return;
+        }
+        int32_t len;
+        while ((len = readLine()) > 0) {
+            const RIL_Prefix* prefix = classify(len);
+            // A late final result of a timed out command has no owner anymore
+            if (prefix == nullptr || prefix->Kind == RIL_LINE_INFO || prefix->Kind == RIL_LINE_URC) {
+                deliverUrc(prefix, len);
+            }
+        }
+    }
+
+    void setUrcHandler(UrcCallback&& onUrc) {
+        onUrc_ = std::move(onUrc);
+    }
+
+    RIL_Error lastError() const {
+        return error_;
+    }
+
+    Transport& transport() {
+        return transport_;
+    }
+
+private:
+    /**
+     * Moves bytes into line_ until a terminator, with the line rules of ril.c
+     */
+    int32_t readLine() {
+        uint32_t avail;
+        while ((avail = transport_.readable()) > 0) {
+            const uint8_t* data = transport_.readPtr();
+            int32_t eol = RIL_scanEOL(data, avail);
+            transport_.consume(RIL_lineAppend(line_, &lineLen_, static_cast<uint32_t>(Config::LineLen), data, avail, eol, nullptr));
+            int32_t len = RIL_lineEnd(line_, &lineLen_, eol);
+            if (len >= 0) {
+                return len;
+            }
+        }
+        return -1;
+    }
+
+    const RIL_Prefix* classify(int32_t len) const {
+        return RIL_lineClassify(line_, len, Config::NumericResult);
+    }
+
+    void deliverUrc(const RIL_Prefix* prefix, int32_t len) {
+        if (onUrc_) {
+            onUrc_(std::string_view(line_, static_cast<std::size_t>(len)),
+                   prefix != nullptr ? static_cast<RIL_PrefixId>(prefix->Id) : RIL_PREFIX_NONE);
+        }
+    }
+
+    void setError(RIL_ErrorType type, uint32_t code) {
+        error_.type = type;
+        error_.atError = code;
+    }
+
+    Transport&      transport_;
+    UrcCallback     onUrc_;
+    RIL_Error       error_ = {};
+    uint32_t        lineLen_ = 0;
+    uint32_t        cmdLen_ = 0;    /**< Without the CRLF */
+    bool            busy_ = false;
+    bool            echoPending_ = false;
+    char            line_[Config::LineLen];
+    char            cmd_[Config::CmdLen];
+};
+
+} // namespace ril
+
+#endif //_RIL_BASIC_HPP_
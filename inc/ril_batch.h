@@ -0,0 +1,74 @@
+/**
+ * @file ril_batch.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Deferred commands sent together while the modem is awake
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * A deferred command waits until the modem is awake for another reason (a
+ * command is running, a URC arrived, or either happened within the last
+ * RIL_BATCH_AWAKE_MS) or until its latency bound expires. Either way every
+ * waiting command goes out in the same wake, so N deferred queries cost one
+ * wake instead of N. RIL_process drives the scheduler.
+ */
+
+#ifndef _RIL_BATCH_H_
+#define _RIL_BATCH_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_BATCH
+
+typedef struct {
+    uint32_t            Deferred;       /**< Commands accepted by RIL_batch_defer */
+    uint32_t            Sent;           /**< Commands handed to the engine */
+    uint32_t            Wakes;          /**< Flushes that had to wake the modem: latency bound or RIL_batch_flush */
+    uint32_t            Piggybacked;    /**< Flushes that rode on a wake for another reason */
+    uint32_t            WakesSaved;     /**< Sent - Wakes, wakes the commands would have cost one by one */
+} RIL_BatchStats;
+
+/*******************************************************************************
+* @brief Holds a command until the modem is awake anyway, at most maxDelay ms.
+*   The command is copied, callbacks are the same as RIL_SendATCmdAsync.
+* @return RIL_AT_BUSY when all RIL_BATCH_SLOTS are taken, RIL_AT_INVALID_PARAM
+*   when the command exceeds RIL_CMD_LEN
+******************************************************************************/
+RIL_ATSndError RIL_batch_defer(const char* atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack,
+                               Callback_ATDone done, void* userData, uint32_t timeOut, uint32_t maxDelay);
+
+#if RIL_FEATURE_PAYLOAD
+/*******************************************************************************
+* @brief RIL_batch_defer for a command with raw data, e.g. AT+QISEND of a
+*   report that may wait for the next wake. The command and the payload
+*   descriptor are copied, payload->Data is not: it must stay valid until
+*   done runs, as with RIL_SendATCmdPayload.
+* @return same as RIL_batch_defer
+******************************************************************************/
+RIL_ATSndError RIL_batch_deferPayload(const char* atCmd, uint32_t atCmdLen, const RIL_Payload* payload,
+                                      Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData,
+                                      uint32_t timeOut, uint32_t maxDelay);
+#endif
+
+/*******************************************************************************
+* @brief Sends every waiting command now, e.g. right before the MCU sleeps
+******************************************************************************/
+void RIL_batch_flush(void);
+
+/*******************************************************************************
+* @brief Scheduler step, called from RIL_process
+******************************************************************************/
+void RIL_batch_process(void);
+
+/*******************************************************************************
+* @brief Number of commands waiting or on their way
+******************************************************************************/
+uint8_t RIL_batch_pending(void);
+
+const RIL_BatchStats* RIL_batch_stats(void);
+void RIL_batch_resetStats(void);
+
+#endif
+
+#endif //_RIL_BATCH_H_
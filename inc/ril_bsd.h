@@ -0,0 +1,220 @@
+/**
+ * @file ril_bsd.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief BSD socket calls over the modem sockets of ril_socket.h
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * socket, connect, send, recv, close, setsockopt, getsockopt, fcntl and poll
+ * with POSIX semantics, so clients written against BSD sockets (MQTT, HTTP
+ * over a TLS library) port without changes. Descriptors block by default
+ * and run RIL_process while they wait, up to SO_RCVTIMEO and SO_SNDTIMEO.
+ * With O_NONBLOCK or MSG_DONTWAIT they return RIL_EAGAIN instead, and one
+ * loop can serve every descriptor through poll. Readiness comes from the
+ * receive and close URCs of the modem.
+ *
+ * connect takes a numeric sockaddr_in or, through RIL_bsd_connectHost, a
+ * host name the modem resolves itself. UDP descriptors have to be connected,
+ * sendto and recvfrom are not supported.
+ *
+ * Define RIL_BSD_NAMES on targets without a socket library of their own to
+ * get the plain names (socket, connect, struct sockaddr_in, POLLIN, errno...).
+ * Blocking calls must not be made from RIL callbacks.
+ */
+
+#ifndef _RIL_BSD_H_
+#define _RIL_BSD_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_BSD
+
+#if !RIL_FEATURE_SOCKET
+    #error "RIL_FEATURE_BSD needs RIL_FEATURE_SOCKET"
+#endif
+
+#include <stdint.h>
+
+/* Values are the Linux ones */
+#define RIL_AF_INET                 2
+#define RIL_SOCK_STREAM             1
+#define RIL_SOCK_DGRAM              2
+#define RIL_IPPROTO_TCP             6
+#define RIL_IPPROTO_UDP             17
+
+#define RIL_SOL_SOCKET              1
+#define RIL_SO_ERROR                4
+#define RIL_SO_RCVTIMEO             20
+#define RIL_SO_SNDTIMEO             21
+
+#define RIL_F_GETFL                 3
+#define RIL_F_SETFL                 4
+#define RIL_O_NONBLOCK              04000
+
+#define RIL_MSG_DONTWAIT            0x40
+
+#define RIL_POLLIN                  0x001
+#define RIL_POLLOUT                 0x004
+#define RIL_POLLERR                 0x008
+#define RIL_POLLHUP                 0x010
+#define RIL_POLLNVAL                0x020
+
+/* RIL_bsd_errno */
+#define RIL_EPIPE                   32
+#define RIL_EBADF                   9
+#define RIL_EAGAIN                  11
+#define RIL_EWOULDBLOCK             RIL_EAGAIN
+#define RIL_EINVAL                  22
+#define RIL_EMFILE                  24
+#define RIL_ENOPROTOOPT             92
+#define RIL_EAFNOSUPPORT            97
+#define RIL_ENETDOWN                100
+#define RIL_ECONNRESET              104
+#define RIL_EISCONN                 106
+#define RIL_ENOTCONN                107
+#define RIL_ETIMEDOUT               110
+#define RIL_ECONNREFUSED            111
+#define RIL_EALREADY                114
+#define RIL_EINPROGRESS             115
+
+struct RIL_in_addr {
+    uint32_t            s_addr;         /**< Network byte order */
+};
+
+struct RIL_sockaddr {
+    uint16_t            sa_family;
+    char                sa_data[14];
+};
+
+struct RIL_sockaddr_in {
+    uint16_t            sin_family;
+    uint16_t            sin_port;       /**< Network byte order */
+    struct RIL_in_addr  sin_addr;
+    uint8_t             sin_zero[8];
+};
+
+struct RIL_timeval {
+    long                tv_sec;
+    long                tv_usec;
+};
+
+struct RIL_pollfd {
+    int                 fd;
+    short               events;
+    short               revents;
+};
+
+/* Error of the last call that failed */
+extern int RIL_bsd_errno;
+
+/*******************************************************************************
+* @brief New descriptor, the modem socket is opened by connect
+* @param domain RIL_AF_INET
+* @param type RIL_SOCK_STREAM, RIL_SOCK_DGRAM
+* @return descriptor, -1 with RIL_EMFILE when RIL_SOCKET_COUNT are in use
+******************************************************************************/
+int RIL_bsd_socket(int domain, int type, int protocol);
+
+/*******************************************************************************
+* @brief Opens the modem socket to a numeric address. Non-blocking it fails
+*   with RIL_EINPROGRESS, poll reports RIL_POLLOUT once it is connected and
+*   SO_ERROR tells the result.
+******************************************************************************/
+int RIL_bsd_connect(int fd, const struct RIL_sockaddr* addr, uint32_t addrLen);
+
+/*******************************************************************************
+* @brief connect to a host name, resolved by the modem
+******************************************************************************/
+int RIL_bsd_connectHost(int fd, const char* host, uint16_t port);
+
+/*******************************************************************************
+* @brief Queues data in the TX ring of the socket, blocking it waits until
+*   all of it is queued
+* @return bytes queued, -1 with RIL_EAGAIN when the ring is full and the call
+*   may not wait, RIL_EPIPE when the peer closed
+******************************************************************************/
+int32_t RIL_bsd_send(int fd, const void* buff, uint32_t len, int flags);
+
+/*******************************************************************************
+* @return bytes read, 0 at the end of the stream, -1 with RIL_EAGAIN when
+*   nothing arrived and the call may not wait
+******************************************************************************/
+int32_t RIL_bsd_recv(int fd, void* buff, uint32_t len, int flags);
+
+/*******************************************************************************
+* @brief Frees the descriptor, queued data still goes out before the modem
+*   socket closes
+******************************************************************************/
+int RIL_bsd_close(int fd);
+
+/*******************************************************************************
+* @brief RIL_SOL_SOCKET RIL_SO_RCVTIMEO and RIL_SO_SNDTIMEO with a
+*   struct RIL_timeval, zero waits forever
+******************************************************************************/
+int RIL_bsd_setsockopt(int fd, int level, int name, const void* value, uint32_t len);
+
+/*******************************************************************************
+* @brief RIL_SOL_SOCKET RIL_SO_ERROR, the result of a non-blocking connect
+******************************************************************************/
+int RIL_bsd_getsockopt(int fd, int level, int name, void* value, uint32_t* len);
+
+/*******************************************************************************
+* @brief RIL_F_GETFL and RIL_F_SETFL with RIL_O_NONBLOCK
+******************************************************************************/
+int RIL_bsd_fcntl(int fd, int cmd, int arg);
+
+/*******************************************************************************
+* @brief Waits until one of the descriptors is ready, running RIL_process
+* @param timeout ms, -1 waits forever, 0 only checks
+* @return descriptors with revents set, 0 on timeout
+******************************************************************************/
+int RIL_bsd_poll(struct RIL_pollfd* fds, uint32_t nfds, int timeout);
+
+#if RIL_BSD_NAMES
+    #define AF_INET                 RIL_AF_INET
+    #define SOCK_STREAM             RIL_SOCK_STREAM
+    #define SOCK_DGRAM              RIL_SOCK_DGRAM
+    #define IPPROTO_TCP             RIL_IPPROTO_TCP
+    #define IPPROTO_UDP             RIL_IPPROTO_UDP
+    #define SOL_SOCKET              RIL_SOL_SOCKET
+    #define SO_ERROR                RIL_SO_ERROR
+    #define SO_RCVTIMEO             RIL_SO_RCVTIMEO
+    #define SO_SNDTIMEO             RIL_SO_SNDTIMEO
+    #define F_GETFL                 RIL_F_GETFL
+    #define F_SETFL                 RIL_F_SETFL
+    #define O_NONBLOCK              RIL_O_NONBLOCK
+    #define MSG_DONTWAIT            RIL_MSG_DONTWAIT
+    #define POLLIN                  RIL_POLLIN
+    #define POLLOUT                 RIL_POLLOUT
+    #define POLLERR                 RIL_POLLERR
+    #define POLLHUP                 RIL_POLLHUP
+    #define POLLNVAL                RIL_POLLNVAL
+    #define EAGAIN                  RIL_EAGAIN
+    #define EWOULDBLOCK             RIL_EWOULDBLOCK
+    #define EINPROGRESS             RIL_EINPROGRESS
+    #define ETIMEDOUT               RIL_ETIMEDOUT
+    #define ECONNREFUSED            RIL_ECONNREFUSED
+    #define ECONNRESET              RIL_ECONNRESET
+    #define ENOTCONN                RIL_ENOTCONN
+    #define errno                   RIL_bsd_errno
+    #define in_addr                 RIL_in_addr
+    #define sockaddr                RIL_sockaddr
+    #define sockaddr_in             RIL_sockaddr_in
+    #define timeval                 RIL_timeval
+    #define pollfd                  RIL_pollfd
+    #define socket                  RIL_bsd_socket
+    #define connect                 RIL_bsd_connect
+    #define send                    RIL_bsd_send
+    #define recv                    RIL_bsd_recv
+    #define closesocket             RIL_bsd_close
+    #define setsockopt              RIL_bsd_setsockopt
+    #define getsockopt              RIL_bsd_getsockopt
+    #define fcntl                   RIL_bsd_fcntl
+    #define poll                    RIL_bsd_poll
+#endif
+
+#endif
+
+#endif //_RIL_BSD_H_
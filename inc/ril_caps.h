@@ -0,0 +1,80 @@
+/**
+ * @file ril_caps.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Modem capability discovery, cached per firmware revision
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * RIL_caps_discover reads AT+CGMR and, when the stored record belongs to
+ * another firmware (or there is none), rebuilds the flags from AT+CLAC, ATI,
+ * AT+IPR=? and a compound command, then stores them through ril_store.h.
+ * An unchanged firmware costs one command per boot.
+ */
+
+#ifndef _RIL_CAPS_H_
+#define _RIL_CAPS_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_CAPS
+
+#include <stdbool.h>
+
+/* RIL_Caps.Flags */
+#define RIL_CAP_CMUX                0x0001  /**< 27.010 multiplexer, AT+CMUX */
+#define RIL_CAP_BINARY_SEND         0x0002  /**< Raw socket data after a prompt: QISEND, CIPSEND, USOWR */
+#define RIL_CAP_BUFFERED_RECV       0x0004  /**< Socket data waits in the modem: QIRD, CIPRXGET, USORD */
+#define RIL_CAP_PUSH_RECV           0x0008  /**< Socket data follows its URC, Quectel direct push */
+#define RIL_CAP_FILE_UPLOAD         0x0010  /**< QFUPL, CFTRANRX, UDWNFILE */
+#define RIL_CAP_COMPOUND            0x0020  /**< Several commands on one line, AT+A;+B */
+#define RIL_CAP_BAUD                0x0040  /**< AT+IPR, MaxBaud is valid */
+#define RIL_CAP_PSM                 0x0080  /**< AT+CPSMS */
+#define RIL_CAP_CLAC                0x8000  /**< Command flags come from AT+CLAC, not from vendor defaults */
+
+typedef struct {
+    uint32_t            Check;          /**< RIL_hash over the fields below, tells a valid record */
+    uint32_t            Flags;
+    uint32_t            MaxBaud;        /**< Highest rate AT+IPR=? lists within RIL_LINE_LEN, 0 when unknown */
+    uint8_t             Vendor;         /**< RIL_VENDOR_*, RIL_VENDOR_AUTO when unknown */
+    char                Firmware[RIL_CAPS_FIRMWARE_LEN];
+} RIL_Caps;
+
+/*******************************************************************************
+* @brief Reads the firmware revision and loads its stored flags, or discovers
+*   and stores them. With RIL_VENDOR_AUTO it also selects the vendor profile.
+* @param force discover even when the stored record matches the firmware
+* @return the result of AT+CGMR, discovery itself does not fail
+******************************************************************************/
+RIL_ATSndError RIL_caps_discover(bool force);
+
+/*******************************************************************************
+* @brief Flags of the last RIL_caps_discover, all zero before it
+******************************************************************************/
+const RIL_Caps* RIL_caps(void);
+
+/*******************************************************************************
+* @brief true once RIL_caps_discover or RIL_caps_restore filled the flags
+******************************************************************************/
+bool RIL_caps_valid(void);
+
+/*******************************************************************************
+* @brief true when every flag in flags is set
+******************************************************************************/
+bool RIL_caps_has(uint32_t flags);
+
+/*******************************************************************************
+* @brief true when the last RIL_caps_discover took the flags from the store
+******************************************************************************/
+bool RIL_caps_fromStore(void);
+
+/*******************************************************************************
+* @brief Takes over a record saved before sleep, see RIL_resume
+* @return false when the record is damaged
+******************************************************************************/
+bool RIL_caps_restore(const RIL_Caps* record);
+
+#endif
+
+#endif //_RIL_CAPS_H_
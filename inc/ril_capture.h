@@ -0,0 +1,69 @@
+/**
+ * @file ril_capture.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Whole-response capture into a caller provided arena
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#ifndef _RIL_CAPTURE_H_
+#define _RIL_CAPTURE_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_CAPTURE
+
+/**
+ * Position of one captured line inside the arena
+ */
+typedef struct {
+    uint16_t            Offset;
+    uint16_t            Len;
+} RIL_LineSpan;
+
+/**
+ * Lines of one response, stored back to back (each null terminated) in Arena,
+ * with one span per line in Lines
+ */
+typedef struct {
+    char*               Arena;
+    RIL_LineSpan*       Lines;
+    uint16_t            ArenaSize;
+    uint16_t            ArenaUsed;
+    uint16_t            MaxLines;
+    uint16_t            LineCount;
+    uint8_t             Truncated;      /**< Lines were dropped, the arena or the index was full */
+    RIL_ATSndError      Result;         /**< Result of the command */
+    uint32_t            ErrCode;        /**< +CME/+CMS ERROR code when Result is RIL_AT_FAILED */
+} RIL_Capture;
+
+/*******************************************************************************
+* @brief Binds a capture to its storage, nothing is allocated.
+******************************************************************************/
+void RIL_capture_init(RIL_Capture* capture, char* arena, uint16_t arenaSize, RIL_LineSpan* lines, uint16_t maxLines);
+
+/*******************************************************************************
+* @brief Callback_ATResponse that appends each line to the capture in userData.
+*   Use it directly with RIL_SendATCmd to capture and still set a custom timeout.
+******************************************************************************/
+uint32_t RIL_capture_callback(char* line, uint32_t len, void* userData);
+
+/*******************************************************************************
+* @brief Sends an AT command and stores all intermediate lines of the response
+*   in the capture, which is reset first.
+* @return the same as RIL_SendATCmd, also stored in capture->Result
+******************************************************************************/
+RIL_ATSndError RIL_SendATCmdCapture(const char* atCmd, uint32_t atCmdLen, RIL_Capture* capture, uint32_t timeOut);
+
+/*******************************************************************************
+* @brief Returns captured line index, null terminated, and its length in len.
+* @return the line, or NULL if index is out of range
+******************************************************************************/
+const char* RIL_capture_line(const RIL_Capture* capture, uint16_t index, uint32_t* len);
+
+#endif
+
+#endif //_RIL_CAPTURE_H_
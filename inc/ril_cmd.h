@@ -0,0 +1,109 @@
+/**
+ * @file ril_cmd.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Generated AT command bindings: timeouts, retries, response cache
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Commands are described in tools/ril_commands.json. tools/ril_cmdgen.py
+ * turns every entry into a builder, a typed parser, a RIL_<NAME>_send binding
+ * and a row of RIL_CMD_TABLE, see inc/ril_cmd_gen.h.
+ */
+
+#ifndef _RIL_CMD_H_
+#define _RIL_CMD_H_
+
+#include "ril.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if RIL_FEATURE_COMMANDS
+
+#include "ril_cmd_gen.h"
+
+/* RIL_CmdInfo.Flags */
+#define RIL_CMD_RETRY_ON_ERROR      0x01
+
+/* Parser results, other values are the index of the first field that did not decode */
+#define RIL_CMD_PARSE_OK            -1
+#define RIL_CMD_PARSE_NO_LINE       -2
+
+/**
+ * Decodes the fields of a response line after its prefix into rsp
+ * @return RIL_CMD_PARSE_OK, or the index of the first bad field
+ */
+typedef int32_t (*RIL_CmdParser)(const char* pos, const char* end, void* rsp);
+
+typedef struct {
+    const char*         Prefix;     /**< Response prefix, "" for the first intermediate line, NULL for none */
+    RIL_CmdParser       Parse;
+    void*               Cache;      /**< Last decoded response, NULL when not cacheable */
+    uint32_t            TimeOut;    /**< ms */
+    uint32_t            CacheAge;   /**< ms the cached response is reused, 0 when not cacheable */
+    uint16_t            RspSize;
+    uint8_t             PrefixLen;
+    uint8_t             Retry;      /**< Extra attempts after a timeout */
+    uint8_t             Flags;
+} RIL_CmdInfo;
+
+/* Generated table, see tools/ril_cmdgen.py */
+extern const RIL_CmdInfo RIL_CMD_TABLE[RIL_CMD_COUNT];
+
+/*******************************************************************************
+* @brief Sends a command with the timeout and retry policy of its table entry
+*   and decodes its response line into rsp. A cacheable command answers from
+*   the cache while it is younger than its CacheAge.
+* @param rsp response struct of the command, may be NULL
+* @return RIL_AT_FAILED also when the response line is missing or does not
+*   decode, see RIL_cmd_parseStatus
+******************************************************************************/
+RIL_ATSndError RIL_cmd_exec(RIL_CmdId id, const char* cmd, uint32_t cmdLen, void* rsp);
+
+/*******************************************************************************
+* @brief Drops the cached response of id, RIL_CMD_COUNT drops all of them
+******************************************************************************/
+void RIL_cmd_invalidate(RIL_CmdId id);
+
+/*******************************************************************************
+* @brief Parser result of the last RIL_cmd_exec that sent a command
+* @return RIL_CMD_PARSE_OK, RIL_CMD_PARSE_NO_LINE or the index of the bad field
+******************************************************************************/
+int32_t RIL_cmd_parseStatus(void);
+
+#if RIL_FEATURE_SESSION
+/*******************************************************************************
+* @brief Writes the live cached responses for RIL_suspend, as many as fit
+* @return bytes written
+******************************************************************************/
+uint32_t RIL_cmd_suspend(uint8_t* out, uint32_t size);
+
+/*******************************************************************************
+* @brief Restores the cache from RIL_cmd_suspend output, entries that aged
+*   past their CacheAge during sleepMs are dropped
+******************************************************************************/
+void RIL_cmd_resume(const uint8_t* data, uint32_t len, uint32_t sleptMs);
+#endif
+
+#endif
+
+/* Builder and parser primitives, also used by the vendor profiles */
+
+/* put* return the end of what they wrote */
+char* RIL_cmd_putUint(char* pos, uint32_t value);
+char* RIL_cmd_putInt(char* pos, int32_t value);
+/* NULL when str is longer than max */
+char* RIL_cmd_putStr(char* pos, const char* str, uint32_t max);
+/* String literal, its length is known at compile time */
+#define RIL_cmd_putLit(POS, LIT)    ((char*) memcpy((POS), (LIT), sizeof(LIT) - 1) + (sizeof(LIT) - 1))
+
+/* A field ends at ',' or at end */
+bool RIL_cmd_nextField(const char** pos, const char* end);
+bool RIL_cmd_fieldEmpty(const char* pos, const char* end);
+bool RIL_cmd_parseInt(const char** pos, const char* end, int32_t* value);
+bool RIL_cmd_parseUint(const char** pos, const char* end, uint32_t* value);
+/* Quoted or bare, cut at size - 1 chars */
+bool RIL_cmd_parseStr(const char** pos, const char* end, char* out, uint32_t size);
+
+#endif //_RIL_CMD_H_
@@ -0,0 +1,195 @@
+/**
+ * @file ril_cmd_gen.h
+ * @brief Generated by tools/ril_cmdgen.py from tools/ril_commands.json, do not edit.
+ */
+
+#ifndef _RIL_CMD_GEN_H_
+#define _RIL_CMD_GEN_H_
+
+#include "ril.h"
+
+typedef enum {
+    RIL_CMD_AT,
+    RIL_CMD_CSQ,
+    RIL_CMD_CREG,
+    RIL_CMD_CGREG,
+    RIL_CMD_CEREG,
+    RIL_CMD_COPS,
+    RIL_CMD_CPIN,
+    RIL_CMD_CGMI,
+    RIL_CMD_CGMM,
+    RIL_CMD_CGMR,
+    RIL_CMD_CGSN,
+    RIL_CMD_CIMI,
+    RIL_CMD_CFUN_SET,
+    RIL_CMD_CGATT_SET,
+    RIL_CMD_QIACT,
+    RIL_CMD_QIDEACT,
+    RIL_CMD_QIOPEN,
+    RIL_CMD_QICLOSE,
+    RIL_CMD_COUNT,
+} RIL_CmdId;
+
+/* AT */
+#define RIL_AT_MAX_LEN                  2
+uint32_t RIL_AT_build(char* buff, uint32_t size);
+RIL_ATSndError RIL_AT_send(void);
+
+/* AT+CSQ */
+#define RIL_CSQ_MAX_LEN                 6
+typedef struct {
+    int32_t     Rssi;
+    int32_t     Ber;
+} RIL_CSQ_Response;
+uint32_t RIL_CSQ_build(char* buff, uint32_t size);
+int32_t RIL_CSQ_parse(const char* line, uint32_t len, RIL_CSQ_Response* rsp);
+RIL_ATSndError RIL_CSQ_send(RIL_CSQ_Response* rsp);
+
+/* AT+CREG? */
+#define RIL_CREG_MAX_LEN                8
+typedef struct {
+    uint32_t    N;
+    uint32_t    Stat;
+    char        Lac[9];
+    char        Ci[11];
+    uint8_t     Present;    /**< Bit i set when optional field i was there */
+} RIL_CREG_Response;
+uint32_t RIL_CREG_build(char* buff, uint32_t size);
+int32_t RIL_CREG_parse(const char* line, uint32_t len, RIL_CREG_Response* rsp);
+RIL_ATSndError RIL_CREG_send(RIL_CREG_Response* rsp);
+
+/* AT+CGREG? */
+#define RIL_CGREG_MAX_LEN               9
+typedef struct {
+    uint32_t    N;
+    uint32_t    Stat;
+    char        Lac[9];
+    char        Ci[11];
+    uint8_t     Present;    /**< Bit i set when optional field i was there */
+} RIL_CGREG_Response;
+uint32_t RIL_CGREG_build(char* buff, uint32_t size);
+int32_t RIL_CGREG_parse(const char* line, uint32_t len, RIL_CGREG_Response* rsp);
+RIL_ATSndError RIL_CGREG_send(RIL_CGREG_Response* rsp);
+
+/* AT+CEREG? */
+#define RIL_CEREG_MAX_LEN               9
+typedef struct {
+    uint32_t    N;
+    uint32_t    Stat;
+    char        Tac[9];
+    char        Ci[11];
+    uint8_t     Present;    /**< Bit i set when optional field i was there */
+} RIL_CEREG_Response;
+uint32_t RIL_CEREG_build(char* buff, uint32_t size);
+int32_t RIL_CEREG_parse(const char* line, uint32_t len, RIL_CEREG_Response* rsp);
+RIL_ATSndError RIL_CEREG_send(RIL_CEREG_Response* rsp);
+
+/* AT+COPS? */
+#define RIL_COPS_MAX_LEN                8
+typedef struct {
+    uint32_t    Mode;
+    uint32_t    Format;
+    char        Oper[25];
+    uint32_t    Act;
+    uint8_t     Present;    /**< Bit i set when optional field i was there */
+} RIL_COPS_Response;
+uint32_t RIL_COPS_build(char* buff, uint32_t size);
+int32_t RIL_COPS_parse(const char* line, uint32_t len, RIL_COPS_Response* rsp);
+RIL_ATSndError RIL_COPS_send(RIL_COPS_Response* rsp);
+
+/* AT+CPIN? */
+#define RIL_CPIN_MAX_LEN                8
+typedef struct {
+    char        Code[13];
+} RIL_CPIN_Response;
+uint32_t RIL_CPIN_build(char* buff, uint32_t size);
+int32_t RIL_CPIN_parse(const char* line, uint32_t len, RIL_CPIN_Response* rsp);
+RIL_ATSndError RIL_CPIN_send(RIL_CPIN_Response* rsp);
+
+/* AT+CGMI */
+#define RIL_CGMI_MAX_LEN                7
+typedef struct {
+    char        Manufacturer[25];
+} RIL_CGMI_Response;
+uint32_t RIL_CGMI_build(char* buff, uint32_t size);
+int32_t RIL_CGMI_parse(const char* line, uint32_t len, RIL_CGMI_Response* rsp);
+RIL_ATSndError RIL_CGMI_send(RIL_CGMI_Response* rsp);
+
+/* AT+CGMM */
+#define RIL_CGMM_MAX_LEN                7
+typedef struct {
+    char        Model[25];
+} RIL_CGMM_Response;
+uint32_t RIL_CGMM_build(char* buff, uint32_t size);
+int32_t RIL_CGMM_parse(const char* line, uint32_t len, RIL_CGMM_Response* rsp);
+RIL_ATSndError RIL_CGMM_send(RIL_CGMM_Response* rsp);
+
+/* AT+CGMR */
+#define RIL_CGMR_MAX_LEN                7
+typedef struct {
+    char        Revision[41];
+} RIL_CGMR_Response;
+uint32_t RIL_CGMR_build(char* buff, uint32_t size);
+int32_t RIL_CGMR_parse(const char* line, uint32_t len, RIL_CGMR_Response* rsp);
+RIL_ATSndError RIL_CGMR_send(RIL_CGMR_Response* rsp);
+
+/* AT+CGSN */
+#define RIL_CGSN_MAX_LEN                7
+typedef struct {
+    char        Imei[17];
+} RIL_CGSN_Response;
+uint32_t RIL_CGSN_build(char* buff, uint32_t size);
+int32_t RIL_CGSN_parse(const char* line, uint32_t len, RIL_CGSN_Response* rsp);
+RIL_ATSndError RIL_CGSN_send(RIL_CGSN_Response* rsp);
+
+/* AT+CIMI */
+#define RIL_CIMI_MAX_LEN                7
+typedef struct {
+    char        Imsi[17];
+} RIL_CIMI_Response;
+uint32_t RIL_CIMI_build(char* buff, uint32_t size);
+int32_t RIL_CIMI_parse(const char* line, uint32_t len, RIL_CIMI_Response* rsp);
+RIL_ATSndError RIL_CIMI_send(RIL_CIMI_Response* rsp);
+
+/* AT+CFUN=%u */
+#define RIL_CFUN_SET_MAX_LEN            18
+uint32_t RIL_CFUN_SET_build(char* buff, uint32_t size, uint32_t fun);
+RIL_ATSndError RIL_CFUN_SET_send(uint32_t fun);
+
+/* AT+CGATT=%u */
+#define RIL_CGATT_SET_MAX_LEN           19
+uint32_t RIL_CGATT_SET_build(char* buff, uint32_t size, uint32_t state);
+RIL_ATSndError RIL_CGATT_SET_send(uint32_t state);
+
+/* AT+QIACT=%u */
+#define RIL_QIACT_MAX_LEN               19
+uint32_t RIL_QIACT_build(char* buff, uint32_t size, uint32_t contextId);
+RIL_ATSndError RIL_QIACT_send(uint32_t contextId);
+
+/* AT+QIDEACT=%u */
+#define RIL_QIDEACT_MAX_LEN             21
+uint32_t RIL_QIDEACT_build(char* buff, uint32_t size, uint32_t contextId);
+RIL_ATSndError RIL_QIDEACT_send(uint32_t contextId);
+
+/* AT+QIOPEN=%u,%u,"%s","%s",%u,0,1 */
+#define RIL_QIOPEN_MAX_LEN              127
+uint32_t RIL_QIOPEN_build(char* buff, uint32_t size, uint32_t contextId, uint32_t connectId, const char* service, const char* host, uint32_t port);
+RIL_ATSndError RIL_QIOPEN_send(uint32_t contextId, uint32_t connectId, const char* service, const char* host, uint32_t port);
+
+/* AT+QICLOSE=%u */
+#define RIL_QICLOSE_MAX_LEN             21
+uint32_t RIL_QICLOSE_build(char* buff, uint32_t size, uint32_t connectId);
+RIL_ATSndError RIL_QICLOSE_send(uint32_t connectId);
+
+/* Response caches in ril_cmd_gen.c */
+#define RIL_CMD_CACHE_SIZE              (sizeof(RIL_CSQ_Response) + \
+                                         sizeof(RIL_CREG_Response) + \
+                                         sizeof(RIL_CGREG_Response) + \
+                                         sizeof(RIL_CEREG_Response) + \
+                                         sizeof(RIL_COPS_Response) + \
+                                         sizeof(RIL_CGMI_Response) + \
+                                         sizeof(RIL_CGMM_Response) + \
+                                         sizeof(RIL_CGMR_Response) + \
+                                         sizeof(RIL_CGSN_Response))
+
+#endif //_RIL_CMD_GEN_H_
@@ -0,0 +1,315 @@
+/**
+ * @file ril_config.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Feature switches, buffer sizing and RAM budget of RIL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Every value can be overridden from the compiler command line, or from a
+ * project header named by RIL_USER_CONFIG (-DRIL_USER_CONFIG="ril_user.h").
+ * Run tools/ril_footprint.py on the built objects to see what each enabled
+ * feature really costs in flash and RAM.
+ */
+
+#ifndef _RIL_CONFIG_H_
+#define _RIL_CONFIG_H_
+
+#ifdef RIL_USER_CONFIG
+    #include RIL_USER_CONFIG
+#endif
+
+/******************************************************************************/
+/*                              Buffer sizing                                 */
+/******************************************************************************/
+/* Size of RX stream ring buffer in bytes */
+#ifndef RIL_RX_STREAM_SIZE
+    #define RIL_RX_STREAM_SIZE          256
+#endif
+/* Size of TX stream ring buffer in bytes */
+#ifndef RIL_TX_STREAM_SIZE
+    #define RIL_TX_STREAM_SIZE          256
+#endif
+/* Longest response line kept, including the null terminator. Longer lines are cut */
+#ifndef RIL_LINE_LEN
+    #define RIL_LINE_LEN                64
+#endif
+/* Longest AT command RIL_SendATCmdAsync can queue, RIL_SendATCmd sends from the caller's buffer */
+#ifndef RIL_CMD_LEN
+    #define RIL_CMD_LEN                 64
+#endif
+/* Number of "AT" sync attempts in RIL_initialize */
+#ifndef RIL_INIT_RETRY
+    #define RIL_INIT_RETRY              10
+#endif
+
+/******************************************************************************/
+/*                              Object pools                                  */
+/******************************************************************************/
+/* Commands RIL_SendATCmdAsync can hold at once */
+#ifndef RIL_CMD_POOL_SIZE
+    #define RIL_CMD_POOL_SIZE           2
+#endif
+/* URCs waiting for RIL_process to dispatch them, more are dropped */
+#ifndef RIL_URC_POOL_SIZE
+    #define RIL_URC_POOL_SIZE           4
+#endif
+/* Longest URC line kept, including the null terminator */
+#ifndef RIL_URC_LINE_LEN
+    #define RIL_URC_LINE_LEN            RIL_LINE_LEN
+#endif
+/* Handlers RIL_addURCHandler can register */
+#ifndef RIL_URC_HANDLERS
+    #define RIL_URC_HANDLERS            4
+#endif
+
+/* Inline storage of callbacks kept by the C++ interface (ril.hpp), in bytes */
+#ifndef RIL_CPP_CALLBACK_SIZE
+    #define RIL_CPP_CALLBACK_SIZE       (4 * sizeof(void*))
+#endif
+
+/* Coroutine frames of ril_coro.hpp: number of live coroutines and bytes per frame,
+   ril::frameLargest() reports the size the application really needs. GCC keeps
+   the awaiter and the Response of every co_await ril::send in the frame, about
+   340 bytes each on a 64-bit host */
+#ifndef RIL_CORO_FRAMES
+    #define RIL_CORO_FRAMES             2
+#endif
+#ifndef RIL_CORO_FRAME_SIZE
+    #define RIL_CORO_FRAME_SIZE         768
+#endif
+/* Response kept by co_await ril::send, text bytes and number of lines */
+#ifndef RIL_CORO_RESPONSE_LEN
+    #define RIL_CORO_RESPONSE_LEN       96
+#endif
+#ifndef RIL_CORO_RESPONSE_LINES
+    #define RIL_CORO_RESPONSE_LINES     4
+#endif
+
+/* Longest AT+CGMR firmware revision the capability record keys on, including the null terminator */
+#ifndef RIL_CAPS_FIRMWARE_LEN
+    #define RIL_CAPS_FIRMWARE_LEN       40
+#endif
+/* RIL_initialize runs RIL_caps_discover, with a storage hook only AT+CGMR when the firmware did not change */
+#ifndef RIL_CAPS_AT_INIT
+    #define RIL_CAPS_AT_INIT            0
+#endif
+
+/* Suggested size of the RIL_suspend blob, cached responses that do not fit are left out */
+#ifndef RIL_SESSION_SIZE
+    #define RIL_SESSION_SIZE            512
+#endif
+
+/* Longest settings table RIL_settings_apply tracks, at most 32 */
+#ifndef RIL_SETTINGS_MAX
+    #define RIL_SETTINGS_MAX            16
+#endif
+/* Buffer of the compound query that verifies the settings, on the stack */
+#ifndef RIL_SETTINGS_QUERY_LEN
+    #define RIL_SETTINGS_QUERY_LEN      128
+#endif
+/* Sent after settings were applied so the modem keeps them, "" to skip */
+#ifndef RIL_SETTINGS_SAVE_CMD
+    #define RIL_SETTINGS_SAVE_CMD       "AT&W"
+#endif
+
+/* Deferred commands RIL_batch_defer can hold, each keeps a copy of its text */
+#ifndef RIL_BATCH_SLOTS
+    #define RIL_BATCH_SLOTS             4
+#endif
+/* How long the modem stays awake after the last command or URC, in ms. Deferred
+   commands going out within this window ride on the same wake */
+#ifndef RIL_BATCH_AWAKE_MS
+    #define RIL_BATCH_AWAKE_MS          1000
+#endif
+
+/* Time from waking the modem with DTR until it takes commands, in ms */
+#ifndef RIL_POWER_WAKE_MS
+    #define RIL_POWER_WAKE_MS           50
+#endif
+/* Idle time after which DTR lets the modem sleep again, in ms */
+#ifndef RIL_POWER_IDLE_MS
+    #define RIL_POWER_IDLE_MS           2000
+#endif
+
+/* Sockets of ril_socket.h, the RX and TX ring of each one and the longest host name with its null terminator */
+#ifndef RIL_SOCKET_COUNT
+    #define RIL_SOCKET_COUNT            2
+#endif
+#ifndef RIL_SOCKET_RX_SIZE
+    #define RIL_SOCKET_RX_SIZE          1024
+#endif
+#ifndef RIL_SOCKET_TX_SIZE
+    #define RIL_SOCKET_TX_SIZE          512
+#endif
+#ifndef RIL_SOCKET_HOST_LEN
+    #define RIL_SOCKET_HOST_LEN         48
+#endif
+/* Longest wait for the result of an open, in ms, Quectel allows 150s */
+#ifndef RIL_SOCKET_OPEN_TIMEOUT
+    #define RIL_SOCKET_OPEN_TIMEOUT     150000
+#endif
+/* Pause before a send the modem refused is tried again, in ms */
+#ifndef RIL_SOCKET_RETRY_MS
+    #define RIL_SOCKET_RETRY_MS         100
+#endif
+/* Reads queued behind the read in flight while the modem holds data, 0 reads one chunk at a time */
+#ifndef RIL_SOCKET_PREFETCH
+    #define RIL_SOCKET_PREFETCH         1
+#endif
+/* Smallest read while the RX ring still holds data, a nearly full ring waits for the application */
+#ifndef RIL_SOCKET_READ_MIN
+    #define RIL_SOCKET_READ_MIN         256
+#endif
+/* Idle sockets RIL_conn_release keeps open for reuse, 0 closes every released socket */
+#ifndef RIL_CONN_IDLE_MAX
+    #define RIL_CONN_IDLE_MAX           1
+#endif
+/* Idle socket lifetime in ms, keep it below the NAT timeout of the network */
+#ifndef RIL_CONN_IDLE_MS
+    #define RIL_CONN_IDLE_MS            60000
+#endif
+/* Plain BSD names (socket, connect, POLLIN, errno...) for the ril_bsd.h calls,
+   only on targets without a socket library of their own */
+#ifndef RIL_BSD_NAMES
+    #define RIL_BSD_NAMES               0
+#endif
+
+/******************************************************************************/
+/*                             Feature switches                               */
+/******************************************************************************/
+/* ATV0 single digit result codes, see RIL_setResultFormat */
+#ifndef RIL_FEATURE_NUMERIC_RESULT
+    #define RIL_FEATURE_NUMERIC_RESULT  1
+#endif
+/* Echo matching and RIL_setEchoMode, without it the modem must run with ATE0 */
+#ifndef RIL_FEATURE_ECHO
+    #define RIL_FEATURE_ECHO            1
+#endif
+
+/* High-water marks and near-overrun counters of the RX/TX rings and the line buffer */
+#ifndef RIL_FEATURE_BUFFER_STATS
+    #define RIL_FEATURE_BUFFER_STATS    1
+#endif
+/* RIL_SendATCmdCapture, whole responses stored in a caller provided arena */
+#ifndef RIL_FEATURE_CAPTURE
+    #define RIL_FEATURE_CAPTURE         1
+#endif
+/* Generated command bindings, ril_cmd.h and tools/ril_commands.json */
+#ifndef RIL_FEATURE_COMMANDS
+    #define RIL_FEATURE_COMMANDS        1
+#endif
+/* C++20 coroutine interface, ril_coro.hpp, the frame pool counts against the budget */
+#ifndef RIL_FEATURE_CORO
+    #define RIL_FEATURE_CORO            0
+#endif
+/* Modem capability discovery, ril_caps.h */
+#ifndef RIL_FEATURE_CAPS
+    #define RIL_FEATURE_CAPS            1
+#endif
+/* RIL_suspend and RIL_resume, session state kept across MCU deep sleep */
+#ifndef RIL_FEATURE_SESSION
+    #define RIL_FEATURE_SESSION         1
+#endif
+/* Deferred commands sent together while the modem is awake, ril_batch.h */
+#ifndef RIL_FEATURE_BATCH
+    #define RIL_FEATURE_BATCH           1
+#endif
+/* DTR sleep control and RI wakeup around the command queue, ril_power.h */
+#ifndef RIL_FEATURE_POWER
+    #define RIL_FEATURE_POWER           1
+#endif
+/* Raw data commands, payload written after a prompt and length-framed reads, RIL_SendATCmdPayload */
+#ifndef RIL_FEATURE_PAYLOAD
+    #define RIL_FEATURE_PAYLOAD         1
+#endif
+/* Modem TCP/UDP sockets over the vendor profiles, ril_socket.h, the rings count against the budget */
+#ifndef RIL_FEATURE_SOCKET
+    #define RIL_FEATURE_SOCKET          0
+#endif
+/* Pool of open sockets reused per host, port, type and TLS context, ril_conn.h */
+#ifndef RIL_FEATURE_CONN
+    #define RIL_FEATURE_CONN            0
+#endif
+/* BSD socket calls with blocking, non-blocking and poll over the modem sockets, ril_bsd.h */
+#ifndef RIL_FEATURE_BSD
+    #define RIL_FEATURE_BSD             0
+#endif
+/* Settings table applied once and verified on later boots, ril_settings.h */
+#ifndef RIL_FEATURE_SETTINGS
+    #define RIL_FEATURE_SETTINGS        1
+#endif
+/* Vendor profiles of the socket and file commands, ril_vendor.h */
+#ifndef RIL_FEATURE_VENDOR
+    #define RIL_FEATURE_VENDOR          1
+#endif
+
+/******************************************************************************/
+/*                              Vendor profile                                */
+/******************************************************************************/
+#define RIL_VENDOR_AUTO                 0
+#define RIL_VENDOR_QUECTEL              1
+#define RIL_VENDOR_SIMCOM               2
+#define RIL_VENDOR_UBLOX                3
+/* A fixed vendor binds the RIL_vendor_* calls at compile time and links only its
+   profile, RIL_VENDOR_AUTO links all of them and RIL_vendor_probe picks one */
+#ifndef RIL_VENDOR
+    #define RIL_VENDOR                  RIL_VENDOR_AUTO
+#endif
+
+/******************************************************************************/
+/*                                RAM budget                                  */
+/******************************************************************************/
+/* Static RAM RIL may use, checked at compile time */
+#ifndef RIL_RAM_BUDGET
+    #define RIL_RAM_BUDGET              3072
+#endif
+
+/* The terms below are constant expressions for RIL_STATIC_ASSERT, not for #if: pointers count
+   sizeof(void*) as on the target, and every module asserts that its term covers the state it
+   really keeps, so an estimate that falls short fails the build instead of the board */
+#define RIL_RAM_ALIGN(N)                (((N) + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*))
+
+/* One command descriptor, the pools add the text copy */
+#define RIL_RAM_COMMAND                 (6 * sizeof(void*) + 8 + RIL_FEATURE_PAYLOAD * (3 * sizeof(void*) + 4))
+/* Stream rings, line buffer, the streams and queues, and the command descriptor on the stack of RIL_SendATCmd */
+#define RIL_RAM_CORE                    (RIL_RX_STREAM_SIZE + RIL_TX_STREAM_SIZE + RIL_LINE_LEN + RIL_RAM_COMMAND + \
+                                         20 * sizeof(void*) + 64)
+#define RIL_RAM_POOLS                   (RIL_CMD_POOL_SIZE * RIL_RAM_ALIGN(RIL_RAM_COMMAND + RIL_CMD_LEN) + \
+                                         RIL_URC_POOL_SIZE * RIL_RAM_ALIGN(RIL_URC_LINE_LEN + sizeof(void*) + 4) + \
+                                         RIL_URC_HANDLERS * 2 * sizeof(void*))
+#define RIL_RAM_STATS                   (RIL_FEATURE_BUFFER_STATS * 3 * 28)
+#define RIL_RAM_CORO                    (RIL_FEATURE_CORO * RIL_CORO_FRAMES * (RIL_CORO_FRAME_SIZE + 24))
+#define RIL_RAM_CAPS                    (RIL_FEATURE_CAPS * (RIL_CAPS_FIRMWARE_LEN + 20))
+/* Response caches of the generated commands and their time stamps, RIL_CMD_CACHE_SIZE and
+   RIL_CMD_COUNT come from the generated ril_cmd_gen.h */
+#if RIL_FEATURE_COMMANDS
+    #define RIL_RAM_COMMANDS            (RIL_CMD_CACHE_SIZE + RIL_CMD_COUNT * (sizeof(uint32_t) + sizeof(bool)) + 8)
+#else
+    #define RIL_RAM_COMMANDS            0
+#endif
+/* Active vendor profile */
+#define RIL_RAM_VENDOR                  (RIL_FEATURE_VENDOR * sizeof(void*))
+/* Storage hook of ril_store.h and the settings query buffer, on the stack while RIL_settings_apply runs */
+#define RIL_RAM_SETTINGS                (sizeof(void*) + RIL_FEATURE_SETTINGS * RIL_SETTINGS_QUERY_LEN)
+#define RIL_RAM_BATCH                   (RIL_FEATURE_BATCH * (RIL_BATCH_SLOTS * RIL_RAM_ALIGN(RIL_CMD_LEN + 3 * sizeof(void*) + 12 + \
+                                         RIL_FEATURE_PAYLOAD * (3 * sizeof(void*) + 8)) + 40))
+#define RIL_RAM_POWER                   (RIL_FEATURE_POWER * (sizeof(void*) + 40))
+#define RIL_RAM_PAYLOAD                 (RIL_FEATURE_PAYLOAD * (5 * sizeof(void*) + 12))
+#define RIL_RAM_SOCKET                  (RIL_FEATURE_SOCKET * (RIL_SOCKET_COUNT * (RIL_SOCKET_RX_SIZE + RIL_SOCKET_TX_SIZE + \
+                                         RIL_SOCKET_HOST_LEN + 8 * sizeof(void*) + 32) + \
+                                         (RIL_SOCKET_PREFETCH + 1) * (sizeof(void*) + 16) + 40))
+#define RIL_RAM_BSD                     (RIL_FEATURE_BSD * (RIL_SOCKET_COUNT * 12 + 4))
+#define RIL_RAM_CONN                    (RIL_FEATURE_CONN * (RIL_SOCKET_COUNT * 8 + 20))
+#define RIL_RAM_USAGE                   (RIL_RAM_CORE + RIL_RAM_POOLS + RIL_RAM_STATS + RIL_RAM_CORO + RIL_RAM_CAPS + \
+                                         RIL_RAM_COMMANDS + RIL_RAM_VENDOR + RIL_RAM_SETTINGS + RIL_RAM_BATCH + \
+                                         RIL_RAM_POWER + RIL_RAM_PAYLOAD + RIL_RAM_SOCKET + RIL_RAM_BSD + RIL_RAM_CONN)
+
+#if defined(__cplusplus)
+    #define RIL_STATIC_ASSERT(COND, MSG)    static_assert(COND, MSG)
+#else
+    #define RIL_STATIC_ASSERT(COND, MSG)    _Static_assert(COND, MSG)
+#endif
+
+#endif //_RIL_CONFIG_H_
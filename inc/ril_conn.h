@@ -0,0 +1,86 @@
+/**
+ * @file ril_conn.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Pool of open modem sockets, reused per host, port, type and TLS context
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * RIL_conn_release keeps a socket open instead of closing it, up to
+ * RIL_CONN_IDLE_MAX idle sockets for RIL_CONN_IDLE_MS each. The next
+ * RIL_conn_acquire for the same key gets it back at once, without
+ * AT+QIOPEN or the TLS handshake of the application.
+ *
+ * Idle sockets are checked in RIL_process: the close URC of the peer or
+ * the network, and data nobody asked for, make them unusable and they are
+ * closed. The TLS context is only part of the key, the pool does not run
+ * TLS itself. It tells apart sockets that carry a session of the application's
+ * TLS library from plain ones.
+ */
+
+#ifndef _RIL_CONN_H_
+#define _RIL_CONN_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_CONN
+
+#if !RIL_FEATURE_SOCKET
+    #error "RIL_FEATURE_CONN needs RIL_FEATURE_SOCKET"
+#endif
+
+#include "ril_socket.h"
+#include <stdbool.h>
+
+/**
+ * What a socket is reused for, all fields must match
+ */
+typedef struct {
+    const char*         Host;
+    uint16_t            Port;
+    uint8_t             Type;           /**< RIL_SOCKET_TCP, RIL_SOCKET_UDP, optionally | RIL_SOCKET_PUSH */
+    uint8_t             Tls;            /**< TLS context of the application, 0 for none */
+} RIL_ConnKey;
+
+typedef struct {
+    uint32_t            Opened;         /**< Acquires that had to open a socket */
+    uint32_t            Reused;         /**< Acquires served from an idle socket */
+    uint32_t            Expired;        /**< Idle sockets closed after RIL_CONN_IDLE_MS */
+    uint32_t            Evicted;        /**< Idle sockets closed to make room */
+    uint32_t            Dead;           /**< Idle sockets closed by the peer or the network */
+} RIL_ConnStats;
+
+/*******************************************************************************
+* @brief Hands out an idle socket of the key when one is healthy, else opens
+*   a new one. A reused socket is open and writable at once, fn gets no
+*   RIL_SOCKET_WRITABLE for it. A new one reports open or failed to fn.
+* @param reused set to whether the socket was idle in the pool, may be NULL
+* @return socket number, RIL_AT_BUSY when every socket is in use or an idle
+*   one of another key is being closed to make room, try again after
+*   RIL_process, others as RIL_socket_open
+******************************************************************************/
+int32_t RIL_conn_acquire(const RIL_ConnKey* key, Callback_SocketEvent fn, void* userData, bool* reused);
+
+/*******************************************************************************
+* @brief Gives a socket from RIL_conn_acquire back. With reuse it stays open
+*   and idle when it is healthy and its RX ring is empty, otherwise it is
+*   closed. Pass false after an error of the application protocol.
+******************************************************************************/
+void RIL_conn_release(uint8_t sock, bool reuse);
+
+/*******************************************************************************
+* @brief Closes every idle socket, e.g. before detaching from the network
+******************************************************************************/
+void RIL_conn_flush(void);
+
+/*******************************************************************************
+* @brief Closes idle sockets that expired or died, called from RIL_process
+******************************************************************************/
+void RIL_conn_process(void);
+
+const RIL_ConnStats* RIL_conn_stats(void);
+
+#endif
+
+#endif //_RIL_CONN_H_
@@ -0,0 +1,495 @@
+/**
+ * @file ril_coro.hpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief C++20 coroutine interface of RIL
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Flows are written as coroutines on top of RIL_SendATCmdAsync:
+ *
+ *     ril::Task<> connect() {
+ *         ril::Response r = co_await ril::send("AT+CSQ");
+ *         if (!r.ok()) co_return;
+ *         if (co_await ril::sleep(100) != RIL_AT_SUCCESS) co_return;
+ *         ...
+ *     }
+ *     ril::Executor::spawn(connect());
+ *     while (1) { ril::Executor::poll(); }
+ *
+ * Coroutine frames come from a static pool of RIL_CORO_FRAMES blocks of
+ * RIL_CORO_FRAME_SIZE bytes, everything runs from Executor::poll in the
+ * main loop.
+ */
+
+#ifndef _RIL_CORO_HPP_
+#define _RIL_CORO_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "ril.hpp"
+extern "C" {
+#include "ril_capture.h"
+}
+
+#if !RIL_FEATURE_CORO
+    #error "Set RIL_FEATURE_CORO to 1 in the RIL configuration, so the coroutine frames are budgeted"
+#endif
+#if !RIL_FEATURE_CAPTURE
+    #error "ril_coro.hpp keeps responses in a RIL_Capture, set RIL_FEATURE_CAPTURE to 1"
+#endif
+
+namespace ril {
+
+/**
+ * Intermediate lines and result of one command, a RIL_Capture with its own
+ * storage, owned by value
+ */
+class Response {
+public:
+    Response() noexcept {
+        RIL_capture_init(&capture_, arena_, sizeof(arena_), lines_, RIL_CORO_RESPONSE_LINES);
+    }
+
+    // The capture points into this object, a copy binds it to its own storage
+    Response(const Response& other) noexcept {
+        *this = other;
+    }
+
+    Response& operator=(const Response& other) noexcept {
+        if (this != &other) {
+            std::memcpy(arena_, other.arena_, other.capture_.ArenaUsed);
+            std::memcpy(lines_, other.lines_, other.capture_.LineCount * sizeof(RIL_LineSpan));
+            capture_ = other.capture_;
+            capture_.Arena = arena_;
+            capture_.Lines = lines_;
+        }
+        return *this;
+    }
+
+    bool ok() const {
+        return capture_.Result == RIL_AT_SUCCESS;
+    }
+
+    Result result() const {
+        return capture_.Result;
+    }
+
+    /**
+     * +CME/+CMS ERROR code when result is RIL_AT_FAILED
+     */
+    uint32_t errCode() const {
+        return capture_.ErrCode;
+    }
+
+    uint16_t lineCount() const {
+        return capture_.LineCount;
+    }
+
+    /**
+     * Lines were dropped, see RIL_CORO_RESPONSE_LEN/LINES
+     */
+    bool truncated() const {
+        return capture_.Truncated != 0;
+    }
+
+    std::string_view line(std::size_t index) const {
+        uint32_t len = 0;
+        const char* text = index <= UINT16_MAX ? RIL_capture_line(&capture_, static_cast<uint16_t>(index), &len) : nullptr;
+        return text != nullptr ? std::string_view(text, len) : std::string_view();
+    }
+
+    RIL_Capture* capture() noexcept {
+        return &capture_;
+    }
+
+private:
+    RIL_Capture         capture_;
+    RIL_LineSpan        lines_[RIL_CORO_RESPONSE_LINES];
+    char                arena_[RIL_CORO_RESPONSE_LEN];
+};
+
+namespace detail {
+
+struct alignas(std::max_align_t) FrameBlock {
+    unsigned char       Bytes[RIL_CORO_FRAME_SIZE];
+};
+
+inline FrameBlock frameStorage[RIL_CORO_FRAMES];
+inline RIL_Pool framePool;
+inline bool framePoolReady = false;
+inline std::size_t frameLargest = 0;
+
+inline void* allocFrame(std::size_t size) noexcept {
+    if (!framePoolReady) {
+        RIL_pool_init(&framePool, frameStorage, sizeof(FrameBlock), RIL_CORO_FRAMES);
+        framePoolReady = true;
+    }
+    if (size > frameLargest) {
+        frameLargest = size;
+    }
+    if (size > sizeof(FrameBlock)) {
+        framePool.Stats.Failures++;
+        return nullptr;
+    }
+    return RIL_pool_alloc(&framePool);
+}
+
+inline void freeFrame(void* frame) noexcept {
+    RIL_pool_free(&framePool, frame);
+}
+
+/**
+ * Frame allocation and continuation shared by every Task promise
+ */
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+
+    static void* operator new(std::size_t size) noexcept {
+        return allocFrame(size);
+    }
+
+    static void operator delete(void* frame) noexcept {
+        freeFrame(frame);
+    }
+
+    std::suspend_always initial_suspend() noexcept {
+        return {};
+    }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept {
+            return false;
+        }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            std::coroutine_handle<> next = self.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {}
+};
+
+template <typename T>
+struct PromiseValue : PromiseBase {
+    T value{};
+
+    void return_value(T result) noexcept {
+        value = std::move(result);
+    }
+
+    T take() {
+        return std::move(value);
+    }
+};
+
+template <>
+struct PromiseValue<void> : PromiseBase {
+    void return_void() noexcept {}
+
+    void take() {}
+};
+
+/**
+ * What co_await gives for a Task whose frame could not be allocated
+ */
+template <typename T>
+T failedValue() {
+    if constexpr (std::is_same_v<T, Result>) {
+        return RIL_AT_BUSY;
+    }
+    else if constexpr (!std::is_void_v<T>) {
+        return T{};
+    }
+}
+
+} // namespace detail
+
+/**
+ * Lazily started coroutine, co_await it from another Task or hand it to
+ * Executor::spawn. An invalid Task means its frame could not be allocated:
+ * co_await on it resumes at once with RIL_AT_BUSY for Task<Result> and T{}
+ * otherwise, check valid() first where T{} is a legal answer. The failure
+ * is counted in frameStats().Failures.
+ */
+template <typename T = void>
+class Task {
+public:
+    struct promise_type : detail::PromiseValue<T> {
+        Task get_return_object() noexcept {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        static Task get_return_object_on_allocation_failure() noexcept {
+            return Task();
+        }
+    };
+
+    Task() noexcept = default;
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() {
+        destroy();
+    }
+
+    bool valid() const noexcept {
+        return static_cast<bool>(handle_);
+    }
+
+    bool await_ready() const noexcept {
+        return !handle_ || handle_.done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle_.promise().continuation = caller;
+        return handle_;
+    }
+
+    T await_resume() {
+        if (!handle_) {
+            return detail::failedValue<T>();
+        }
+        return handle_.promise().take();
+    }
+
+    std::coroutine_handle<promise_type> release() noexcept {
+        return std::exchange(handle_, nullptr);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    void destroy() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Single-threaded executor driven from the main loop
+ */
+class Executor {
+public:
+    /**
+     * Starts a root task on the next poll.
+     * @return false if the task is invalid or all RIL_CORO_FRAMES root slots are taken
+     */
+    static bool spawn(Task<>&& task) {
+        if (!task.valid()) {
+            return false;
+        }
+        for (std::coroutine_handle<>& root : roots_) {
+            if (!root) {
+                root = task.release();
+                schedule(root);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Runs the RIL engine, wakes due sleepers and resumes ready coroutines
+     */
+    static void poll() {
+        RIL_process();
+
+        uint32_t now = HAL_GetTick();
+        for (Sleeper& sleeper : sleepers_) {
+            if (sleeper.Handle && static_cast<int32_t>(now - sleeper.Deadline) >= 0) {
+                schedule(std::exchange(sleeper.Handle, nullptr));
+            }
+        }
+
+        // Only what is ready now, a coroutine scheduled while resuming waits for the next poll
+        for (uint8_t count = readyCount_; count > 0; count--) {
+            std::coroutine_handle<> handle = ready_[readyHead_];
+            readyHead_ = static_cast<uint8_t>((readyHead_ + 1) % RIL_CORO_FRAMES);
+            readyCount_--;
+            handle.resume();
+        }
+
+        for (std::coroutine_handle<>& root : roots_) {
+            if (root && root.done()) {
+                root.destroy();
+                root = nullptr;
+            }
+        }
+    }
+
+    /**
+     * Returns true when no root task is alive
+     */
+    static bool idle() {
+        for (std::coroutine_handle<> root : roots_) {
+            if (root) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void schedule(std::coroutine_handle<> handle) {
+        // Every suspended coroutine owns a frame, so the queue can not overflow
+        ready_[(readyHead_ + readyCount_) % RIL_CORO_FRAMES] = handle;
+        readyCount_++;
+    }
+
+    /**
+     * Resumes handle from the first poll at or after deadline
+     * @return false when all RIL_CORO_FRAMES timers are taken, handle is not kept
+     */
+    static bool sleep(std::coroutine_handle<> handle, uint32_t deadline) {
+        for (Sleeper& sleeper : sleepers_) {
+            if (!sleeper.Handle) {
+                sleeper.Handle = handle;
+                sleeper.Deadline = deadline;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Sleeper {
+        std::coroutine_handle<>     Handle;
+        uint32_t                    Deadline;
+    };
+
+    inline static std::coroutine_handle<> roots_[RIL_CORO_FRAMES];
+    inline static std::coroutine_handle<> ready_[RIL_CORO_FRAMES];
+    inline static Sleeper sleepers_[RIL_CORO_FRAMES];
+    inline static uint8_t readyHead_ = 0;
+    inline static uint8_t readyCount_ = 0;
+};
+
+/**
+ * co_await ril::send(cmd): queues the command and resumes with its Response
+ */
+class SendAwaiter {
+public:
+    SendAwaiter(std::string_view cmd, uint32_t timeOut) noexcept : cmd_(cmd), timeOut_(timeOut) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept {
+        handle_ = handle;
+        RIL_Capture* capture = response_.capture();
+        capture->Result = RIL_SendATCmdAsync(cmd_.data(), static_cast<uint32_t>(cmd_.size()),
+                                             &onLine, &onDone, this, timeOut_);
+        // Not queued: resume at once with the error
+        return capture->Result == RIL_AT_SUCCESS;
+    }
+
+    Response await_resume() noexcept {
+        return response_;
+    }
+
+private:
+    static uint32_t onLine(char* line, uint32_t len, void* userData) {
+        return RIL_capture_callback(line, len, static_cast<SendAwaiter*>(userData)->response_.capture());
+    }
+
+    static void onDone(RIL_ATSndError result, void* userData) {
+        SendAwaiter* self = static_cast<SendAwaiter*>(userData);
+        RIL_Capture* capture = self->response_.capture();
+        capture->Result = result;
+        if (result == RIL_AT_FAILED) {
+            capture->ErrCode = Ql_RIL_AT_GetErrCode().atError;
+        }
+        Executor::schedule(self->handle_);
+    }
+
+    std::string_view            cmd_;
+    uint32_t                    timeOut_;
+    std::coroutine_handle<>     handle_;
+    Response                    response_;
+};
+
+/**
+ * co_await ril::sleep(ms): resumes after at least ms milliseconds, from Executor::poll.
+ * Every Task frame has a timer, only coroutines of other types can run out of
+ * them, the result tells.
+ */
+class SleepAwaiter {
+public:
+    explicit SleepAwaiter(uint32_t ms) noexcept : ms_(ms) {}
+
+    bool await_ready() const noexcept {
+        return ms_ == 0;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept {
+        // The tick may be about to turn, one more keeps the wait at least ms as HAL_Delay does
+        slept_ = Executor::sleep(handle, HAL_GetTick() + ms_ + 1);
+        return slept_;
+    }
+
+    /**
+     * RIL_AT_BUSY when no timer was free and the coroutine did not sleep at all
+     */
+    [[nodiscard]] Result await_resume() const noexcept {
+        return slept_ ? RIL_AT_SUCCESS : RIL_AT_BUSY;
+    }
+
+private:
+    uint32_t                    ms_;
+    bool                        slept_ = true;
+};
+
+/**
+ * The command is copied when it is queued, cmd only has to live until then
+ */
+inline SendAwaiter send(std::string_view cmd, uint32_t timeOut = 0) noexcept {
+    return SendAwaiter(cmd, timeOut);
+}
+
+inline SleepAwaiter sleep(uint32_t ms) noexcept {
+    return SleepAwaiter(ms);
+}
+
+inline RIL_PoolStats frameStats() {
+    return detail::framePool.Stats;
+}
+
+/**
+ * Largest frame requested so far, RIL_CORO_FRAME_SIZE must be at least this
+ */
+inline std::size_t frameLargest() {
+    return detail::frameLargest;
+}
+
+} // namespace ril
+
+#endif //_RIL_CORO_HPP_
@@ -0,0 +1,325 @@
+/**
+ * @file ril_decode.hpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Typed response decoding, C++20
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * A response line is declared once by its prefix and field types, the parser
+ * is unrolled at compile time, one step per field:
+ *
+ *     using Csq = ril::ResponseOf<"+CSQ:", int, int>;
+ *     using Cops = ril::ResponseOf<"+COPS:", int, ril::opt<int>, ril::str, ril::opt<int>>;
+ *
+ *     auto csq = Csq::parse("+CSQ: 20,99");       // csq.value == std::tuple<int, int>{20, 99}
+ *
+ *     Csq::Decoded rsp;
+ *     ril::Ril::send("AT+CSQ", Csq::into(rsp));   // line callback, fails the command on a bad line
+ *     if (rsp) { auto [rssi, ber] = rsp.value; }
+ *
+ * Fields:
+ *     integer types   decimal with optional sign
+ *     ril::str        std::string_view into the line, quoted or bare, only valid
+ *                     while the line is (inside the line callback)
+ *     ril::text<N>    owned copy of a string field, up to N - 1 chars
+ *     ril::opt<T>     std::optional, empty when the field is empty or missing
+ * Fields after the declared ones are ignored.
+ */
+
+#ifndef _RIL_DECODE_HPP_
+#define _RIL_DECODE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "ril_format.hpp"
+
+namespace ril {
+
+/** String field as a view into the line */
+struct str {};
+
+/** String field copied into Text<N> */
+template <std::size_t N>
+struct text {};
+
+/** Optional field */
+template <typename T>
+struct opt {};
+
+/**
+ * Owned string field, cut at N - 1 characters
+ */
+template <std::size_t N>
+struct Text {
+    static_assert(N > 1, "ril::text<N> needs room for one char and the null terminator");
+
+    uint16_t    Len = 0;
+    char        Data[N] = {};
+
+    std::string_view view() const {
+        return std::string_view(Data, Len);
+    }
+
+    operator std::string_view() const {
+        return view();
+    }
+};
+
+enum class DecodeError : uint8_t {
+    None = 0,
+    Prefix,     /**< Line does not start with the prefix */
+    Missing,    /**< Required field is empty or absent */
+    Number,     /**< Integer field is not a number or does not fit its type */
+    Quote,      /**< Quoted string has no closing quote */
+};
+
+namespace detail {
+
+template <typename Field>
+struct FieldOf {
+    static_assert(std::is_integral_v<Field> && !std::is_same_v<Field, bool>,
+                  "response field must be an integer type, ril::str, ril::text<N> or ril::opt<T>");
+    using Value = Field;
+};
+
+template <>
+struct FieldOf<str> {
+    using Value = std::string_view;
+};
+
+template <std::size_t N>
+struct FieldOf<text<N>> {
+    using Value = Text<N>;
+};
+
+template <typename T>
+struct FieldOf<opt<T>> {
+    using Value = std::optional<typename FieldOf<T>::Value>;
+};
+
+/**
+ * Read position in the line, fields end at ',' or at the end of the line
+ */
+struct Cursor {
+    const char*     Pos;
+    const char*     End;
+
+    bool atFieldEnd() const {
+        return Pos == End || *Pos == ',';
+    }
+
+    void skipSpaces() {
+        while (Pos != End && *Pos == ' ') {
+            Pos++;
+        }
+    }
+};
+
+template <typename T>
+DecodeError parseInteger(Cursor& cur, T& value) {
+    using Wide = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+    cur.skipSpaces();
+    bool negative = false;
+    if constexpr (std::is_signed_v<T>) {
+        if (cur.Pos != cur.End && (*cur.Pos == '-' || *cur.Pos == '+')) {
+            negative = *cur.Pos++ == '-';
+        }
+    }
+    const char* digits = cur.Pos;
+    uint64_t magnitude = 0;
+    while (cur.Pos != cur.End && *cur.Pos >= '0' && *cur.Pos <= '9') {
+        if (magnitude > (UINT64_MAX - 9) / 10) {
+            return DecodeError::Number;
+        }
+        magnitude = magnitude * 10 + static_cast<uint64_t>(*cur.Pos++ - '0');
+        if (magnitude > static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u)) {
+            return DecodeError::Number;
+        }
+    }
+    cur.skipSpaces();
+    if (cur.Pos == digits || !cur.atFieldEnd()) {
+        return DecodeError::Number;
+    }
+    value = static_cast<T>(negative ? static_cast<Wide>(0 - magnitude) : static_cast<Wide>(magnitude));
+    return DecodeError::None;
+}
+
+inline DecodeError parseString(Cursor& cur, std::string_view& value) {
+    cur.skipSpaces();
+    if (cur.Pos != cur.End && *cur.Pos == '"') {
+        const char* start = ++cur.Pos;
+        const char* close = static_cast<const char*>(std::memchr(start, '"', static_cast<std::size_t>(cur.End - start)));
+        if (close == nullptr) {
+            return DecodeError::Quote;
+        }
+        value = std::string_view(start, static_cast<std::size_t>(close - start));
+        cur.Pos = close + 1;
+        cur.skipSpaces();
+        return cur.atFieldEnd() ? DecodeError::None : DecodeError::Quote;
+    }
+    const char* start = cur.Pos;
+    const char* comma = static_cast<const char*>(std::memchr(start, ',', static_cast<std::size_t>(cur.End - start)));
+    cur.Pos = comma != nullptr ? comma : cur.End;
+    value = std::string_view(start, static_cast<std::size_t>(cur.Pos - start));
+    return DecodeError::None;
+}
+
+template <typename Field>
+struct FieldParser {
+    static DecodeError parse(Cursor& cur, Field& value) {
+        return parseInteger(cur, value);
+    }
+};
+
+template <>
+struct FieldParser<str> {
+    static DecodeError parse(Cursor& cur, std::string_view& value) {
+        return parseString(cur, value);
+    }
+};
+
+template <std::size_t N>
+struct FieldParser<text<N>> {
+    static DecodeError parse(Cursor& cur, Text<N>& value) {
+        std::string_view view;
+        DecodeError error = parseString(cur, view);
+        if (error == DecodeError::None) {
+            value.Len = static_cast<uint16_t>(view.size() < N - 1 ? view.size() : N - 1);
+            std::memcpy(value.Data, view.data(), value.Len);
+            value.Data[value.Len] = 0;
+        }
+        return error;
+    }
+};
+
+template <typename T>
+struct FieldParser<opt<T>> {
+    static DecodeError parse(Cursor& cur, typename FieldOf<opt<T>>::Value& value) {
+        Cursor peek = cur;
+        peek.skipSpaces();
+        if (peek.atFieldEnd()) {
+            cur = peek;
+            value.reset();
+            return DecodeError::None;
+        }
+        typename FieldOf<T>::Value inner{};
+        DecodeError error = FieldParser<T>::parse(cur, inner);
+        if (error == DecodeError::None) {
+            value = inner;
+        }
+        return error;
+    }
+};
+
+template <typename T>
+constexpr bool isOptional = false;
+
+template <typename T>
+constexpr bool isOptional<opt<T>> = true;
+
+} // namespace detail
+
+/**
+ * Decoded line: the fields as a tuple, or the error and the index of the field
+ */
+template <typename Tuple>
+struct Decoded {
+    Tuple           value{};
+    DecodeError     error = DecodeError::Missing;   /**< Missing until a line was parsed */
+    uint8_t         field = 0;
+
+    explicit operator bool() const {
+        return error == DecodeError::None;
+    }
+};
+
+template <FixedString Prefix, typename... Fields>
+struct ResponseOf {
+    using Tuple = std::tuple<typename detail::FieldOf<Fields>::Value...>;
+    using Decoded = ril::Decoded<Tuple>;
+
+    static constexpr std::string_view prefix() {
+        return std::string_view(Prefix.Data, Prefix.size());
+    }
+
+    static bool matches(std::string_view line) {
+        return line.size() >= Prefix.size() && std::memcmp(line.data(), Prefix.Data, Prefix.size()) == 0;
+    }
+
+    static Decoded parse(std::string_view line) {
+        Decoded out;
+        if (!matches(line)) {
+            out.error = DecodeError::Prefix;
+            return out;
+        }
+        detail::Cursor cur{ line.data() + Prefix.size(), line.data() + line.size() };
+        out.error = DecodeError::None;
+        parseFields(out, cur, std::index_sequence_for<Fields...>{});
+        return out;
+    }
+
+    /**
+     * Line callback for Ril::send/BasicRil::send: decodes the line with the
+     * prefix into out, fails the command when that line does not decode
+     */
+    static auto into(Decoded& out) {
+        return [&out](std::string_view line) -> RIL_ATRspError {
+            if (!matches(line)) {
+                return RIL_AT_RSP_CONTINUE;
+            }
+            out = parse(line);
+            return out ? RIL_AT_RSP_CONTINUE : RIL_AT_RSP_FAILED;
+        };
+    }
+
+private:
+    template <std::size_t... I>
+    static void parseFields(Decoded& out, detail::Cursor& cur, std::index_sequence<I...>) {
+        // Stops at the first field that fails
+        (void) (parseField<I, Fields>(out, cur) && ...);
+    }
+
+    template <std::size_t I, typename Field>
+    static bool parseField(Decoded& out, detail::Cursor& cur) {
+        if constexpr (I > 0) {
+            if (cur.Pos == cur.End) {
+                if constexpr (detail::isOptional<Field>) {
+                    return true;
+                }
+                return fail(out, I, DecodeError::Missing);
+            }
+            // The previous field stopped at its ','
+            cur.Pos++;
+        }
+        // An empty string is a value, an empty number is not
+        if constexpr (std::is_integral_v<Field>) {
+            detail::Cursor peek = cur;
+            peek.skipSpaces();
+            if (peek.atFieldEnd()) {
+                return fail(out, I, DecodeError::Missing);
+            }
+        }
+        DecodeError error = detail::FieldParser<Field>::parse(cur, std::get<I>(out.value));
+        return error == DecodeError::None || fail(out, I, error);
+    }
+
+    static bool fail(Decoded& out, std::size_t field, DecodeError error) {
+        out.error = error;
+        out.field = static_cast<uint8_t>(field);
+        return false;
+    }
+};
+
+} // namespace ril
+
+#endif //_RIL_DECODE_HPP_
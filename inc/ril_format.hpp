@@ -0,0 +1,331 @@
+/**
+ * @file ril_format.hpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Compile-time checked AT command formatting, C++20
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * The format is a template argument, so it is split into constant fragments
+ * and conversions at compile time and every argument is checked against its
+ * conversion before anything runs:
+ *
+ *     auto cmd = ril::format<"AT+QIOPEN=1,%u,\"TCP\",\"%s\",%u,0,1">(ctx, host, port);
+ *     ril::Ril::send(cmd.view(), 150000);
+ *
+ * At run time only the conversions are formatted, the fragments are copies
+ * of known length. The result goes to RIL_SendATCmd/BasicRil::send, which
+ * write it to the TX stream as is and append the CRLF from a constant.
+ *
+ * Conversions:
+ *     %d  signed or unsigned integer      %u  unsigned integer
+ *     %x  unsigned integer, hex           %c  char
+ *     %s  const char*, std::string_view or char array
+ *     %%  a literal '%'
+ */
+
+#ifndef _RIL_FORMAT_HPP_
+#define _RIL_FORMAT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "ril.hpp"
+
+namespace ril {
+
+/**
+ * String literal usable as a template argument
+ */
+template <std::size_t N>
+struct FixedString {
+    char Data[N] = {};
+
+    constexpr FixedString(const char (&str)[N]) {
+        for (std::size_t i = 0; i < N; i++) {
+            Data[i] = str[i];
+        }
+    }
+
+    constexpr std::size_t size() const {
+        return N - 1;
+    }
+};
+
+/**
+ * Formatted command, Len is 0 when the variable fields did not fit
+ */
+template <std::size_t Capacity>
+struct Command {
+    uint32_t    Len = 0;
+    char        Data[Capacity];
+
+    explicit operator bool() const {
+        return Len != 0;
+    }
+
+    std::string_view view() const {
+        return std::string_view(Data, Len);
+    }
+
+    operator std::string_view() const {
+        return view();
+    }
+};
+
+namespace detail {
+
+struct FormatPiece {
+    std::size_t     Offset;     /**< Literal: start in the format */
+    std::size_t     Len;        /**< Literal: length, 0 for a conversion */
+    char            Conv;       /**< Conversion character, 0 for a literal */
+    std::size_t     Arg;        /**< Conversion: index of its argument */
+};
+
+template <std::size_t N>
+struct FormatPieces {
+    FormatPiece     Items[N > 0 ? N : 1] = {};
+    std::size_t     Count = 0;
+    std::size_t     ArgCount = 0;
+    std::size_t     Literal = 0;    /**< Bytes of all fragments */
+    bool            Valid = true;
+};
+
+constexpr bool isConversion(char c) {
+    return c == 'd' || c == 'u' || c == 'x' || c == 'c' || c == 's';
+}
+
+/**
+ * Splits the format into fragments and conversions, "%%" becomes a fragment holding '%'
+ */
+template <FixedString Fmt>
+constexpr auto parseFormat() {
+    FormatPieces<Fmt.size()> pieces;
+    std::size_t start = 0;
+    auto literal = [&](std::size_t offset, std::size_t len) {
+        if (len > 0) {
+            pieces.Items[pieces.Count++] = FormatPiece{ offset, len, 0, 0 };
+            pieces.Literal += len;
+        }
+    };
+    for (std::size_t i = 0; i < Fmt.size(); i++) {
+        if (Fmt.Data[i] != '%') {
+            continue;
+        }
+        if (i + 1 >= Fmt.size()) {
+            pieces.Valid = false;
+            break;
+        }
+        char conv = Fmt.Data[i + 1];
+        if (conv == '%') {
+            // Keep the first '%' as the end of the fragment, drop the second
+            literal(start, i + 1 - start);
+        }
+        else if (isConversion(conv)) {
+            literal(start, i - start);
+            pieces.Items[pieces.Count++] = FormatPiece{ 0, 0, conv, pieces.ArgCount++ };
+        }
+        else {
+            pieces.Valid = false;
+            break;
+        }
+        i++;
+        start = i + 1;
+    }
+    literal(start, Fmt.size() - start);
+    return pieces;
+}
+
+template <typename T>
+using Bare = std::remove_cv_t<std::remove_reference_t<T>>;
+
+template <typename T>
+constexpr bool isInteger = std::is_integral_v<Bare<T>> && !std::is_same_v<Bare<T>, bool> && !std::is_same_v<Bare<T>, char>;
+
+template <typename T>
+constexpr bool isText = std::is_convertible_v<const T&, std::string_view> ||
+                        std::is_same_v<std::decay_t<T>, char*> || std::is_same_v<std::decay_t<T>, const char*>;
+
+template <typename T>
+constexpr bool accepts(char conv) {
+    switch (conv) {
+        case 'd':
+            return isInteger<T>;
+        case 'u':
+        case 'x':
+            return isInteger<T> && std::is_unsigned_v<Bare<T>>;
+        case 'c':
+            return std::is_same_v<Bare<T>, char>;
+        default:
+            return isText<T>;
+    }
+}
+
+/**
+ * Checks every argument against its conversion, returns the index of the
+ * first mismatch or sizeof...(Args) when all match
+ */
+template <FixedString Fmt, typename... Args>
+constexpr std::size_t firstMismatch() {
+    constexpr auto pieces = parseFormat<Fmt>();
+    char argConv[sizeof...(Args) + 1] = {};
+    for (std::size_t i = 0; i < pieces.Count; i++) {
+        if (pieces.Items[i].Conv != 0 && pieces.Items[i].Arg < sizeof...(Args)) {
+            argConv[pieces.Items[i].Arg] = pieces.Items[i].Conv;
+        }
+    }
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        const bool ok[] = { accepts<Args>(argConv[I])..., true };
+        std::size_t index = 0;
+        while (index != sizeof...(Args) && ok[index]) {
+            index++;
+        }
+        return index;
+    }(std::index_sequence_for<Args...>{});
+}
+
+template <typename T>
+constexpr std::size_t maxDigits() {
+    // Decimal digits of the widest value plus the sign
+    return std::numeric_limits<Bare<T>>::digits10 + 1 + std::is_signed_v<Bare<T>>;
+}
+
+inline char* writeUnsigned(char* out, uint64_t value, unsigned base) {
+    char digits[20];
+    std::size_t len = 0;
+    do {
+        unsigned digit = static_cast<unsigned>(value % base);
+        digits[len++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value != 0);
+    while (len > 0) {
+        *out++ = digits[--len];
+    }
+    return out;
+}
+
+/**
+ * Writes one conversion, returns nullptr when it does not fit before end
+ */
+template <char Conv, typename T>
+char* writeArg(char* out, char* end, const T& value) {
+    if constexpr (Conv == 's') {
+        std::string_view text(value);
+        if (text.size() > static_cast<std::size_t>(end - out)) {
+            return nullptr;
+        }
+        std::memcpy(out, text.data(), text.size());
+        return out + text.size();
+    }
+    else if constexpr (Conv == 'c') {
+        if (out == end) {
+            return nullptr;
+        }
+        *out = value;
+        return out + 1;
+    }
+    else {
+        // Formatted aside first, only the digits the value really has must fit
+        char digits[maxDigits<T>()];
+        char* pos = digits;
+        if constexpr (std::is_signed_v<Bare<T>>) {
+            if (value < 0) {
+                *pos++ = '-';
+                pos = writeUnsigned(pos, 0 - static_cast<uint64_t>(value), 10);
+            }
+            else {
+                pos = writeUnsigned(pos, static_cast<uint64_t>(value), 10);
+            }
+        }
+        else {
+            pos = writeUnsigned(pos, static_cast<uint64_t>(value), Conv == 'x' ? 16 : 10);
+        }
+        std::size_t len = static_cast<std::size_t>(pos - digits);
+        if (len > static_cast<std::size_t>(end - out)) {
+            return nullptr;
+        }
+        std::memcpy(out, digits, len);
+        return out + len;
+    }
+}
+
+template <std::size_t I, typename First, typename... Rest>
+constexpr const auto& nth(const First& first, const Rest&... rest) {
+    if constexpr (I == 0) {
+        return first;
+    }
+    else {
+        return nth<I - 1>(rest...);
+    }
+}
+
+/**
+ * Shows the index of the bad argument in the compiler output as Bad
+ */
+template <std::size_t Bad, std::size_t Count>
+constexpr bool argumentsMatch() {
+    static_assert(Bad == Count, "AT command argument number Bad does not match its conversion");
+    return true;
+}
+
+template <FixedString Fmt, std::size_t Capacity, std::size_t... P, typename... Args>
+Command<Capacity> formatPieces(std::index_sequence<P...>, const Args&... args) {
+    constexpr auto pieces = parseFormat<Fmt>();
+    Command<Capacity> cmd;
+    char* out = cmd.Data;
+    char* const end = cmd.Data + Capacity;
+    bool fits = true;
+    auto piece = [&]<std::size_t I>() {
+        constexpr FormatPiece item = pieces.Items[I];
+        if (!fits) {
+            return;
+        }
+        if constexpr (item.Conv == 0) {
+            // Fragment of constant length, the capacity check folds away when it always fits
+            if (static_cast<std::size_t>(end - out) < item.Len) {
+                fits = false;
+                return;
+            }
+            std::memcpy(out, &Fmt.Data[item.Offset], item.Len);
+            out += item.Len;
+        }
+        else {
+            out = writeArg<item.Conv>(out, end, nth<item.Arg>(args...));
+            fits = out != nullptr;
+        }
+    };
+    (piece.template operator()<P>(), ...);
+    cmd.Len = fits ? static_cast<uint32_t>(out - cmd.Data) : 0;
+    return cmd;
+}
+
+} // namespace detail
+
+/**
+ * Formats an AT command, the arguments are checked against Fmt at compile time.
+ * The result is empty (false) when the variable fields do not fit Capacity.
+ */
+template <FixedString Fmt, std::size_t Capacity = RIL_CMD_LEN, typename... Args>
+Command<Capacity> format(const Args&... args) {
+    constexpr auto pieces = detail::parseFormat<Fmt>();
+    static_assert(pieces.Valid, "bad conversion in AT command format, use %d %u %x %c %s or %%");
+    static_assert(pieces.ArgCount == sizeof...(Args), "AT command format and argument count differ");
+    static_assert(pieces.Literal <= Capacity, "constant part of the AT command exceeds Capacity");
+    if constexpr (pieces.Valid && pieces.ArgCount == sizeof...(Args) &&
+                  detail::argumentsMatch<detail::firstMismatch<Fmt, Args...>(), sizeof...(Args)>()) {
+        return detail::formatPieces<Fmt, Capacity>(std::make_index_sequence<pieces.Count>{}, args...);
+    }
+    else {
+        return Command<Capacity>();
+    }
+}
+
+} // namespace ril
+
+#endif //_RIL_FORMAT_HPP_
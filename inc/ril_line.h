@@ -0,0 +1,66 @@
+/**
+ * @file ril_line.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Response line assembly and parsing shared by ril.c and ril_basic.hpp
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Internal to RIL: both engines own their line buffer and command text and
+ * pass them in, so the rules for lines, echoes and errors live in one place.
+ */
+
+#ifndef _RIL_LINE_H_
+#define _RIL_LINE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ril_config.h"
+#include "ril_prefix.h"
+
+/*******************************************************************************
+* @brief Appends the bytes of data before eol, or all of them when eol < 0, to
+*   line. Bytes beyond size - 1 are dropped, room for the null terminator.
+* @param lineLen bytes already in line, updated
+* @param cut set when bytes were dropped, may be NULL
+* @return bytes of data to consume, the terminator included
+******************************************************************************/
+uint32_t RIL_lineAppend(char* line, uint32_t* lineLen, uint32_t size, const uint8_t* data, uint32_t avail,
+                        int32_t eol, bool* cut);
+
+/*******************************************************************************
+* @brief Ends the line when a terminator was found, empty lines (the LF of a
+*   CRLF pair) are skipped.
+* @return length of the completed, null terminated line and lineLen back to 0,
+*   or -1 if the line goes on
+******************************************************************************/
+int32_t RIL_lineEnd(char* line, uint32_t* lineLen, int32_t eol);
+
+/*******************************************************************************
+* @brief Numeric result codes are a single digit line when numeric is set,
+*   everything else goes through the prefix hash
+******************************************************************************/
+const RIL_Prefix* RIL_lineClassify(const char* line, int32_t len, bool numeric);
+
+/*******************************************************************************
+* @brief Compares a line with the sent command, a line cut at size - 1 bytes
+*   only has to match its kept part
+* @param size capacity of the line buffer
+******************************************************************************/
+bool RIL_lineIsEcho(const char* line, int32_t len, uint32_t size, const char* atCmd, uint32_t atCmdLen);
+
+/*******************************************************************************
+* @brief Checks whether a "+XXX:" prefix names the command that was sent,
+*   e.g. "+CSQ:" for "AT+CSQ" or "AT+CREG?". The name has to end at '=',
+*   '?', ';' or the end of the command, so "+CMT:" does not answer "AT+CMTI".
+******************************************************************************/
+bool RIL_lineIsResponseOf(const RIL_Prefix* prefix, const char* atCmd, uint32_t atCmdLen);
+
+/*******************************************************************************
+* @brief Returns the numeric code of "+CME ERROR: <n>"/"+CMS ERROR: <n>",
+*   RIL_AT_FAILED for other final errors
+******************************************************************************/
+uint32_t RIL_lineErrCode(const RIL_Prefix* prefix, const char* line);
+
+#endif //_RIL_LINE_H_
@@ -0,0 +1,53 @@
+/**
+ * @file ril_pool.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Fixed-size O(1) object pools, RIL never touches the heap
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#ifndef _RIL_POOL_H_
+#define _RIL_POOL_H_
+
+#include <stdint.h>
+
+typedef struct {
+    uint16_t            Capacity;       /**< Number of blocks */
+    uint16_t            Used;           /**< Blocks currently allocated */
+    uint16_t            Peak;           /**< Largest Used seen */
+    uint16_t            Failures;       /**< Allocations refused because the pool was empty */
+} RIL_PoolStats;
+
+typedef struct {
+    void*               Free;           /**< Singly linked list of free blocks */
+    RIL_PoolStats       Stats;
+} RIL_Pool;
+
+/**
+ * Declares the static storage of a pool of CAPACITY objects of TYPE.
+ * Each block is big enough for the object and for the free list link.
+ */
+#define RIL_POOL_STORAGE(NAME, TYPE, CAPACITY)  \
+    static union { TYPE Object; void* Next; } NAME[CAPACITY]
+
+/*******************************************************************************
+* @brief Links capacity blocks of blockSize bytes at storage into the free list.
+*   Use sizeof(NAME[0]) of a RIL_POOL_STORAGE as blockSize.
+******************************************************************************/
+void RIL_pool_init(RIL_Pool* pool, void* storage, uint16_t blockSize, uint16_t capacity);
+
+/*******************************************************************************
+* @brief Takes a block from the pool in constant time.
+* @return the block, or NULL if the pool is exhausted (counted in Stats.Failures)
+******************************************************************************/
+void* RIL_pool_alloc(RIL_Pool* pool);
+
+/*******************************************************************************
+* @brief Returns a block taken with RIL_pool_alloc, in constant time.
+******************************************************************************/
+void RIL_pool_free(RIL_Pool* pool, void* block);
+
+#endif //_RIL_POOL_H_
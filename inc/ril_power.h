@@ -0,0 +1,94 @@
+/**
+ * @file ril_power.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief DTR sleep control and RI wakeup around the command queue
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Once RIL_power_init installed the GPIO hooks, the engine wakes the modem
+ * through DTR before the first queued command, holds the command for the
+ * wake-to-ready delay and releases DTR after the queue stayed idle for the
+ * idle timeout. The modem must have DTR sleep enabled (AT+QSCLK=1 on
+ * Quectel, AT+CSCLK=1 on SIMCom, AT+UPSV=3 on u-blox).
+ *
+ * Call RIL_power_ringIndicator from the RI edge interrupt: the modem is
+ * about to send a URC, DTR is held until it was received and dispatched.
+ */
+
+#ifndef _RIL_POWER_H_
+#define _RIL_POWER_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_POWER
+
+#include <stdbool.h>
+
+typedef struct {
+    /* awake true: keep the modem awake, false: let it sleep. The hook maps it to the DTR level */
+    void (*setDtr)(bool awake, void* args);
+    void*               Args;
+} RIL_PowerHooks;
+
+typedef enum {
+    RIL_POWER_OFF       = 0,    /**< No hooks, the modem is assumed awake */
+    RIL_POWER_ASLEEP    = 1,
+    RIL_POWER_WAKING    = 2,    /**< DTR asserted, waiting for the wake-to-ready delay */
+    RIL_POWER_AWAKE     = 3,
+} RIL_PowerState;
+
+typedef struct {
+    uint32_t            Wakes;          /**< DTR wakes for queued commands */
+    uint32_t            RingWakes;      /**< Wakes started by RI */
+    uint32_t            Sleeps;
+    uint32_t            AwakeMs;        /**< Time DTR was asserted, the current awake period included */
+} RIL_PowerStats;
+
+/*******************************************************************************
+* @brief Installs the hooks and lets the modem sleep, NULL turns power
+*   management off and leaves DTR asserted. hooks must outlive their use.
+* @param wakeMs wake-to-ready delay, 0 for RIL_POWER_WAKE_MS
+* @param idleMs idle timeout, 0 for RIL_POWER_IDLE_MS
+******************************************************************************/
+void RIL_power_init(const RIL_PowerHooks* hooks, uint32_t wakeMs, uint32_t idleMs);
+
+/*******************************************************************************
+* @brief RI edge, safe to call from an interrupt
+******************************************************************************/
+void RIL_power_ringIndicator(void);
+
+/*******************************************************************************
+* @brief Called by the engine before it sends a command: wakes the modem when
+*   it sleeps
+* @return true once the modem takes commands
+******************************************************************************/
+bool RIL_power_ready(void);
+
+/*******************************************************************************
+* @brief Idle timeout and RI handling, called from RIL_process
+******************************************************************************/
+void RIL_power_process(void);
+
+RIL_PowerState RIL_power_state(void);
+const RIL_PowerStats* RIL_power_stats(void);
+
+#if defined(__unix__) || defined(__APPLE__)
+/**
+ * Simulated DTR line for host builds
+ */
+typedef struct {
+    bool                Dtr;            /**< true while the modem is held awake */
+    uint32_t            Edges;
+} RIL_PowerSim;
+
+/*******************************************************************************
+* @brief Hooks that drive sim instead of a GPIO
+******************************************************************************/
+RIL_PowerHooks RIL_power_simulated(RIL_PowerSim* sim);
+#endif
+
+#endif
+
+#endif //_RIL_POWER_H_
@@ -0,0 +1,57 @@
+/**
+ * @file ril_prefix.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Perfect hash classification of response and URC lines
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#ifndef _RIL_PREFIX_H_
+#define _RIL_PREFIX_H_
+
+#include <stdint.h>
+#include "ril_config.h"
+#include "ril_prefix_id.h"
+
+typedef enum {
+    RIL_LINE_INFO           = 0, /**< Intermediate response line, passed to the command callback */
+    RIL_LINE_FINAL_OK       = 1, /**< Final result code, command succeeded */
+    RIL_LINE_FINAL_ERROR    = 2, /**< Final result code, command failed */
+    RIL_LINE_URC            = 3, /**< Unsolicited result code */
+} RIL_LineKind;
+
+typedef struct {
+    const char*         Str;
+    uint8_t             Len;
+    uint8_t             Id;     /**< RIL_PrefixId */
+    uint8_t             Kind;   /**< RIL_LineKind */
+} RIL_Prefix;
+
+/* Generated tables, see tools/ril_prefixgen.py */
+extern const uint8_t RIL_PREFIX_DISPLACEMENT[RIL_PREFIX_BUCKETS];
+extern const RIL_Prefix RIL_PREFIX_TABLE[RIL_PREFIX_COUNT];
+
+/*******************************************************************************
+* @brief Looks up the prefix of a response line: everything up to and including
+*   the first ':', or the whole line when it has no ':'. A line without ':'
+*   that matches no entry is looked up again up to each of its first
+*   RIL_PREFIX_SPACES + 1 spaces, so "CONNECT 115200" is CONNECT and
+*   "SEND OK 1" is SEND OK. Costs one hash over the prefix and one memcmp,
+*   one more per space tried.
+* @return matching table entry, or NULL for lines with an unknown prefix
+******************************************************************************/
+const RIL_Prefix* RIL_classifyLine(const char* line, uint32_t len);
+
+#if RIL_FEATURE_NUMERIC_RESULT
+/*******************************************************************************
+* @brief Maps an ATV0 numeric result code ('0' OK, '4' ERROR, ...) to the entry
+*   of its verbose equivalent.
+* @return matching entry, or NULL if code is not a V.250 result code
+******************************************************************************/
+const RIL_Prefix* RIL_classifyNumeric(char code);
+#endif
+
+#endif //_RIL_PREFIX_H_
@@ -0,0 +1,63 @@
+/**
+ * @file ril_prefix_id.h
+ * @brief Generated by tools/ril_prefixgen.py from tools/ril_prefixes.txt, do not edit.
+ */
+
+#ifndef _RIL_PREFIX_ID_H_
+#define _RIL_PREFIX_ID_H_
+
+#define RIL_PREFIX_SEED     0x0002UL
+#define RIL_PREFIX_BUCKETS  23
+#define RIL_PREFIX_SPACES   2
+
+typedef enum {
+    RIL_PREFIX_OK,
+    RIL_PREFIX_CONNECT,
+    RIL_PREFIX_SEND_OK,
+    RIL_PREFIX_ERROR,
+    RIL_PREFIX_CME_ERROR,
+    RIL_PREFIX_CMS_ERROR,
+    RIL_PREFIX_NO_CARRIER,
+    RIL_PREFIX_BUSY,
+    RIL_PREFIX_NO_ANSWER,
+    RIL_PREFIX_NO_DIALTONE,
+    RIL_PREFIX_SEND_FAIL,
+    RIL_PREFIX_RING,
+    RIL_PREFIX_RDY,
+    RIL_PREFIX_CFUN,
+    RIL_PREFIX_CPIN,
+    RIL_PREFIX_CREG,
+    RIL_PREFIX_CGREG,
+    RIL_PREFIX_CEREG,
+    RIL_PREFIX_CMTI,
+    RIL_PREFIX_CMT,
+    RIL_PREFIX_CLIP,
+    RIL_PREFIX_CRING,
+    RIL_PREFIX_CUSD,
+    RIL_PREFIX_CTZV,
+    RIL_PREFIX_POWERED_DOWN,
+    RIL_PREFIX_NORMAL_POWER_DOWN,
+    RIL_PREFIX_QIURC,
+    RIL_PREFIX_QIOPEN,
+    RIL_PREFIX_QIND,
+    RIL_PREFIX_QSSLURC,
+    RIL_PREFIX_QSSLOPEN,
+    RIL_PREFIX_QMTRECV,
+    RIL_PREFIX_QMTSTAT,
+    RIL_PREFIX_QPSMTIMER,
+    RIL_PREFIX_CIPRXGET,
+    RIL_PREFIX_CIPOPEN,
+    RIL_PREFIX_IPCLOSE,
+    RIL_PREFIX_CIPEVENT,
+    RIL_PREFIX_SMS_READY,
+    RIL_PREFIX_CALL_READY,
+    RIL_PREFIX_UUSORD,
+    RIL_PREFIX_UUSORF,
+    RIL_PREFIX_UUSOCL,
+    RIL_PREFIX_UUPSDA,
+    RIL_PREFIX_UUPSDD,
+    RIL_PREFIX_COUNT,
+    RIL_PREFIX_NONE = RIL_PREFIX_COUNT,
+} RIL_PrefixId;
+
+#endif //_RIL_PREFIX_ID_H_
@@ -0,0 +1,37 @@
+/**
+ * @file ril_scan.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Byte scanning kernels used by the line reader and argument parser
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#ifndef _RIL_SCAN_H_
+#define _RIL_SCAN_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+* @brief Returns the index of the first byte in buff that equals a or b.
+*   Tests one machine word per step: SWAR on generic 32-bit targets,
+*   __UADD8/__SEL on Cortex-M4 DSP and SSE2/AVX2 on x86 hosts.
+*   Pass a == b to search for a single byte.
+* @return index of the match, or -1 if none of the len bytes matches
+******************************************************************************/
+int32_t RIL_scanBytes(const uint8_t* buff, uint32_t len, uint8_t a, uint8_t b);
+
+/*******************************************************************************
+* @brief Byte-at-a-time reference of RIL_scanBytes, kept for equivalence checks.
+* @return index of the match, or -1 if none of the len bytes matches
+******************************************************************************/
+int32_t RIL_scanBytesRef(const uint8_t* buff, uint32_t len, uint8_t a, uint8_t b);
+
+/* Line terminator: stops at '\r' or '\n', so numeric ("0\r") and verbose ("OK\r\n") lines both end */
+#define RIL_scanEOL(BUFF, LEN)      RIL_scanBytes((BUFF), (LEN), '\r', '\n')
+/* Argument delimiter: stops at the quote or the comma of a response parameter list */
+#define RIL_scanArgDelim(BUFF, LEN) RIL_scanBytes((BUFF), (LEN), '"', ',')
+
+#endif //_RIL_SCAN_H_
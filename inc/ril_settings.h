@@ -0,0 +1,56 @@
+/**
+ * @file ril_settings.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Modem settings applied once and verified on later boots
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * The application describes the configuration it wants as a table. The hash
+ * of every entry is stored through ril_store.h after the entries were applied
+ * and saved on the modem with RIL_SETTINGS_SAVE_CMD. On the next boot only
+ * entries that are new or changed are sent, the others are checked with one
+ * compound query (one query per entry without RIL_CAP_COMPOUND) and re-sent
+ * when the modem lost them.
+ *
+ *     static const RIL_Setting SETTINGS[] = {
+ *         { "AT+CREG=2",      "AT+CREG?",     "+CREG: 2," },
+ *         { "AT+QCFG=\"band\",0,80084,80084", NULL, NULL },
+ *     };
+ *     RIL_settings_apply(SETTINGS, 2, &report);
+ */
+
+#ifndef _RIL_SETTINGS_H_
+#define _RIL_SETTINGS_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_SETTINGS
+
+typedef struct {
+    const char*         Set;            /**< Command that applies the setting */
+    const char*         Query;          /**< Read command starting with "AT", NULL when the setting can not be read back */
+    const char*         Expect;         /**< Start of the line Query answers while the setting holds, NULL with Query */
+} RIL_Setting;
+
+typedef struct {
+    uint8_t             Applied;        /**< Entries sent */
+    uint8_t             Verified;       /**< Entries the query confirmed */
+    uint8_t             Queries;        /**< Query commands sent */
+    uint8_t             Saved;          /**< RIL_SETTINGS_SAVE_CMD was sent */
+} RIL_SettingsReport;
+
+/*******************************************************************************
+* @brief Brings the modem to the settings in table, sending only what is new,
+*   changed or lost. Entries are applied in table order.
+* @param count at most RIL_SETTINGS_MAX
+* @param report may be NULL
+* @return result of the first command that failed, the stored record is then
+*   left as it was so the next call retries
+******************************************************************************/
+RIL_ATSndError RIL_settings_apply(const RIL_Setting* table, uint8_t count, RIL_SettingsReport* report);
+
+#endif
+
+#endif //_RIL_SETTINGS_H_
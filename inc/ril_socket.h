@@ -0,0 +1,191 @@
+/**
+ * @file ril_socket.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief TCP/UDP sockets of the modem's embedded IP stack
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Every call returns at once. RIL_process runs the vendor command sequences
+ * (AT+QIOPEN, AT+QISEND, AT+QIRD, AT+QICLOSE or their SIMCom and u-blox
+ * equivalents) one at a time in the background:
+ *   - sent data waits in the TX ring of the socket and goes out with the
+ *     payload command straight from the ring, as raw bytes
+ *   - a receive URC starts reads into the RX ring until the modem has no
+ *     more data, or until the ring is full and the application reads. Up to
+ *     RIL_SOCKET_PREFETCH further reads wait in the command queue behind the
+ *     one in flight, so the next chunk is asked for the moment the previous
+ *     one arrived.
+ *   - the event callback reports opened, readable, writable and closed
+ *
+ * The *Span calls hand out the rings themselves, so data can be produced
+ * and consumed in place without a copy.
+ *
+ * Sockets opened with RIL_SOCKET_PUSH, on modems with RIL_VENDOR_RECV_PUSH,
+ * and RIL_CAP_PUSH_RECV once RIL_caps_discover ran, skip the read commands: the parser moves the data that follows the receive
+ * URC straight from the UART stream into the RX ring. There is no flow
+ * control in this mode, data that does not fit the ring is dropped and
+ * counted, size RIL_SOCKET_RX_SIZE for the largest burst.
+ *
+ * Quectel modems echo sent data unless AT+QISDE=0, turn it off before use.
+ */
+
+#ifndef _RIL_SOCKET_H_
+#define _RIL_SOCKET_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_SOCKET
+
+#if !RIL_FEATURE_VENDOR || !RIL_FEATURE_PAYLOAD
+    #error "RIL_FEATURE_SOCKET needs RIL_FEATURE_VENDOR and RIL_FEATURE_PAYLOAD"
+#endif
+
+#include "ril_vendor.h"
+#include <stdbool.h>
+
+/* RIL_socket_events and Callback_SocketEvent flags */
+#define RIL_SOCKET_READABLE         0x01    /**< Data waits in the RX ring */
+#define RIL_SOCKET_WRITABLE         0x02    /**< Open with room in the TX ring */
+#define RIL_SOCKET_HUP              0x04    /**< Closed by the remote or the network, the RX ring can still be read */
+#define RIL_SOCKET_ERROR            0x08    /**< Open failed */
+
+/* RIL_socket_open type flag, direct push receive where the profile supports it */
+#define RIL_SOCKET_PUSH             0x80
+
+typedef enum {
+    RIL_SOCKET_FREE         = 0,
+    RIL_SOCKET_OPENING      = 1,
+    RIL_SOCKET_OPEN         = 2,
+    RIL_SOCKET_REMOTE_CLOSED = 3,   /**< The peer or the network ended it, RIL_socket_close frees it */
+    RIL_SOCKET_FAILED       = 4,    /**< Open failed, RIL_socket_close frees it */
+    RIL_SOCKET_CLOSING      = 5,    /**< RIL_socket_close waits for the TX ring and the close command */
+} RIL_SocketState;
+
+/*******************************************************************************
+* Socket event callback, events are RIL_SOCKET_* flags that just became true.
+* Runs inside RIL_process, it may call the non-blocking socket functions.
+******************************************************************************/
+typedef void (*Callback_SocketEvent)(uint8_t sock, uint8_t events, void* userData);
+
+typedef struct {
+    uint32_t            Sent;           /**< Bytes the modem accepted */
+    uint32_t            Received;       /**< Bytes read into the RX ring */
+    uint32_t            SendCommands;
+    uint32_t            ReadCommands;
+    uint32_t            SendRetries;    /**< Sends the modem refused, tried again after RIL_SOCKET_RETRY_MS */
+    uint32_t            Prefetches;     /**< Reads queued behind the read in flight */
+    uint32_t            Dropped;        /**< Pushed bytes that did not fit the RX ring */
+} RIL_SocketStats;
+
+/*******************************************************************************
+* @brief Registers the URC handler and picks the vendor profile with
+*   RIL_vendor_probe when none is selected. Call it after RIL_initialize,
+*   it sends commands only for the probe.
+* @param context PDP context, or u-blox PSD profile, the sockets use
+******************************************************************************/
+RIL_ATSndError RIL_socket_init(uint8_t context);
+
+/*******************************************************************************
+* @brief Activates the PDP context with the attach sequence of the vendor,
+*   blocking. Skip it when the application attaches on its own.
+******************************************************************************/
+RIL_ATSndError RIL_socket_attach(void);
+
+/*******************************************************************************
+* @brief Starts opening a socket, fn gets RIL_SOCKET_WRITABLE once it is
+*   open or RIL_SOCKET_ERROR when it failed. host is copied.
+* @param type RIL_SOCKET_TCP, RIL_SOCKET_UDP, optionally | RIL_SOCKET_PUSH
+* @return socket number, RIL_AT_BUSY when all RIL_SOCKET_COUNT are in use,
+*   RIL_AT_INVALID_PARAM when host does not fit RIL_SOCKET_HOST_LEN,
+*   RIL_AT_FAILED when the discovered capabilities lack RIL_CAP_BINARY_SEND,
+*   or RIL_CAP_BUFFERED_RECV on a socket that does not push
+******************************************************************************/
+int32_t RIL_socket_open(uint8_t type, const char* host, uint16_t port, Callback_SocketEvent fn, void* userData);
+
+/*******************************************************************************
+* @brief Closes the socket once its TX ring went out, data still in the RX
+*   ring is dropped. The socket number is free again when the state is
+*   RIL_SOCKET_FREE, no event is reported.
+******************************************************************************/
+RIL_ATSndError RIL_socket_close(uint8_t sock);
+
+/*******************************************************************************
+* @brief Copies data into the TX ring
+* @return bytes taken, less than len when the ring is full,
+*   RIL_AT_FAILED when the socket is not open
+******************************************************************************/
+int32_t RIL_socket_send(uint8_t sock, const void* data, uint32_t len);
+
+/*******************************************************************************
+* @brief Copies data out of the RX ring
+* @return bytes copied, 0 when the ring is empty, RIL_AT_FAILED when the
+*   ring is empty and the socket will not receive anymore
+******************************************************************************/
+int32_t RIL_socket_recv(uint8_t sock, void* buff, uint32_t len);
+
+/*******************************************************************************
+* @brief Contiguous free part of the TX ring, write into it and commit
+* @return length of the span, 0 when the ring is full or the socket not open
+******************************************************************************/
+uint32_t RIL_socket_sendSpan(uint8_t sock, uint8_t** data);
+void RIL_socket_sendCommit(uint8_t sock, uint32_t len);
+
+/*******************************************************************************
+* @brief Contiguous filled part of the RX ring, read it and consume
+* @return length of the span, 0 when the ring is empty
+******************************************************************************/
+uint32_t RIL_socket_recvSpan(uint8_t sock, const uint8_t** data);
+void RIL_socket_recvConsume(uint8_t sock, uint32_t len);
+
+/*******************************************************************************
+* @brief RIL_SOCKET_* flags that are true now, for polling
+******************************************************************************/
+uint8_t RIL_socket_events(uint8_t sock);
+
+RIL_SocketState RIL_socket_state(uint8_t sock);
+
+/*******************************************************************************
+* @brief Host, port and type the socket was opened with, NULL when it is free
+******************************************************************************/
+const RIL_VendorSocket* RIL_socket_peer(uint8_t sock);
+
+/*******************************************************************************
+* @brief Replaces the event callback, e.g. when the socket changes owner
+******************************************************************************/
+void RIL_socket_bind(uint8_t sock, Callback_SocketEvent fn, void* userData);
+
+/*******************************************************************************
+* @brief Bytes waiting in the TX ring or on their way to the modem
+******************************************************************************/
+uint32_t RIL_socket_unsent(uint8_t sock);
+
+/*******************************************************************************
+* @brief Starts the next socket command when the previous one is done,
+*   called from RIL_process
+******************************************************************************/
+void RIL_socket_process(void);
+
+const RIL_SocketStats* RIL_socket_stats(void);
+
+#if RIL_FEATURE_SESSION
+/*******************************************************************************
+* @brief Writes the open sockets for RIL_suspend: number, state, peer and
+*   mode. Ring contents and event callbacks are not part of it.
+* @return bytes written, -1 while a socket is opening or closing, has data
+*   in its rings or a command in flight, or when they do not fit
+******************************************************************************/
+int32_t RIL_socket_suspend(uint8_t* out, uint32_t size);
+
+/*******************************************************************************
+* @brief Restores the sockets of RIL_socket_suspend output. Sockets in buffer
+*   mode read once, for data whose receive URC arrived during sleep, pushed
+*   data of that time is lost. Bind the callbacks again with RIL_socket_bind.
+******************************************************************************/
+void RIL_socket_resume(const uint8_t* data, uint32_t len);
+#endif
+
+#endif
+
+#endif //_RIL_SOCKET_H_
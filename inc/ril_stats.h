@@ -0,0 +1,80 @@
+/**
+ * @file ril_stats.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Buffer high-water-mark tracking and size recommendations
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * The functions here only do arithmetic on the samples they are given,
+ * so they run the same on target and when replaying a captured trace.
+ */
+
+#ifndef _RIL_STATS_H_
+#define _RIL_STATS_H_
+
+#include <stdint.h>
+#include "ril_config.h"
+
+/* Usage at or above Size - Size / RIL_STATS_NEAR_OVERRUN_DIV counts as a near overrun */
+#ifndef RIL_STATS_NEAR_OVERRUN_DIV
+    #define RIL_STATS_NEAR_OVERRUN_DIV  16
+#endif
+/* Called with every sample RIL takes, define it to log a trace for tools/ril_replay.c,
+   e.g. printf("%lu %u %lu\n", NOW, ID, USED) */
+#ifndef RIL_STATS_TRACE
+    #define RIL_STATS_TRACE(ID, USED, NOW)
+#endif
+/* Recommended sizes are rounded up to this granularity */
+#ifndef RIL_STATS_SIZE_ALIGN
+    #define RIL_STATS_SIZE_ALIGN        16
+#endif
+
+typedef struct {
+    uint32_t            Size;           /**< Capacity of the tracked buffer */
+    uint32_t            HighWater;      /**< Largest usage seen */
+    uint32_t            NearOverrun;    /**< Samples close to or at full */
+    uint32_t            TimeAbove75;    /**< Time spent above 75% full, in ticks (ms) */
+    uint32_t            AboveSince;     /**< Tick TimeAbove75 counts from, valid while Above75 */
+    uint32_t            Samples;        /**< Number of samples taken */
+    uint8_t             Above75;
+} RIL_BufferStats;
+
+typedef enum {
+    RIL_BUFFER_RX       = 0,    /**< streamRxBuff, RIL_RX_STREAM_SIZE */
+    RIL_BUFFER_TX       = 1,    /**< streamTxBuff, RIL_TX_STREAM_SIZE */
+    RIL_BUFFER_LINE     = 2,    /**< line buffer, RIL_LINE_LEN */
+    RIL_BUFFER_COUNT,
+} RIL_BufferId;
+
+/*******************************************************************************
+* @brief Clears the statistics of a buffer with the given capacity.
+******************************************************************************/
+void RIL_bufferStats_init(RIL_BufferStats* stats, uint32_t size);
+
+/*******************************************************************************
+* @brief Records the current usage of a buffer, now is the current tick in ms.
+*   A usage above Size (a cut line, a dropped byte) counts as a near overrun,
+*   the high-water mark stops at Size.
+******************************************************************************/
+void RIL_bufferStats_sample(RIL_BufferStats* stats, uint32_t used, uint32_t now);
+
+/*******************************************************************************
+* @brief Periodic check of a buffer between its events, RIL_process calls it
+*   on every pass. It moves the time above 75% and the high-water mark, but
+*   takes no sample, so a buffer that stays full between events is timed
+*   without inflating Samples and NearOverrun.
+******************************************************************************/
+void RIL_bufferStats_tick(RIL_BufferStats* stats, uint32_t used, uint32_t now);
+
+/*******************************************************************************
+* @brief Recommends a capacity from the collected samples: the high-water mark
+*   plus 25% headroom, rounded to RIL_STATS_SIZE_ALIGN. A buffer that came
+*   near to overrun gets at least twice its current size, since its real peak
+*   is hidden by the clipping.
+* @return recommended size in bytes, 0 if no samples were taken
+******************************************************************************/
+uint32_t RIL_bufferStats_recommend(const RIL_BufferStats* stats);
+
+#endif //_RIL_STATS_H_
@@ -0,0 +1,68 @@
+/**
+ * @file ril_store.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Persistent storage hook for state RIL keeps across boots
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * RIL stores a few small records (capability flags, configuration fingerprint)
+ * through a hook the application provides: flash, EEPROM, backup registers.
+ * Every record carries its own check value, the hook only moves bytes.
+ * On Linux and macOS RIL_store_file keeps each record in a file.
+ */
+
+#ifndef _RIL_STORE_H_
+#define _RIL_STORE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ril_config.h"
+
+typedef enum {
+    RIL_STORE_CAPS      = 0,    /**< RIL_Caps, ril_caps.h */
+    RIL_STORE_CONFIG    = 1,    /**< Configuration fingerprint */
+    RIL_STORE_KEYS,
+} RIL_StoreKey;
+
+typedef struct {
+    /* true when exactly len bytes of key were read into data */
+    bool (*load)(RIL_StoreKey key, void* data, uint32_t len, void* args);
+    bool (*save)(RIL_StoreKey key, const void* data, uint32_t len, void* args);
+    void*               Args;
+} RIL_Store;
+
+/*******************************************************************************
+* @brief Sets the storage hook, NULL disables persistence.
+*   store must outlive its use, nothing is copied.
+******************************************************************************/
+void RIL_store_set(const RIL_Store* store);
+
+/*******************************************************************************
+* @brief Reads a record through the hook
+* @return false without a hook, or when the hook has no such record
+******************************************************************************/
+bool RIL_store_load(RIL_StoreKey key, void* data, uint32_t len);
+
+/*******************************************************************************
+* @brief Writes a record through the hook
+* @return false without a hook, or when the hook failed
+******************************************************************************/
+bool RIL_store_save(RIL_StoreKey key, const void* data, uint32_t len);
+
+/*******************************************************************************
+* @brief FNV-1a over len bytes, chained through hash. Start with RIL_HASH_INIT.
+******************************************************************************/
+uint32_t RIL_hash(uint32_t hash, const void* data, uint32_t len);
+
+#define RIL_HASH_INIT                   0x811C9DC5UL
+
+#if defined(__unix__) || defined(__APPLE__)
+/*******************************************************************************
+* @brief Hook that keeps each record in <dir>/ril_<key>.bin, dir must outlive it
+******************************************************************************/
+RIL_Store RIL_store_file(const char* dir);
+#endif
+
+#endif //_RIL_STORE_H_
@@ -0,0 +1,153 @@
+/**
+ * @file ril_transport.hpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Transports and clocks for BasicRil
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * StreamTransport  UARTStream of the firmware (DMA driven IStream/OStream),
+ *                  the UART callbacks still have to call IStream_handle/OStream_handle
+ * PosixTransport   non-blocking file descriptor, e.g. a pty on a Linux host
+ * HalClock         HAL_GetTick
+ * SteadyClock      std::chrono::steady_clock
+ */
+
+#ifndef _RIL_TRANSPORT_HPP_
+#define _RIL_TRANSPORT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+#include "ril_config.h"
+#include "UARTStream.h"
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <cerrno>
+    #include <chrono>
+    #include <fcntl.h>
+    #include <termios.h>
+    #include <unistd.h>
+    #define _RIL_TRANSPORT_POSIX    1
+#endif
+
+namespace ril {
+
+/**
+ * Reads straight out of the IStream ring, no copy
+ */
+class StreamTransport {
+public:
+    explicit StreamTransport(UARTStream& stream) noexcept : stream_(stream) {}
+
+    uint32_t readable() {
+        return static_cast<uint32_t>(IStream_directAvailable(&stream_.Input));
+    }
+
+    const uint8_t* readPtr() {
+        return IStream_getReadPtr(&stream_.Input);
+    }
+
+    void consume(uint32_t len) {
+        IStream_moveReadPos(&stream_.Input, static_cast<Stream_LenType>(len));
+    }
+
+    bool write(const uint8_t* data, uint32_t len) {
+        if (OStream_writeBytes(&stream_.Output, const_cast<uint8_t*>(data), static_cast<Stream_LenType>(len)) != Stream_Ok) {
+            return false;
+        }
+        OStream_flush(&stream_.Output);
+        return true;
+    }
+
+private:
+    UARTStream&     stream_;
+};
+
+struct HalClock {
+    static uint32_t now() {
+        return HAL_GetTick();
+    }
+};
+
+#if _RIL_TRANSPORT_POSIX
+/**
+ * Non-blocking fd with a linear receive buffer of RxSize bytes
+ */
+template <std::size_t RxSize = RIL_RX_STREAM_SIZE>
+class PosixTransport {
+public:
+    explicit PosixTransport(int fd) noexcept : fd_(fd) {}
+
+    /**
+     * Opens a tty or pty in raw, non-blocking mode
+     * @return fd, or -1 on failure
+     */
+    static int open(const char* path) {
+        int fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+        struct termios tio;
+        if (fd >= 0 && tcgetattr(fd, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(fd, TCSANOW, &tio);
+        }
+        return fd;
+    }
+
+    uint32_t readable() {
+        if (head_ == len_) {
+            ssize_t got = ::read(fd_, buff_, RxSize);
+            head_ = 0;
+            len_ = got > 0 ? static_cast<uint32_t>(got) : 0;
+        }
+        return len_ - head_;
+    }
+
+    const uint8_t* readPtr() const {
+        return &buff_[head_];
+    }
+
+    void consume(uint32_t len) {
+        head_ += len;
+    }
+
+    bool write(const uint8_t* data, uint32_t len) {
+        while (len > 0) {
+            ssize_t sent = ::write(fd_, data, len);
+            if (sent < 0) {
+                // The fd is non-blocking, a full pty buffer only means wait
+                if (errno == EAGAIN || errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            data += sent;
+            len -= static_cast<uint32_t>(sent);
+        }
+        return true;
+    }
+
+    int fd() const {
+        return fd_;
+    }
+
+private:
+    int             fd_;
+    uint32_t        head_ = 0;
+    uint32_t        len_ = 0;
+    uint8_t         buff_[RxSize];
+};
+
+struct SteadyClock {
+    static uint32_t now() {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+};
+#endif
+
+} // namespace ril
+
+#endif //_RIL_TRANSPORT_HPP_
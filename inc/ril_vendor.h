@@ -0,0 +1,192 @@
+/**
+ * @file ril_vendor.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Vendor profiles: socket and file commands of Quectel, SIMCom and u-blox
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * A profile maps the high-level operations (attach, open, send, read, close,
+ * file upload) to the command sequence of one vendor and decodes its socket
+ * URCs into RIL_VendorEvent. Profiles only build and decode, the caller runs
+ * the commands with RIL_SendATCmd or RIL_SendATCmdAsync.
+ *
+ * Data paths, the fastest each vendor offers over the AT port:
+ *   Quectel   AT+QISEND=<id>,<len> raw after '>', AT+QIRD=<id>,<len> raw after "+QIRD: <n>"
+ *   SIMCom    AT+CIPSEND=<id>,<len> raw after '>', AT+CIPRXGET=2,<id>,<len> manual read,
+ *             raw after "+CIPRXGET: 2,<id>,<n>,<rest>"
+ *   u-blox    AT+USOWR=<s>,<len> binary after '@', AT+USORD=<s>,<len> raw between the
+ *             quotes of "+USORD: <s>,<n>,"
+ *
+ * Quectel can also push received data without a read command, raw after
+ * +QIURC: "recv",<id>,<len> (access mode 1, RIL_VENDOR_RECV_PUSH).
+ *
+ * With RIL_VENDOR set to one vendor the RIL_vendor_* macros call its functions
+ * directly, there is no profile lookup and no indirect call.
+ */
+
+#ifndef _RIL_VENDOR_H_
+#define _RIL_VENDOR_H_
+
+#include "ril.h"
+
+#if RIL_FEATURE_VENDOR
+
+#include <stdbool.h>
+
+/* RIL_VendorSocket.Type */
+#define RIL_SOCKET_TCP              0
+#define RIL_SOCKET_UDP              1
+
+/* RIL_VendorProfile.Flags */
+#define RIL_VENDOR_OPEN_URC         0x01    /**< Open result arrives as a URC after OK */
+#define RIL_VENDOR_READ_INLINE      0x02    /**< Read data follows the header on the same line, inside quotes */
+#define RIL_VENDOR_RECV_PUSH        0x04    /**< Sockets opened with Push get their data behind the receive URC */
+
+/* Modem socket number of events that are not about one socket */
+#define RIL_VENDOR_NO_SOCKET        0xFF
+
+typedef uint8_t RIL_VendorId;
+
+typedef enum {
+    RIL_VENDOR_EVENT_NONE       = 0,
+    RIL_VENDOR_EVENT_OPENED     = 1,    /**< Value is 0 or the vendor error code */
+    RIL_VENDOR_EVENT_RECV       = 2,    /**< Value is the pending length, or the pushed length on a Push socket, -1 when the URC does not tell */
+    RIL_VENDOR_EVENT_CLOSED     = 3,    /**< Closed by the remote or the network */
+    RIL_VENDOR_EVENT_DETACHED   = 4,    /**< PDP context lost, every socket is gone */
+} RIL_VendorEventType;
+
+typedef struct {
+    uint8_t             Type;           /**< RIL_VendorEventType */
+    uint8_t             Socket;         /**< Modem socket number, RIL_VENDOR_NO_SOCKET for DETACHED */
+    int32_t             Value;
+} RIL_VendorEvent;
+
+/**
+ * One socket as the profile sees it
+ */
+typedef struct {
+    const char*         Host;
+    uint16_t            Port;
+    uint8_t             Type;           /**< RIL_SOCKET_TCP, RIL_SOCKET_UDP */
+    uint8_t             Context;        /**< PDP context or PSD profile */
+    uint8_t             Id;             /**< Number the application chose */
+    uint8_t             ModemId;        /**< Number the modem uses, u-blox assigns it in the open sequence */
+    bool                Push;           /**< Direct push receive, only with RIL_VENDOR_RECV_PUSH */
+} RIL_VendorSocket;
+
+/**
+ * Command builders write the command without CRLF into buff and return its
+ * length, 0 when it does not fit or the sequence has no such step
+ */
+typedef struct {
+    const char*         Name;
+    const char*         Manufacturer;   /**< Matched in the AT+CGMI or ATI response, case-insensitive */
+    const char*         ReadPrefix;     /**< Header line of read data */
+    const char*         UploadPrompt;   /**< Line after which the file data is written, NULL for a '>' prompt */
+    RIL_VendorId        Id;
+    char                SendPrompt;     /**< Character after which the send data is written */
+    uint8_t             Flags;
+    uint8_t             AttachSteps;
+    uint8_t             OpenSteps;
+    uint16_t            MaxSend;        /**< Largest payload of one send command */
+    uint16_t            MaxRead;        /**< Largest payload of one read command */
+
+    uint32_t (*buildAttach)(char* buff, uint32_t size, uint8_t step, uint8_t context);
+    uint32_t (*buildOpen)(char* buff, uint32_t size, uint8_t step, const RIL_VendorSocket* sock);
+    /* Takes the response lines of an open step, u-blox learns ModemId here */
+    void     (*parseOpen)(uint8_t step, const char* line, uint32_t len, RIL_VendorSocket* sock);
+    uint32_t (*buildSend)(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len);
+    uint32_t (*buildRead)(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len);
+    /* Length of the data after a read header line, -1 when line is not one */
+    int32_t  (*parseRead)(const char* line, uint32_t len);
+    uint32_t (*buildClose)(char* buff, uint32_t size, const RIL_VendorSocket* sock);
+    uint32_t (*buildUpload)(char* buff, uint32_t size, const char* name, uint32_t len);
+    /* Decodes a socket URC, false when the line is none of them */
+    bool     (*parseUrc)(const char* line, uint32_t len, RIL_PrefixId id, RIL_VendorEvent* event);
+} RIL_VendorProfile;
+
+#define RIL_VENDOR_PROFILE_FUNCTIONS(P) \
+    uint32_t P##_buildAttach(char* buff, uint32_t size, uint8_t step, uint8_t context); \
+    uint32_t P##_buildOpen(char* buff, uint32_t size, uint8_t step, const RIL_VendorSocket* sock); \
+    void     P##_parseOpen(uint8_t step, const char* line, uint32_t len, RIL_VendorSocket* sock); \
+    uint32_t P##_buildSend(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len); \
+    uint32_t P##_buildRead(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len); \
+    int32_t  P##_parseRead(const char* line, uint32_t len); \
+    uint32_t P##_buildClose(char* buff, uint32_t size, const RIL_VendorSocket* sock); \
+    uint32_t P##_buildUpload(char* buff, uint32_t size, const char* name, uint32_t len); \
+    bool     P##_parseUrc(const char* line, uint32_t len, RIL_PrefixId id, RIL_VendorEvent* event)
+
+#if RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_QUECTEL
+    extern const RIL_VendorProfile RIL_VENDOR_QUECTEL_PROFILE;
+    RIL_VENDOR_PROFILE_FUNCTIONS(RIL_quectel);
+#endif
+#if RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_SIMCOM
+    extern const RIL_VendorProfile RIL_VENDOR_SIMCOM_PROFILE;
+    RIL_VENDOR_PROFILE_FUNCTIONS(RIL_simcom);
+#endif
+#if RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_UBLOX
+    extern const RIL_VendorProfile RIL_VENDOR_UBLOX_PROFILE;
+    RIL_VENDOR_PROFILE_FUNCTIONS(RIL_ublox);
+#endif
+
+#if RIL_VENDOR == RIL_VENDOR_AUTO
+    /*******************************************************************************
+    * @brief Active profile, NULL until RIL_vendor_probe or RIL_vendor_set chose one
+    ******************************************************************************/
+    const RIL_VendorProfile* RIL_vendor(void);
+    #define RIL_VENDOR_CALL(FN)         RIL_vendor()->FN
+#elif RIL_VENDOR == RIL_VENDOR_QUECTEL
+    #define RIL_vendor()                (&RIL_VENDOR_QUECTEL_PROFILE)
+    #define RIL_VENDOR_CALL(FN)         RIL_quectel_##FN
+#elif RIL_VENDOR == RIL_VENDOR_SIMCOM
+    #define RIL_vendor()                (&RIL_VENDOR_SIMCOM_PROFILE)
+    #define RIL_VENDOR_CALL(FN)         RIL_simcom_##FN
+#elif RIL_VENDOR == RIL_VENDOR_UBLOX
+    #define RIL_vendor()                (&RIL_VENDOR_UBLOX_PROFILE)
+    #define RIL_VENDOR_CALL(FN)         RIL_ublox_##FN
+#else
+    #error "RIL_VENDOR must be RIL_VENDOR_AUTO, RIL_VENDOR_QUECTEL, RIL_VENDOR_SIMCOM or RIL_VENDOR_UBLOX"
+#endif
+
+/* Operations of the active profile */
+#define RIL_vendor_buildAttach          RIL_VENDOR_CALL(buildAttach)
+#define RIL_vendor_buildOpen            RIL_VENDOR_CALL(buildOpen)
+#define RIL_vendor_parseOpen            RIL_VENDOR_CALL(parseOpen)
+#define RIL_vendor_buildSend            RIL_VENDOR_CALL(buildSend)
+#define RIL_vendor_buildRead            RIL_VENDOR_CALL(buildRead)
+#define RIL_vendor_parseRead            RIL_VENDOR_CALL(parseRead)
+#define RIL_vendor_buildClose           RIL_VENDOR_CALL(buildClose)
+#define RIL_vendor_buildUpload          RIL_VENDOR_CALL(buildUpload)
+#define RIL_vendor_parseUrc             RIL_VENDOR_CALL(parseUrc)
+
+/*******************************************************************************
+* @brief Picks the profile of the attached modem from AT+CGMI, then from ATI
+*   when CGMI does not name a known vendor. With a fixed RIL_VENDOR it sends
+*   nothing and succeeds.
+* @return RIL_AT_FAILED when no profile matches, the active one is kept
+******************************************************************************/
+RIL_ATSndError RIL_vendor_probe(void);
+
+/*******************************************************************************
+* @brief Finds the profile whose manufacturer appears in text
+* @return NULL when none matches, or when it is not linked in
+******************************************************************************/
+const RIL_VendorProfile* RIL_vendor_match(const char* text, uint32_t len);
+
+/*******************************************************************************
+* @brief Profile with the RIL_VENDOR_* id, NULL when it is not linked in
+******************************************************************************/
+const RIL_VendorProfile* RIL_vendor_byId(RIL_VendorId id);
+
+#if RIL_VENDOR == RIL_VENDOR_AUTO
+/*******************************************************************************
+* @brief Selects a profile without probing, NULL clears the selection
+******************************************************************************/
+void RIL_vendor_set(const RIL_VendorProfile* profile);
+#endif
+
+#endif
+
+#endif //_RIL_VENDOR_H_
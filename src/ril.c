@@ -10,45 +10,228 @@
  */
 
 #include "ril.h"
+#include "ril_scan.h"
+#include "ril_prefix.h"
+#include "ril_line.h"
+#include "ril_stats.h"
+#include "ril_pool.h"
+#if RIL_FEATURE_CAPS
+    #include "ril_caps.h"
+#endif
+#if RIL_FEATURE_BATCH
+    #include "ril_batch.h"
+#endif
+#if RIL_FEATURE_POWER
+    #include "ril_power.h"
+#endif
+#if RIL_FEATURE_SOCKET
+    #include "ril_socket.h"
+#endif
+#if RIL_FEATURE_CONN
+    #include "ril_conn.h"
+#endif
+#if RIL_FEATURE_COMMANDS
+    // RIL_RAM_COMMANDS of the budget check is sized from the generated types
+    #include "ril_cmd.h"
+#endif
+#if RIL_FEATURE_SESSION
+    #include "ril_store.h"
+    #if RIL_FEATURE_VENDOR
+        #include "ril_vendor.h"
+    #endif
+#endif
 #include "UARTStream.h"
-#include "Str.h"
 #include <stdbool.h>
-#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* RIL_Command.State */
+#define _RIL_CMD_QUEUED     0
+#define _RIL_CMD_ACTIVE     1
+#define _RIL_CMD_DONE       2
+/* RIL_Command.Flags */
+#define _RIL_CMD_POOLED     0x01
+#define _RIL_CMD_HELD       0x02    /**< Waiting for TX space, cmdDeadline runs */
+
+#if RIL_FEATURE_SESSION
+/* RIL_suspend blob: check, version, total length, then sections of tag, length and data */
+#define _RIL_SESSION_VERSION    1
+#define _RIL_SESSION_HEADER     8
+#define _RIL_SESSION_SECTION    4
+#define _RIL_SESSION_CORE       1
+#define _RIL_SESSION_CAPS       2
+#define _RIL_SESSION_VENDOR     3
+#define _RIL_SESSION_CACHE      4
+#define _RIL_SESSION_SOCKET     5
+#define _RIL_SESSION_CORE_LEN   4
+#endif
 
-#define RIL_INIT_RETRY  10
-#define RIL_LINE_LEN    64
 #define _RIL_ERROR_SET(TYPE, ERRCODE)   \
     error.type = TYPE; \
     error.atError = ERRCODE; 
 
 static const char CRLF[] = "\r\n";
-static const uint8_t CRLFLen = sizeof(CRLF) -1;
+
+/**
+ * Queued AT command, from cmdPool for RIL_SendATCmdAsync or on the caller's stack for RIL_SendATCmd
+ */
+typedef struct RIL_Command {
+    struct RIL_Command*     Next;
+    Callback_ATResponse     Callback;
+    Callback_ATDone         Done;
+    void*                   UserData;
+    const char*             Cmd;        /**< Without CRLF, _startCommand appends it on the wire */
+    uint32_t                TimeOut;
+    RIL_ATSndError          Result;
+    uint16_t                CmdLen;
+    uint8_t                 State;
+    uint8_t                 Flags;
+#if RIL_FEATURE_PAYLOAD
+    char                    Prompt;
+    const uint8_t*          Payload;
+    uint32_t                PayloadLen;
+    const char*             Inline;
+#endif
+} RIL_Command;
+
+/**
+ * Pooled command keeps its own copy of the text, a blocking one points at the caller's
+ */
+typedef struct {
+    RIL_Command             Base;
+    char                    Buff[RIL_CMD_LEN];
+} RIL_PooledCommand;
+
+/**
+ * URC line waiting in the queue for _dispatchURC
+ */
+typedef struct RIL_URCEvent {
+    struct RIL_URCEvent*    Next;
+    uint16_t                Len;
+    uint8_t                 Id;         /**< RIL_PrefixId */
+    char                    Line[RIL_URC_LINE_LEN];
+} RIL_URCEvent;
+
+typedef struct {
+    Callback_URC            Fn;
+    void*                   UserData;
+} RIL_URCHandler;
+
+RIL_STATIC_ASSERT(RIL_RAM_USAGE <= RIL_RAM_BUDGET, "RIL exceeds RIL_RAM_BUDGET, shrink buffers or disable features");
+RIL_STATIC_ASSERT(RIL_LINE_LEN >= 16, "RIL_LINE_LEN too small for result codes");
+RIL_STATIC_ASSERT(RIL_RX_STREAM_SIZE >= RIL_LINE_LEN, "RX stream must hold at least one line");
 
 static UARTStream stream;
 static uint8_t streamRxBuff[RIL_RX_STREAM_SIZE];
 static uint8_t streamTxBuff[RIL_TX_STREAM_SIZE];
+static char lineBuff[RIL_LINE_LEN];
+static uint32_t lineLen = 0;
+#if RIL_FEATURE_BUFFER_STATS
+static RIL_BufferStats bufferStats[RIL_BUFFER_COUNT];
+/* Bytes of the current line were dropped at RIL_LINE_LEN */
+static bool lineCut = false;
+#endif
 static bool rilInitialized = false;
+static uint8_t processDepth = 0;
+
+static RIL_Pool cmdPool;
+RIL_POOL_STORAGE(cmdPoolStorage, RIL_PooledCommand, RIL_CMD_POOL_SIZE);
+/* Commands in order, the head is on the wire while cmdActive */
+static RIL_Command* cmdHead = NULL;
+static RIL_Command* cmdTail = NULL;
+static bool cmdActive = false;
+static uint32_t cmdDeadline;
+
+static RIL_Pool urcPool;
+RIL_POOL_STORAGE(urcPoolStorage, RIL_URCEvent, RIL_URC_POOL_SIZE);
+static RIL_URCEvent* urcHead = NULL;
+static RIL_URCEvent* urcTail = NULL;
+static RIL_URCHandler urcHandlers[RIL_URC_HANDLERS];
+#if RIL_FEATURE_NUMERIC_RESULT
+static RIL_ResultFormat resultFormat = RIL_RESULT_VERBOSE;
+/* Formats the parser accepts, both until the modem confirmed ATV<n> */
+static uint8_t acceptedFormats = RIL_RESULT_FORMAT_ANY;
+#endif
+#if RIL_FEATURE_ECHO
+static RIL_EchoMode echoMode = RIL_ECHO_KEEP;
+/* Whether the last command came back echoed */
+static bool echoSeen = false;
+/* The active command may still be echoed */
+static bool echoPending = false;
+#endif
+#if RIL_FEATURE_PAYLOAD
+/* Payload of the active command still to be written, waiting for its prompt while promptPending */
+static const uint8_t* txPayload;
+static uint32_t txPayloadLeft = 0;
+static bool promptPending = false;
+/* Raw bytes after a response line that go to rxSink instead of the line parser */
+static uint32_t rxPayloadLeft = 0;
+static Callback_ATData rxSink;
+static void* rxSinkArgs;
+/* rxSink was armed by the active command, not by urcDataHandler for pushed data */
+static bool rxSinkCommand = false;
+/* urcDataHandler is running */
+static bool urcDataRunning = false;
+/* The active command may send its Inline header line */
+static bool inlinePending = false;
+/* Dropped when it is the next byte: the LF of a CRLF header, the space after a prompt, a closing quote */
+static char skipByte = 0;
+/* Terminator of the last line, '"' for a line cut at an Inline quote */
+static char lineEnd;
+/* Sees URC lines while they are parsed, so it can take the data pushed behind them */
+static Callback_URC urcDataHandler = NULL;
+static void* urcDataArgs;
+#endif
 static RIL_Error error = {
     .type = RIL_ERROR_AT,
     .atError = RIL_AT_UNINITIALIZED,
 };
 
-static int16_t _lineIsError(const char* line, uint32_t len, uint16_t* errCode);
+RIL_STATIC_ASSERT(sizeof(RIL_Command) <= RIL_RAM_COMMAND, "RIL_RAM_COMMAND under-counts RIL_Command");
+RIL_STATIC_ASSERT(sizeof(stream) + sizeof(streamRxBuff) + sizeof(streamTxBuff) + sizeof(lineBuff) + sizeof(cmdPool) +
+                  sizeof(urcPool) + sizeof(error) + 4 * sizeof(void*) + sizeof(RIL_Command) + 16 <= RIL_RAM_CORE,
+                  "RIL_RAM_CORE under-counts the engine state");
+RIL_STATIC_ASSERT(sizeof(cmdPoolStorage) + sizeof(urcPoolStorage) + sizeof(urcHandlers) <= RIL_RAM_POOLS,
+                  "RIL_RAM_POOLS under-counts the pools");
+#if RIL_FEATURE_BUFFER_STATS
+RIL_STATIC_ASSERT(sizeof(bufferStats) <= RIL_RAM_STATS, "RIL_RAM_STATS under-counts the buffer statistics");
+#endif
+
+static int32_t _readLine(void);
+/**
+ * @brief fills the descriptor, the command text is referenced, not copied
+ */
+static RIL_ATSndError _prepareCommand(RIL_Command* cmd, const char* atCmd, uint32_t atCmdLen,
+                                      Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut);
+static void _start(UART_HandleTypeDef* uart);
+static RIL_ATSndError _allocCommand(RIL_Command** out, const char* atCmd, uint32_t atCmdLen,
+                                    Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut);
+static void _queueCommand(RIL_Command* cmd);
+static void _startCommand(void);
+static void _finishCommand(RIL_ATSndError result);
+static void _handleLine(int32_t len);
+static void _queueURC(const RIL_Prefix* prefix, int32_t len);
+static void _dispatchURC(void);
+#if RIL_FEATURE_BUFFER_STATS
+static void _sampleBuffer(RIL_BufferId id, uint32_t used);
+static void _tickBuffers(void);
+#endif
+#if RIL_FEATURE_PAYLOAD
+static void _writePayload(void);
+static bool _readPayload(const uint8_t* data, Stream_LenType avail);
+static bool _isInlineHeader(const char* prefix, const uint8_t* data, int32_t quote);
+#endif
+#if RIL_FEATURE_SESSION
+static bool _putSection(uint8_t* out, uint32_t size, uint32_t* len, uint8_t tag, const void* data, uint32_t dataLen);
+static void _restoreSection(uint8_t tag, const uint8_t* data, uint32_t len, uint32_t sleptMs);
+#endif
 
 RIL_ATSndError RIL_initialize(UART_HandleTypeDef *uart){
-    stream.HUART = uart;
-    IStream_init(&stream.Input, UARTStream_receive, streamRxBuff, sizeof(streamRxBuff));
-    IStream_setCheckReceive(&stream.Input, UARTStream_checkReceivedBytes);
-    IStream_setArgs(&stream.Input, &stream);
-    OStream_init(&stream.Output, UARTStream_transmit, streamTxBuff, sizeof(streamTxBuff));
-    OStream_setArgs(&stream.Output, &stream);
-    // start receive
-    IStream_receive(&stream.Input);
-    rilInitialized = true;
+    _start(uart);
 
     uint16_t try = RIL_INIT_RETRY;
 
-    RIL_ATSndError atErrCode;
+    RIL_ATSndError atErrCode = RIL_AT_TIMEOUT;
     while (try--)
     {
         /* Start AT SYNC: Send AT every 500ms, if receive OK, SYNC success,
@@ -56,16 +239,45 @@ RIL_ATSndError RIL_initialize(UART_HandleTypeDef *uart){
         atErrCode = RIL_SendATCmd("AT", 2, NULL, NULL, 500);
         if (atErrCode == RIL_AT_SUCCESS)
         {
+        #if RIL_FEATURE_NUMERIC_RESULT
+            /* Use ATV<n> first, so the rest of the sequence already gets short result codes */
+            if (RIL_SendATCmd(resultFormat == RIL_RESULT_NUMERIC ? "ATV0" : "ATV1", 4, NULL, NULL, 500) == RIL_AT_SUCCESS){
+                acceptedFormats = 1U << resultFormat;
+            }
+        #else
+            // Use ATV1 to set the response format
+            RIL_SendATCmd("ATV1", 4, NULL, NULL, 500);
+        #endif
+
+        #if RIL_FEATURE_ECHO
+            /* Echo is matched against the sent command and dropped, so ATE<n> is
+               only needed when the application asks for a specific echo mode */
+            if (echoMode != RIL_ECHO_KEEP){
+                RIL_SendATCmd(echoMode == RIL_ECHO_ON ? "ATE1" : "ATE0", 4, NULL, NULL, 500);
+            }
+        #else
             /* Use ATE0 to disable echo mode */
-            RIL_SendATCmd("ATE0", 3, NULL, NULL, 500);
+            RIL_SendATCmd("ATE0", 4, NULL, NULL, 500);
+        #endif
 
             /* Use AT+CMEE=1 to enable result code */
-            RIL_SendATCmd("AT+CMEE=1", 9, NULL, NULL, 500);
+            atErrCode = RIL_SendATCmd("AT+CMEE=1", 9, NULL, NULL, 500);
 
-            // Use ATV1 to set the response format 
-            RIL_SendATCmd("ATE1", 3, NULL, NULL, 500);
-            
-            return RIL_AT_SUCCESS;
+        #if RIL_FEATURE_ECHO
+            /* AT+CMEE=1 is the first command after ATE<n>, its echo shows whether the mode took */
+            if (atErrCode == RIL_AT_SUCCESS && echoMode != RIL_ECHO_KEEP && echoSeen != (echoMode == RIL_ECHO_ON)){
+                _RIL_ERROR_SET(RIL_ERROR_AT, (uint32_t) RIL_AT_FAILED);
+                return RIL_AT_FAILED;
+            }
+        #endif
+
+        #if RIL_FEATURE_CAPS && RIL_CAPS_AT_INIT
+            if (atErrCode == RIL_AT_SUCCESS){
+                atErrCode = RIL_caps_discover(false);
+            }
+        #endif
+
+            return atErrCode;
         }
         
     }
@@ -73,8 +285,44 @@ RIL_ATSndError RIL_initialize(UART_HandleTypeDef *uart){
 
 }
 
+#if RIL_FEATURE_NUMERIC_RESULT
+void RIL_setResultFormat(RIL_ResultFormat format){
+    resultFormat = format;
+}
+
+RIL_ResultFormat RIL_getResultFormat(void){
+    return resultFormat;
+}
+#endif
+
+#if RIL_FEATURE_ECHO
+void RIL_setEchoMode(RIL_EchoMode mode){
+    echoMode = mode;
+}
+
+bool RIL_echoEnabled(void){
+    return echoSeen;
+}
+#endif
+
+#if RIL_FEATURE_BUFFER_STATS
+const RIL_BufferStats* RIL_getBufferStats(RIL_BufferId id){
+    return id < RIL_BUFFER_COUNT ? &bufferStats[id] : NULL;
+}
+
+void RIL_resetBufferStats(void){
+    RIL_bufferStats_init(&bufferStats[RIL_BUFFER_RX], RIL_RX_STREAM_SIZE);
+    RIL_bufferStats_init(&bufferStats[RIL_BUFFER_TX], RIL_TX_STREAM_SIZE);
+    RIL_bufferStats_init(&bufferStats[RIL_BUFFER_LINE], RIL_LINE_LEN);
+}
+#endif
+
 Stream_Result RIL_rxCpltHandle(void){
     Stream_Result streamErrCode = IStream_handle(&stream.Input, IStream_incomingBytes(&stream.Input));
+#if RIL_FEATURE_BUFFER_STATS
+    // A failed handle means the ring had no room left for the DMA block
+    _sampleBuffer(RIL_BUFFER_RX, streamErrCode == Stream_Ok ? (uint32_t) IStream_available(&stream.Input) : RIL_RX_STREAM_SIZE + 1);
+#endif
     _RIL_ERROR_SET(RIL_ERROR_EQPT, streamErrCode);
     return streamErrCode;
 }
@@ -85,65 +333,769 @@ Stream_Result RIL_txCpltHandle(void){
     return streamErrCode;
 }
 
-RIL_ATSndError RIL_SendATCmd(char *atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack, void *userData, uint32_t timeOut){
-    char buffer[RIL_LINE_LEN];
+RIL_ATSndError RIL_SendATCmd(const char *atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack, void *userData, uint32_t timeOut){
+    RIL_Command cmd;
     if (!rilInitialized){
         return RIL_AT_UNINITIALIZED;
-    }  
+    }
+    // A callback running inside RIL_process can not wait for its own engine
+    if (processDepth > 0){
+        return RIL_AT_BUSY;
+    }
 
-    if (timeOut == 0){
-        /* 3min -> (3*50*1000)ms */
-        timeOut += 180000;
+    RIL_ATSndError result = _prepareCommand(&cmd, atCmd, atCmdLen, atRsp_callBack, NULL, userData, timeOut);
+    if (result != RIL_AT_SUCCESS){
+        return result;
+    }
+    // The descriptor lives on this stack until the command is done, it leaves the queue before we return
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wdangling-pointer"
+#endif
+    _queueCommand(&cmd);
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+    #pragma GCC diagnostic pop
+#endif
+    while (cmd.State != _RIL_CMD_DONE){
+        RIL_process();
     }
-    timeOut += HAL_GetTick();
+    return cmd.Result;
+}
 
-    // Copy command to buffer
-    Str_copyFix(buffer, atCmd, atCmdLen);
-    // Put a null at the end of command
-    buffer[atCmdLen] = 0;
-    // Append CRLF at the end of command
-    Str_append(buffer, CRLF);
-    // Update atCmd and cmdLen
-    atCmd = buffer;
-    atCmdLen = strlen(buffer);
+RIL_ATSndError RIL_SendATCmdAsync(const char* atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut){
+    RIL_Command* cmd;
+    RIL_ATSndError result = _allocCommand(&cmd, atCmd, atCmdLen, atRsp_callBack, done, userData, timeOut);
+    if (result != RIL_AT_SUCCESS){
+        return result;
+    }
+    _queueCommand(cmd);
+    return RIL_AT_SUCCESS;
+}
 
-    Stream_Result streamErrCode = OStream_writeBytes(&stream.Output, (uint8_t *)atCmd, atCmdLen);
-    OStream_flush(&stream.Output);
+#if RIL_FEATURE_PAYLOAD
+RIL_ATSndError RIL_SendATCmdPayload(const char* atCmd, uint32_t atCmdLen, const RIL_Payload* payload,
+                                    Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut){
+    RIL_Command* cmd;
+    if (payload == NULL || (payload->Data == NULL && payload->Len != 0)){
+        return RIL_AT_INVALID_PARAM;
+    }
+    RIL_ATSndError result = _allocCommand(&cmd, atCmd, atCmdLen, atRsp_callBack, done, userData, timeOut);
+    if (result != RIL_AT_SUCCESS){
+        return result;
+    }
+    cmd->Payload = (const uint8_t*) payload->Data;
+    cmd->PayloadLen = payload->Len;
+    cmd->Prompt = payload->Prompt;
+    cmd->Inline = payload->Inline;
+    _queueCommand(cmd);
+    return RIL_AT_SUCCESS;
+}
+
+void RIL_setURCDataHandler(Callback_URC handler, void* userData){
+    urcDataHandler = handler;
+    urcDataArgs = userData;
+}
+
+void RIL_readPayload(uint32_t len, Callback_ATData sink, void* userData){
+    rxPayloadLeft = len;
+    rxSink = sink;
+    rxSinkArgs = userData;
+    rxSinkCommand = !urcDataRunning;
+    // A CR terminated line may still have its LF in front of the data
+    skipByte = lineEnd == '\r' ? '\n' : 0;
+    if (len == 0 && lineEnd == '"'){
+        skipByte = '"';
+    }
+}
+#endif
+
+void RIL_process(void){
+    int32_t len;
+    if (!rilInitialized){
+        return;
+    }
+    processDepth++;
+
+    _startCommand();
+#if RIL_FEATURE_PAYLOAD
+    // A payload larger than the TX stream goes out as the UART drains it
+    _writePayload();
+#endif
+    while ((len = _readLine()) > 0){
+        _handleLine(len);
+        // The next command goes out as soon as the previous one got its final result
+        _startCommand();
+    }
+    if (cmdActive && (int32_t) (HAL_GetTick() - cmdDeadline) >= 0){
+        _finishCommand(RIL_AT_TIMEOUT);
+        _startCommand();
+    }
+    _dispatchURC();
+#if RIL_FEATURE_BUFFER_STATS
+    _tickBuffers();
+#endif
+#if RIL_FEATURE_SOCKET
+    RIL_socket_process();
+#endif
+#if RIL_FEATURE_CONN
+    RIL_conn_process();
+#endif
+#if RIL_FEATURE_POWER
+    RIL_power_process();
+#endif
+#if RIL_FEATURE_BATCH
+    RIL_batch_process();
+#endif
+
+    processDepth--;
+}
+
+bool RIL_isIdle(void){
+    return cmdHead == NULL && urcHead == NULL;
+}
+
+RIL_ATSndError RIL_addURCHandler(Callback_URC handler, void* userData){
+    for (uint8_t i = 0; i < RIL_URC_HANDLERS; i++){
+        if (urcHandlers[i].Fn == NULL){
+            urcHandlers[i].Fn = handler;
+            urcHandlers[i].UserData = userData;
+            return RIL_AT_SUCCESS;
+        }
+    }
+    return RIL_AT_BUSY;
+}
+
+void RIL_removeURCHandler(Callback_URC handler, void* userData){
+    for (uint8_t i = 0; i < RIL_URC_HANDLERS; i++){
+        if (urcHandlers[i].Fn == handler && urcHandlers[i].UserData == userData){
+            urcHandlers[i].Fn = NULL;
+        }
+    }
+}
+
+RIL_PoolStats RIL_getPoolStats(RIL_PoolId id){
+    static const RIL_PoolStats EMPTY = {0};
+    switch (id){
+        case RIL_POOL_COMMAND:
+            return cmdPool.Stats;
+        case RIL_POOL_URC:
+            return urcPool.Stats;
+        default:
+            return EMPTY;
+    }
+}
+
+RIL_Error Ql_RIL_AT_GetErrCode(void){
+    return error;
+}
+
+#if RIL_FEATURE_SESSION
+uint32_t RIL_suspend(void* blob, uint32_t size){
+    uint8_t* out = (uint8_t*) blob;
+    uint32_t len = _RIL_SESSION_HEADER;
+    uint8_t core[_RIL_SESSION_CORE_LEN] = { 0xFF, 0xFF, 0xFF, 0xFF };
+
+    if (!rilInitialized || !RIL_isIdle() || size < len){
+        return 0;
+    }
+#if RIL_FEATURE_NUMERIC_RESULT
+    core[0] = (uint8_t) resultFormat;
+    core[1] = acceptedFormats;
+#endif
+#if RIL_FEATURE_ECHO
+    core[2] = (uint8_t) echoMode;
+    core[3] = echoSeen;
+#endif
+    if (!_putSection(out, size, &len, _RIL_SESSION_CORE, core, sizeof(core))){
+        return 0;
+    }
+#if RIL_FEATURE_CAPS
+    if (!_putSection(out, size, &len, _RIL_SESSION_CAPS, RIL_caps(), sizeof(RIL_Caps))){
+        return 0;
+    }
+#endif
+#if RIL_FEATURE_VENDOR && RIL_VENDOR == RIL_VENDOR_AUTO
+    uint8_t vendor = RIL_vendor() != NULL ? RIL_vendor()->Id : RIL_VENDOR_AUTO;
+    if (!_putSection(out, size, &len, _RIL_SESSION_VENDOR, &vendor, sizeof(vendor))){
+        return 0;
+    }
+#endif
+#if RIL_FEATURE_SOCKET
+    // Before the cache, which only keeps what fits
+    int32_t socketLen = len + _RIL_SESSION_SECTION <= size ?
+                        RIL_socket_suspend(&out[len + _RIL_SESSION_SECTION], size - len - _RIL_SESSION_SECTION) : -1;
+    if (socketLen < 0 || !_putSection(out, size, &len, _RIL_SESSION_SOCKET, NULL, (uint32_t) socketLen)){
+        return 0;
+    }
+#endif
+#if RIL_FEATURE_COMMANDS
+    // Optional, the cache keeps what fits
+    if (len + _RIL_SESSION_SECTION <= size){
+        uint32_t cacheLen = RIL_cmd_suspend(&out[len + _RIL_SESSION_SECTION], size - len - _RIL_SESSION_SECTION);
+        _putSection(out, size, &len, _RIL_SESSION_CACHE, NULL, cacheLen);
+    }
+#endif
+
+    uint16_t total = (uint16_t) len;
+    out[4] = _RIL_SESSION_VERSION;
+    out[5] = 0;
+    memcpy(&out[6], &total, sizeof(total));
+    uint32_t check = RIL_hash(RIL_HASH_INIT, &out[4], len - 4);
+    memcpy(out, &check, sizeof(check));
+    return len;
+}
+
+RIL_ATSndError RIL_resume(UART_HandleTypeDef* uart, const void* blob, uint32_t len, uint32_t sleptMs){
+    const uint8_t* in = (const uint8_t*) blob;
+    uint32_t check;
+    uint16_t total;
+
+    if (blob == NULL || len < _RIL_SESSION_HEADER){
+        return RIL_AT_INVALID_PARAM;
+    }
+    memcpy(&check, in, sizeof(check));
+    memcpy(&total, &in[6], sizeof(total));
+    if (in[4] != _RIL_SESSION_VERSION || total < _RIL_SESSION_HEADER || total > len ||
+        check != RIL_hash(RIL_HASH_INIT, &in[4], total - 4u))
+    {
+        return RIL_AT_INVALID_PARAM;
+    }
+
+    _start(uart);
+    for (uint32_t pos = _RIL_SESSION_HEADER; pos + _RIL_SESSION_SECTION <= total;){
+        uint16_t sectionLen;
+        memcpy(&sectionLen, &in[pos + 2], sizeof(sectionLen));
+        pos += _RIL_SESSION_SECTION;
+        if (pos + sectionLen > total){
+            break;
+        }
+        _restoreSection(in[pos - _RIL_SESSION_SECTION], &in[pos], sectionLen, sleptMs);
+        pos += sectionLen;
+    }
+
+    RIL_ATSndError atErrCode = RIL_SendATCmd("AT", 2, NULL, NULL, 500);
+    if (atErrCode != RIL_AT_SUCCESS){
+        _RIL_ERROR_SET(RIL_ERROR_AT, (uint32_t) atErrCode);
+    }
+    return atErrCode;
+}
+#endif
+
+/**
+ * @brief binds the streams and resets the queues, shared by RIL_initialize and RIL_resume
+ */
+static void _start(UART_HandleTypeDef* uart){
+    stream.HUART = uart;
+    IStream_init(&stream.Input, UARTStream_receive, streamRxBuff, sizeof(streamRxBuff));
+    IStream_setCheckReceive(&stream.Input, UARTStream_checkReceivedBytes);
+    IStream_setArgs(&stream.Input, &stream);
+    OStream_init(&stream.Output, UARTStream_transmit, streamTxBuff, sizeof(streamTxBuff));
+    OStream_setArgs(&stream.Output, &stream);
+#if RIL_FEATURE_BUFFER_STATS
+    RIL_resetBufferStats();
+#endif
+    RIL_pool_init(&cmdPool, cmdPoolStorage, sizeof(cmdPoolStorage[0]), RIL_CMD_POOL_SIZE);
+    RIL_pool_init(&urcPool, urcPoolStorage, sizeof(urcPoolStorage[0]), RIL_URC_POOL_SIZE);
+    cmdHead = cmdTail = NULL;
+    cmdActive = false;
+    urcHead = urcTail = NULL;
+    lineLen = 0;
+#if RIL_FEATURE_PAYLOAD
+    txPayloadLeft = rxPayloadLeft = 0;
+    promptPending = inlinePending = false;
+    skipByte = 0;
+#endif
+    // start receive
+    IStream_receive(&stream.Input);
+    rilInitialized = true;
+#if RIL_FEATURE_NUMERIC_RESULT
+    acceptedFormats = RIL_RESULT_FORMAT_ANY;
+#endif
+
+}
+
+static RIL_ATSndError _prepareCommand(RIL_Command* cmd, const char* atCmd, uint32_t atCmdLen,
+                                      Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut){
+    // The command and its CRLF go out in one piece, so they have to fit the TX stream
+    if (atCmd == NULL || atCmdLen + (sizeof(CRLF) - 1) > RIL_TX_STREAM_SIZE){
+        return RIL_AT_INVALID_PARAM;
+    }
+
+    cmd->Cmd = atCmd;
+    cmd->CmdLen = (uint16_t) atCmdLen;
+    cmd->Next = NULL;
+    cmd->Callback = atRsp_callBack;
+    cmd->Done = done;
+    cmd->UserData = userData;
+    /* 3min -> (3*60*1000)ms */
+    cmd->TimeOut = timeOut != 0 ? timeOut : 180000;
+    cmd->Result = RIL_AT_SUCCESS;
+    cmd->State = _RIL_CMD_QUEUED;
+    cmd->Flags = 0;
+#if RIL_FEATURE_PAYLOAD
+    cmd->Prompt = 0;
+    cmd->Payload = NULL;
+    cmd->PayloadLen = 0;
+    cmd->Inline = NULL;
+#endif
+    return RIL_AT_SUCCESS;
+}
+
+/**
+ * @brief takes a descriptor from the pool and copies the command text into it
+ */
+static RIL_ATSndError _allocCommand(RIL_Command** out, const char* atCmd, uint32_t atCmdLen,
+                                    Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData, uint32_t timeOut){
+    if (!rilInitialized){
+        return RIL_AT_UNINITIALIZED;
+    }
+
+    if (atCmdLen > RIL_CMD_LEN){
+        return RIL_AT_INVALID_PARAM;
+    }
+    RIL_PooledCommand* pooled = (RIL_PooledCommand*) RIL_pool_alloc(&cmdPool);
+    if (pooled == NULL){
+        return RIL_AT_BUSY;
+    }
+    RIL_Command* cmd = &pooled->Base;
+    RIL_ATSndError result = _prepareCommand(cmd, atCmd, atCmdLen, atRsp_callBack, done, userData, timeOut);
+    if (result != RIL_AT_SUCCESS){
+        RIL_pool_free(&cmdPool, pooled);
+        return result;
+    }
+    // The caller's buffer may be gone by the time the command goes out
+    memcpy(pooled->Buff, atCmd, atCmdLen);
+    cmd->Cmd = pooled->Buff;
+    cmd->Flags |= _RIL_CMD_POOLED;
+    *out = cmd;
+    return RIL_AT_SUCCESS;
+}
+
+static void _queueCommand(RIL_Command* cmd){
+    if (cmdTail != NULL){
+        cmdTail->Next = cmd;
+    }
+    else {
+        cmdHead = cmd;
+    }
+    cmdTail = cmd;
+}
+
+/**
+ * @brief writes the command at the head of the queue, if it is not on the wire yet
+ */
+static void _startCommand(void){
+    RIL_Command* cmd = cmdHead;
+    if (cmd == NULL || cmdActive){
+        return;
+    }
+#if RIL_FEATURE_POWER
+    // Wakes a sleeping modem, the command waits for the wake-to-ready delay
+    if (!RIL_power_ready()){
+        return;
+    }
+#endif
+
+    // The UART is still draining earlier bytes: the command stays queued and is
+    // tried again on the next pass, for at most its own timeout
+    if (OStream_space(&stream.Output) < (Stream_LenType) (cmd->CmdLen + sizeof(CRLF) - 1)){
+        if (!(cmd->Flags & _RIL_CMD_HELD)){
+            cmd->Flags |= _RIL_CMD_HELD;
+            cmdDeadline = HAL_GetTick() + cmd->TimeOut;
+        #if RIL_FEATURE_BUFFER_STATS
+            _sampleBuffer(RIL_BUFFER_TX, RIL_TX_STREAM_SIZE + 1);
+        #endif
+        }
+        else if ((int32_t) (HAL_GetTick() - cmdDeadline) >= 0){
+            _RIL_ERROR_SET(RIL_ERROR_EQPT, Stream_NoSpace);
+            _finishCommand(RIL_AT_TIMEOUT);
+        }
+        return;
+    }
+    Stream_Result streamErrCode = OStream_writeBytes(&stream.Output, (uint8_t *) cmd->Cmd, cmd->CmdLen);
+    if (streamErrCode == Stream_Ok){
+        streamErrCode = OStream_writeBytes(&stream.Output, (uint8_t *) CRLF, sizeof(CRLF) - 1);
+    }
+#if RIL_FEATURE_BUFFER_STATS
+    _sampleBuffer(RIL_BUFFER_TX, streamErrCode == Stream_Ok ? (uint32_t) OStream_available(&stream.Output) : RIL_TX_STREAM_SIZE + 1);
+#endif
     if (streamErrCode)
     {
         _RIL_ERROR_SET(RIL_ERROR_EQPT, streamErrCode);
-        return RIL_AT_FAILED;
-    }
-    streamErrCode = OStream_flush(&stream.Output);
-
-    while (HAL_GetTick() < timeOut){
-        if(IStream_available(&stream.Input) > 0){
-            Stream_LenType len = IStream_readBytesUntilPattern(&stream.Input, (uint8_t *)CRLF, CRLFLen, (uint8_t *)buffer, RIL_LINE_LEN);
-            if(len > CRLFLen){
-                buffer[len] = 0;
-                // Check that the response is not an error 
-                uint16_t errCode;
-                if(_lineIsError(buffer, len, &errCode) > 0){
-                    _RIL_ERROR_SET(RIL_ERROR_AT, errCode);
-                    return RIL_AT_FAILED;
-                }
-
-                if (atRsp_callBack != NULL)
-                {
-                    atRsp_callBack(buffer, len, userData);
-                }
-                            
-                return RIL_AT_SUCCESS;
+        cmdActive = true;
+        _finishCommand(RIL_AT_FAILED);
+        return;
+    }
+    OStream_flush(&stream.Output);
+
+    cmdActive = true;
+    cmd->State = _RIL_CMD_ACTIVE;
+    cmdDeadline = HAL_GetTick() + cmd->TimeOut;
+#if RIL_FEATURE_ECHO
+    echoPending = true;
+#endif
+#if RIL_FEATURE_PAYLOAD
+    txPayload = cmd->Payload;
+    txPayloadLeft = cmd->PayloadLen;
+    promptPending = txPayloadLeft > 0 && cmd->Prompt != 0;
+    inlinePending = cmd->Inline != NULL;
+    if (!promptPending){
+        _writePayload();
+    }
+#endif
+}
+
+/**
+ * @brief completes the active command and releases the queue for the next one
+ */
+static void _finishCommand(RIL_ATSndError result){
+    RIL_Command* cmd = cmdHead;
+
+    cmdHead = cmd->Next;
+    if (cmdHead == NULL){
+        cmdTail = NULL;
+    }
+    cmdActive = false;
+#if RIL_FEATURE_PAYLOAD
+    // Whatever is left of its own data belonged to this command, the sink may be gone after done.
+    // Data pushed behind a URC keeps going to its sink, or the rest of it would be parsed as lines.
+    txPayloadLeft = 0;
+    if (rxSinkCommand){
+        rxPayloadLeft = 0;
+    }
+    promptPending = inlinePending = false;
+#endif
+
+    cmd->Result = result;
+    cmd->State = _RIL_CMD_DONE;
+    if (cmd->Done != NULL){
+        cmd->Done(result, cmd->UserData);
+    }
+    // A caller owned descriptor may go out of scope as soon as State is done
+    if (cmd->Flags & _RIL_CMD_POOLED){
+        RIL_pool_free(&cmdPool, cmd);
+    }
+}
+
+/**
+ * @brief routes one line to the active command or to the URC queue
+ */
+static void _handleLine(int32_t len){
+    RIL_Command* cmd = cmdHead;
+#if RIL_FEATURE_NUMERIC_RESULT
+    const RIL_Prefix* prefix = RIL_lineClassify(lineBuff, len, (acceptedFormats & (1U << RIL_RESULT_NUMERIC)) != 0);
+#else
+    const RIL_Prefix* prefix = RIL_lineClassify(lineBuff, len, false);
+#endif
+    RIL_LineKind kind = prefix != NULL ? (RIL_LineKind) prefix->Kind : RIL_LINE_INFO;
+
+    if (!cmdActive){
+        // A late final result of a timed out command has no owner anymore
+        if (kind != RIL_LINE_FINAL_OK && kind != RIL_LINE_FINAL_ERROR){
+            _queueURC(prefix, len);
+        }
+        return;
+    }
+
+#if RIL_FEATURE_ECHO
+    // The echo, if any, is the first line after the command that is not a URC
+    if (echoPending && kind != RIL_LINE_URC){
+        echoPending = false;
+        echoSeen = RIL_lineIsEcho(lineBuff, len, RIL_LINE_LEN, cmd->Cmd, cmd->CmdLen);
+        if (echoSeen){
+            return;
+        }
+    }
+#endif
+    // "+CREG: ..." answers AT+CREG? even though the same prefix is also a URC
+    if (kind == RIL_LINE_URC && RIL_lineIsResponseOf(prefix, cmd->Cmd, cmd->CmdLen)){
+        kind = RIL_LINE_INFO;
+    }
+
+    switch (kind){
+        case RIL_LINE_FINAL_OK:
+            _finishCommand(cmd->Result);
+            break;
+        case RIL_LINE_FINAL_ERROR:
+            _RIL_ERROR_SET(RIL_ERROR_AT, RIL_lineErrCode(prefix, lineBuff));
+            _finishCommand(RIL_AT_FAILED);
+            break;
+        case RIL_LINE_URC:
+            // Not part of this response
+            _queueURC(prefix, len);
+            break;
+        default:
+            if (cmd->Callback != NULL &&
+                (int32_t) cmd->Callback(lineBuff, len, cmd->UserData) == RIL_AT_RSP_FAILED)
+            {
+                cmd->Result = RIL_AT_FAILED;
             }
-        }        
+            break;
     }
-    return RIL_AT_TIMEOUT;
 }
 
-RIL_Error Ql_RIL_AT_GetErrCode(void){
-    return error;
+/**
+ * @brief keeps a copy of a URC line until _dispatchURC hands it to the handlers,
+ *  the line is dropped (and counted in the pool statistics) when the pool is empty
+ */
+static void _queueURC(const RIL_Prefix* prefix, int32_t len){
+#if RIL_FEATURE_PAYLOAD
+    // Data behind the line is taken now, before the parser sees it as lines
+    if (urcDataHandler != NULL){
+        urcDataRunning = true;
+        urcDataHandler(lineBuff, (uint32_t) len, prefix != NULL ? (RIL_PrefixId) prefix->Id : RIL_PREFIX_NONE, urcDataArgs);
+        urcDataRunning = false;
+    }
+#endif
+    RIL_URCEvent* event = (RIL_URCEvent*) RIL_pool_alloc(&urcPool);
+    if (event == NULL){
+        return;
+    }
+    if (len > RIL_URC_LINE_LEN - 1){
+        len = RIL_URC_LINE_LEN - 1;
+    }
+    memcpy(event->Line, lineBuff, len);
+    event->Line[len] = 0;
+    event->Len = (uint16_t) len;
+    event->Id = prefix != NULL ? prefix->Id : RIL_PREFIX_NONE;
+    event->Next = NULL;
+
+    if (urcTail != NULL){
+        urcTail->Next = event;
+    }
+    else {
+        urcHead = event;
+    }
+    urcTail = event;
+}
+
+static void _dispatchURC(void){
+    RIL_URCEvent* event;
+    while ((event = urcHead) != NULL){
+        urcHead = event->Next;
+        if (urcHead == NULL){
+            urcTail = NULL;
+        }
+        for (uint8_t i = 0; i < RIL_URC_HANDLERS; i++){
+            if (urcHandlers[i].Fn != NULL){
+                urcHandlers[i].Fn(event->Line, event->Len, (RIL_PrefixId) event->Id, urcHandlers[i].UserData);
+            }
+        }
+        RIL_pool_free(&urcPool, event);
+    }
+}
+
+#if RIL_FEATURE_BUFFER_STATS
+/**
+ * @brief records a buffer event and hands it to RIL_STATS_TRACE
+ */
+static void _sampleBuffer(RIL_BufferId id, uint32_t used){
+    uint32_t now = HAL_GetTick();
+    RIL_bufferStats_sample(&bufferStats[id], used, now);
+    RIL_STATS_TRACE(id, used, now);
+}
+
+/**
+ * @brief times the buffers between their events, a ring that stays full while
+ *  nothing arrives or drains is still counted above 75%
+ */
+static void _tickBuffers(void){
+    uint32_t now = HAL_GetTick();
+    RIL_bufferStats_tick(&bufferStats[RIL_BUFFER_RX], (uint32_t) IStream_available(&stream.Input), now);
+    RIL_bufferStats_tick(&bufferStats[RIL_BUFFER_TX], (uint32_t) OStream_available(&stream.Output), now);
+    RIL_bufferStats_tick(&bufferStats[RIL_BUFFER_LINE], (uint32_t) lineLen, now);
+}
+#endif
+
+/**
+ * @brief moves bytes from the RX stream into lineBuff until a line terminator shows up.
+ *  Empty lines (the LF of a CRLF pair) are skipped, bytes beyond RIL_LINE_LEN are dropped.
+ * @return length of the completed line, or -1 if no complete line is buffered yet
+ */
+static int32_t _readLine(void){
+    Stream_LenType avail;
+    while ((avail = IStream_directAvailable(&stream.Input)) > 0){
+        const uint8_t* data = IStream_getReadPtr(&stream.Input);
+    #if RIL_FEATURE_PAYLOAD
+        if (_readPayload(data, avail)){
+            continue;
+        }
+    #endif
+        int32_t eol = RIL_scanEOL(data, avail);
+    #if RIL_FEATURE_PAYLOAD
+        if (inlinePending){
+            int32_t quote = RIL_scanBytes(data, eol < 0 ? avail : eol, '"', '"');
+            if (quote >= 0 && _isInlineHeader(cmdHead->Inline, data, quote)){
+                inlinePending = false;
+                eol = quote;
+            }
+        }
+        if (eol >= 0){
+            lineEnd = (char) data[eol];
+        }
+    #endif
+    #if RIL_FEATURE_BUFFER_STATS
+        bool* cut = &lineCut;
+    #else
+        bool* cut = NULL;
+    #endif
+        IStream_moveReadPos(&stream.Input, (Stream_LenType) RIL_lineAppend(lineBuff, &lineLen, RIL_LINE_LEN, data, avail, eol, cut));
+
+        int32_t len = RIL_lineEnd(lineBuff, &lineLen, eol);
+        if (len >= 0){
+        #if RIL_FEATURE_BUFFER_STATS
+            _sampleBuffer(RIL_BUFFER_LINE, lineCut ? RIL_LINE_LEN + 1 : (uint32_t) len + 1);
+            lineCut = false;
+        #endif
+            return len;
+        }
+    }
+    return -1;
 }
 
-static int16_t _lineIsError(const char* line, uint32_t len, uint16_t* errCode){
-    return sscanf(line, "+CME ERROR: %hu", errCode); 
-}
\ No newline at end of file
+#if RIL_FEATURE_PAYLOAD
+/**
+ * @brief writes as much of the payload as the TX stream takes
+ */
+static void _writePayload(void){
+    if (txPayloadLeft == 0 || promptPending){
+        return;
+    }
+    Stream_LenType space = OStream_space(&stream.Output);
+    Stream_LenType len = txPayloadLeft < (uint32_t) space ? (Stream_LenType) txPayloadLeft : space;
+    if (len == 0){
+        return;
+    }
+    OStream_writeBytes(&stream.Output, (uint8_t*) txPayload, len);
+    OStream_flush(&stream.Output);
+    txPayload += len;
+    txPayloadLeft -= len;
+}
+
+/**
+ * @brief takes the bytes that are not lines: a skipped byte, the prompt of the
+ *  active command and raw data armed by RIL_readPayload
+ * @return true when it consumed something
+ */
+static bool _readPayload(const uint8_t* data, Stream_LenType avail){
+    if (skipByte != 0){
+        if (data[0] == (uint8_t) skipByte){
+            IStream_moveReadPos(&stream.Input, 1);
+        }
+        skipByte = 0;
+        return true;
+    }
+    if (rxPayloadLeft > 0){
+        Stream_LenType len = rxPayloadLeft < (uint32_t) avail ? (Stream_LenType) rxPayloadLeft : avail;
+        rxPayloadLeft -= len;
+        if (rxSink != NULL){
+            rxSink(data, len, rxSinkArgs);
+        }
+        IStream_moveReadPos(&stream.Input, len);
+        if (rxPayloadLeft == 0 && lineEnd == '"'){
+            skipByte = '"';
+        }
+        return true;
+    }
+    // The prompt starts a line but has no terminator, "> " or "@"
+    if (promptPending && lineLen == 0 && data[0] == (uint8_t) cmdHead->Prompt){
+        IStream_moveReadPos(&stream.Input, 1);
+        promptPending = false;
+        skipByte = ' ';
+        _writePayload();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief checks whether the line so far plus data up to the quote starts with the Inline prefix
+ */
+static bool _isInlineHeader(const char* prefix, const uint8_t* data, int32_t quote){
+    uint32_t len = (uint32_t) strlen(prefix);
+    if ((uint32_t) lineLen + (uint32_t) quote < len){
+        return false;
+    }
+    for (uint32_t i = 0; i < len; i++){
+        char c = i < (uint32_t) lineLen ? lineBuff[i] : (char) data[i - lineLen];
+        if (c != prefix[i]){
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+#if RIL_FEATURE_SESSION
+/**
+ * @brief appends a section of tag, length and data, data NULL when it is already in place
+ */
+static bool _putSection(uint8_t* out, uint32_t size, uint32_t* len, uint8_t tag, const void* data, uint32_t dataLen){
+    uint16_t sectionLen = (uint16_t) dataLen;
+    if (*len + _RIL_SESSION_SECTION + dataLen > size){
+        return false;
+    }
+    out[*len] = tag;
+    out[*len + 1] = 0;
+    memcpy(&out[*len + 2], &sectionLen, sizeof(sectionLen));
+    if (data != NULL){
+        memcpy(&out[*len + _RIL_SESSION_SECTION], data, dataLen);
+    }
+    *len += _RIL_SESSION_SECTION + dataLen;
+    return true;
+}
+
+/**
+ * @brief restores one section, unknown tags and sections of disabled features are skipped
+ */
+static void _restoreSection(uint8_t tag, const uint8_t* data, uint32_t len, uint32_t sleptMs){
+    (void) sleptMs;
+    switch (tag){
+        case _RIL_SESSION_CORE:
+            if (len != _RIL_SESSION_CORE_LEN){
+                break;
+            }
+        #if RIL_FEATURE_NUMERIC_RESULT
+            if (data[0] <= RIL_RESULT_VERBOSE && data[1] != 0 && (data[1] & ~RIL_RESULT_FORMAT_ANY) == 0){
+                resultFormat = (RIL_ResultFormat) data[0];
+                acceptedFormats = data[1];
+            }
+        #endif
+        #if RIL_FEATURE_ECHO
+            if (data[2] <= RIL_ECHO_ON){
+                echoMode = (RIL_EchoMode) data[2];
+                echoSeen = data[3] == 1;
+            }
+        #endif
+            break;
+    #if RIL_FEATURE_CAPS
+        case _RIL_SESSION_CAPS:
+            if (len == sizeof(RIL_Caps)){
+                RIL_Caps caps;
+                memcpy(&caps, data, sizeof(caps));
+                RIL_caps_restore(&caps);
+            }
+            break;
+    #endif
+    #if RIL_FEATURE_VENDOR && RIL_VENDOR == RIL_VENDOR_AUTO
+        case _RIL_SESSION_VENDOR:
+            if (len == 1){
+                RIL_vendor_set(RIL_vendor_byId(data[0]));
+            }
+            break;
+    #endif
+    #if RIL_FEATURE_COMMANDS
+        case _RIL_SESSION_CACHE:
+            RIL_cmd_resume(data, len, sleptMs);
+            break;
+    #endif
+    #if RIL_FEATURE_SOCKET
+        case _RIL_SESSION_SOCKET:
+            RIL_socket_resume(data, len);
+            break;
+    #endif
+        default:
+            break;
+    }
+}
+#endif
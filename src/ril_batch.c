@@ -0,0 +1,242 @@
+/**
+ * @file ril_batch.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Deferred commands sent together while the modem is awake
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_batch.h"
+
+#if RIL_FEATURE_BATCH
+
+#if RIL_FEATURE_POWER
+    #include "ril_power.h"
+#endif
+#include <stdbool.h>
+#include <string.h>
+
+/* RIL_BatchSlot.State */
+#define SLOT_FREE               0
+#define SLOT_WAITING            1
+#define SLOT_SENT               2
+
+/**
+ * Deferred command, kept until its done callback ran
+ */
+typedef struct {
+    Callback_ATResponse     Callback;
+    Callback_ATDone         Done;
+    void*                   UserData;
+    uint32_t                TimeOut;
+    uint32_t                Deadline;
+    uint16_t                Seq;        /**< Defer order, slots are sent oldest first */
+    uint8_t                 CmdLen;
+    uint8_t                 State;
+#if RIL_FEATURE_PAYLOAD
+    bool                    HasPayload;
+    RIL_Payload             Payload;
+#endif
+    char                    Cmd[RIL_CMD_LEN];
+} RIL_BatchSlot;
+
+static RIL_BatchSlot slots[RIL_BATCH_SLOTS];
+static RIL_BatchStats stats;
+static uint32_t awakeUntil;
+static uint16_t nextSeq;
+static bool awakeKnown = false;
+static bool flushing = false;
+static bool urcHooked = false;
+
+RIL_STATIC_ASSERT(sizeof(slots) + sizeof(stats) + sizeof(awakeUntil) + sizeof(nextSeq) + 3 <= RIL_RAM_BATCH,
+                  "RIL_RAM_BATCH under-counts ril_batch.c");
+
+static RIL_BatchSlot* _defer(const char* atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack,
+                             Callback_ATDone done, void* userData, uint32_t timeOut, uint32_t maxDelay);
+static RIL_ATSndError _send(RIL_BatchSlot* slot);
+static RIL_BatchSlot* _oldestWaiting(void);
+static void _markAwake(void);
+static void _onURC(const char* line, uint32_t len, RIL_PrefixId id, void* userData);
+static uint32_t _onLine(char* line, uint32_t len, void* userData);
+static void _onDone(RIL_ATSndError result, void* userData);
+
+RIL_ATSndError RIL_batch_defer(const char* atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack,
+                               Callback_ATDone done, void* userData, uint32_t timeOut, uint32_t maxDelay){
+    if (atCmd == NULL || atCmdLen == 0 || atCmdLen > RIL_CMD_LEN){
+        return RIL_AT_INVALID_PARAM;
+    }
+    return _defer(atCmd, atCmdLen, atRsp_callBack, done, userData, timeOut, maxDelay) != NULL ? RIL_AT_SUCCESS : RIL_AT_BUSY;
+}
+
+#if RIL_FEATURE_PAYLOAD
+RIL_ATSndError RIL_batch_deferPayload(const char* atCmd, uint32_t atCmdLen, const RIL_Payload* payload,
+                                      Callback_ATResponse atRsp_callBack, Callback_ATDone done, void* userData,
+                                      uint32_t timeOut, uint32_t maxDelay){
+    if (atCmd == NULL || atCmdLen == 0 || atCmdLen > RIL_CMD_LEN || payload == NULL){
+        return RIL_AT_INVALID_PARAM;
+    }
+    RIL_BatchSlot* slot = _defer(atCmd, atCmdLen, atRsp_callBack, done, userData, timeOut, maxDelay);
+    if (slot == NULL){
+        return RIL_AT_BUSY;
+    }
+    slot->Payload = *payload;
+    slot->HasPayload = true;
+    return RIL_AT_SUCCESS;
+}
+#endif
+
+void RIL_batch_flush(void){
+    if (!flushing && _oldestWaiting() != NULL){
+        flushing = true;
+        stats.Wakes++;
+    }
+    RIL_batch_process();
+}
+
+void RIL_batch_process(void){
+    uint32_t now = HAL_GetTick();
+    RIL_BatchSlot* slot;
+
+    if (!RIL_isIdle()){
+        _markAwake();
+    }
+#if RIL_FEATURE_POWER
+    // DTR holds the modem awake until the idle timeout
+    if (RIL_power_state() == RIL_POWER_AWAKE){
+        _markAwake();
+    }
+#endif
+    if (!flushing){
+        if ((slot = _oldestWaiting()) == NULL){
+            return;
+        }
+        if (awakeKnown && (int32_t) (awakeUntil - now) > 0){
+            flushing = true;
+            stats.Piggybacked++;
+        }
+        else {
+            for (uint8_t i = 0; i < RIL_BATCH_SLOTS && !flushing; i++){
+                flushing = slots[i].State == SLOT_WAITING && (int32_t) (now - slots[i].Deadline) >= 0;
+            }
+            if (!flushing){
+                return;
+            }
+            stats.Wakes++;
+        }
+    }
+
+    // The engine pool may take fewer commands than are waiting, the rest follow on the next calls
+    while ((slot = _oldestWaiting()) != NULL){
+        if (_send(slot) != RIL_AT_SUCCESS){
+            return;
+        }
+        slot->State = SLOT_SENT;
+        stats.Sent++;
+    }
+    flushing = false;
+}
+
+uint8_t RIL_batch_pending(void){
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < RIL_BATCH_SLOTS; i++){
+        if (slots[i].State != SLOT_FREE){
+            count++;
+        }
+    }
+    return count;
+}
+
+const RIL_BatchStats* RIL_batch_stats(void){
+    stats.WakesSaved = stats.Sent > stats.Wakes ? stats.Sent - stats.Wakes : 0;
+    return &stats;
+}
+
+void RIL_batch_resetStats(void){
+    memset(&stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief takes a free slot for the command, NULL when all are taken
+ */
+static RIL_BatchSlot* _defer(const char* atCmd, uint32_t atCmdLen, Callback_ATResponse atRsp_callBack,
+                             Callback_ATDone done, void* userData, uint32_t timeOut, uint32_t maxDelay){
+    if (!urcHooked){
+        // A URC means the modem is awake, the handler only notes the time
+        urcHooked = RIL_addURCHandler(_onURC, NULL) == RIL_AT_SUCCESS;
+    }
+    for (uint8_t i = 0; i < RIL_BATCH_SLOTS; i++){
+        RIL_BatchSlot* slot = &slots[i];
+        if (slot->State == SLOT_FREE){
+            memcpy(slot->Cmd, atCmd, atCmdLen);
+            slot->CmdLen = (uint8_t) atCmdLen;
+            slot->Callback = atRsp_callBack;
+            slot->Done = done;
+            slot->UserData = userData;
+            slot->TimeOut = timeOut;
+            slot->Deadline = HAL_GetTick() + maxDelay;
+            slot->Seq = nextSeq++;
+        #if RIL_FEATURE_PAYLOAD
+            slot->HasPayload = false;
+        #endif
+            slot->State = SLOT_WAITING;
+            stats.Deferred++;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+static RIL_ATSndError _send(RIL_BatchSlot* slot){
+#if RIL_FEATURE_PAYLOAD
+    if (slot->HasPayload){
+        return RIL_SendATCmdPayload(slot->Cmd, slot->CmdLen, &slot->Payload, _onLine, _onDone, slot, slot->TimeOut);
+    }
+#endif
+    return RIL_SendATCmdAsync(slot->Cmd, slot->CmdLen, _onLine, _onDone, slot, slot->TimeOut);
+}
+
+static RIL_BatchSlot* _oldestWaiting(void){
+    RIL_BatchSlot* oldest = NULL;
+    for (uint8_t i = 0; i < RIL_BATCH_SLOTS; i++){
+        RIL_BatchSlot* slot = &slots[i];
+        if (slot->State == SLOT_WAITING && (oldest == NULL || (int16_t) (slot->Seq - oldest->Seq) < 0)){
+            oldest = slot;
+        }
+    }
+    return oldest;
+}
+
+static void _markAwake(void){
+    awakeUntil = HAL_GetTick() + RIL_BATCH_AWAKE_MS;
+    awakeKnown = true;
+}
+
+static void _onURC(const char* line, uint32_t len, RIL_PrefixId id, void* userData){
+    (void) line;
+    (void) len;
+    (void) id;
+    (void) userData;
+    _markAwake();
+}
+
+static uint32_t _onLine(char* line, uint32_t len, void* userData){
+    RIL_BatchSlot* slot = (RIL_BatchSlot*) userData;
+    return slot->Callback != NULL ? slot->Callback(line, len, slot->UserData) : RIL_AT_RSP_CONTINUE;
+}
+
+static void _onDone(RIL_ATSndError result, void* userData){
+    RIL_BatchSlot* slot = (RIL_BatchSlot*) userData;
+    Callback_ATDone done = slot->Done;
+    void* doneData = slot->UserData;
+    // Free first, done may defer the next command into the same slot
+    slot->State = SLOT_FREE;
+    _markAwake();
+    if (done != NULL){
+        done(result, doneData);
+    }
+}
+
+#endif
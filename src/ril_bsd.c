@@ -0,0 +1,366 @@
+/**
+ * @file ril_bsd.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief BSD socket calls over the modem sockets of ril_socket.h
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_bsd.h"
+
+#if RIL_FEATURE_BSD
+
+#include "ril_socket.h"
+#include "ril_cmd.h"
+
+/* RIL_BsdDesc.Flags */
+#define DESC_USED               0x01
+#define DESC_NONBLOCK           0x02
+
+/* RIL_BsdDesc.Sock before connect */
+#define NO_SOCKET               (-1)
+
+/* "255.255.255.255" */
+#define ADDR_LEN                16
+
+/**
+ * One descriptor, the modem socket behind it exists from connect to close
+ */
+typedef struct {
+    uint32_t                RcvTimeout;     /**< ms, 0 waits forever */
+    uint32_t                SndTimeout;
+    int8_t                  Sock;
+    uint8_t                 Type;           /**< RIL_SOCKET_TCP, RIL_SOCKET_UDP */
+    uint8_t                 Flags;
+} RIL_BsdDesc;
+
+int RIL_bsd_errno = 0;
+
+static RIL_BsdDesc descs[RIL_SOCKET_COUNT];
+
+RIL_STATIC_ASSERT(sizeof(descs) + sizeof(RIL_bsd_errno) <= RIL_RAM_BSD, "RIL_RAM_BSD under-counts ril_bsd.c");
+
+static RIL_BsdDesc* _desc(int fd);
+static bool _mayWait(const RIL_BsdDesc* desc, int flags);
+static bool _wait(const RIL_BsdDesc* desc, uint8_t events, uint32_t timeOut);
+static short _revents(int fd);
+static uint32_t _timeval(const struct RIL_timeval* tv);
+static int _fail(int error);
+
+int RIL_bsd_socket(int domain, int type, int protocol){
+    if (domain != RIL_AF_INET){
+        return _fail(RIL_EAFNOSUPPORT);
+    }
+    if ((type != RIL_SOCK_STREAM || (protocol != 0 && protocol != RIL_IPPROTO_TCP)) &&
+        (type != RIL_SOCK_DGRAM || (protocol != 0 && protocol != RIL_IPPROTO_UDP)))
+    {
+        return _fail(RIL_EINVAL);
+    }
+    for (int fd = 0; fd < RIL_SOCKET_COUNT; fd++){
+        RIL_BsdDesc* desc = &descs[fd];
+        if (desc->Flags & DESC_USED){
+            continue;
+        }
+        desc->RcvTimeout = 0;
+        desc->SndTimeout = 0;
+        desc->Sock = NO_SOCKET;
+        desc->Type = type == RIL_SOCK_STREAM ? RIL_SOCKET_TCP : RIL_SOCKET_UDP;
+        desc->Flags = DESC_USED;
+        return fd;
+    }
+    return _fail(RIL_EMFILE);
+}
+
+int RIL_bsd_connect(int fd, const struct RIL_sockaddr* addr, uint32_t addrLen){
+    const struct RIL_sockaddr_in* in = (const struct RIL_sockaddr_in*) addr;
+    char host[ADDR_LEN];
+    char* pos = host;
+    if (in == NULL || addrLen < sizeof(struct RIL_sockaddr_in)){
+        return _fail(RIL_EINVAL);
+    }
+    if (in->sin_family != RIL_AF_INET){
+        return _fail(RIL_EAFNOSUPPORT);
+    }
+    // Network byte order whatever the host order is
+    const uint8_t* ip = (const uint8_t*) &in->sin_addr.s_addr;
+    const uint8_t* port = (const uint8_t*) &in->sin_port;
+    for (uint8_t i = 0; i < 4; i++){
+        if (i > 0){
+            *pos++ = '.';
+        }
+        pos = RIL_cmd_putUint(pos, ip[i]);
+    }
+    *pos = '\0';
+    return RIL_bsd_connectHost(fd, host, (uint16_t) ((port[0] << 8) | port[1]));
+}
+
+int RIL_bsd_connectHost(int fd, const char* host, uint16_t port){
+    RIL_BsdDesc* desc = _desc(fd);
+    if (desc == NULL){
+        return _fail(RIL_EBADF);
+    }
+    if (desc->Sock != NO_SOCKET){
+        return _fail(RIL_socket_state((uint8_t) desc->Sock) == RIL_SOCKET_OPENING ? RIL_EALREADY : RIL_EISCONN);
+    }
+    uint32_t start = HAL_GetTick();
+    int32_t sock;
+    // The modem socket of a closed descriptor is busy until its close command is done
+    while ((sock = RIL_socket_open(desc->Type, host, port, NULL, NULL)) == RIL_AT_BUSY && _mayWait(desc, 0) &&
+           (desc->SndTimeout == 0 || HAL_GetTick() - start < desc->SndTimeout))
+    {
+        RIL_process();
+    }
+    if (sock < 0){
+        switch (sock){
+            case RIL_AT_BUSY:
+                return _fail(RIL_EAGAIN);
+            case RIL_AT_UNINITIALIZED:
+                return _fail(RIL_ENETDOWN);
+            default:
+                return _fail(RIL_EINVAL);
+        }
+    }
+    desc->Sock = (int8_t) sock;
+    if (!_mayWait(desc, 0)){
+        return _fail(RIL_EINPROGRESS);
+    }
+    if (!_wait(desc, RIL_SOCKET_WRITABLE | RIL_SOCKET_HUP | RIL_SOCKET_ERROR, desc->SndTimeout)){
+        // Gave up, the descriptor can connect again
+        RIL_socket_close((uint8_t) sock);
+        desc->Sock = NO_SOCKET;
+        return _fail(RIL_ETIMEDOUT);
+    }
+    switch (RIL_socket_state((uint8_t) sock)){
+        case RIL_SOCKET_OPEN:
+            return 0;
+        case RIL_SOCKET_FAILED:
+            return _fail(RIL_ECONNREFUSED);
+        default:
+            return _fail(RIL_ECONNRESET);
+    }
+}
+
+int32_t RIL_bsd_send(int fd, const void* buff, uint32_t len, int flags){
+    RIL_BsdDesc* desc = _desc(fd);
+    uint32_t done = 0;
+    if (desc == NULL){
+        return _fail(RIL_EBADF);
+    }
+    if (desc->Sock == NO_SOCKET){
+        return _fail(RIL_ENOTCONN);
+    }
+    uint8_t sock = (uint8_t) desc->Sock;
+    for (;;){
+        switch (RIL_socket_state(sock)){
+            case RIL_SOCKET_OPEN:
+                done += (uint32_t) RIL_socket_send(sock, (const uint8_t*) buff + done, len - done);
+                if (done == len){
+                    return (int32_t) len;
+                }
+                break;
+            case RIL_SOCKET_OPENING:
+                break;
+            case RIL_SOCKET_REMOTE_CLOSED:
+                return done > 0 ? (int32_t) done : _fail(RIL_EPIPE);
+            default:
+                return done > 0 ? (int32_t) done : _fail(RIL_ENOTCONN);
+        }
+        // A partial send is a success, like a full kernel buffer
+        if (!_mayWait(desc, flags) ||
+            !_wait(desc, RIL_SOCKET_WRITABLE | RIL_SOCKET_HUP | RIL_SOCKET_ERROR, desc->SndTimeout))
+        {
+            return done > 0 ? (int32_t) done : _fail(RIL_EAGAIN);
+        }
+    }
+}
+
+int32_t RIL_bsd_recv(int fd, void* buff, uint32_t len, int flags){
+    RIL_BsdDesc* desc = _desc(fd);
+    if (desc == NULL){
+        return _fail(RIL_EBADF);
+    }
+    if (desc->Sock == NO_SOCKET){
+        return _fail(RIL_ENOTCONN);
+    }
+    uint8_t sock = (uint8_t) desc->Sock;
+    if (len == 0){
+        return 0;
+    }
+    for (;;){
+        int32_t got = RIL_socket_recv(sock, buff, len);
+        if (got > 0){
+            return got;
+        }
+        if (got < 0){
+            // End of the stream once the data the peer sent is read
+            return RIL_socket_state(sock) == RIL_SOCKET_REMOTE_CLOSED ? 0 : _fail(RIL_ENOTCONN);
+        }
+        if (!_mayWait(desc, flags) ||
+            !_wait(desc, RIL_SOCKET_READABLE | RIL_SOCKET_HUP | RIL_SOCKET_ERROR, desc->RcvTimeout))
+        {
+            return _fail(RIL_EAGAIN);
+        }
+    }
+}
+
+int RIL_bsd_close(int fd){
+    RIL_BsdDesc* desc = _desc(fd);
+    if (desc == NULL){
+        return _fail(RIL_EBADF);
+    }
+    if (desc->Sock != NO_SOCKET){
+        RIL_socket_close((uint8_t) desc->Sock);
+    }
+    desc->Sock = NO_SOCKET;
+    desc->Flags = 0;
+    return 0;
+}
+
+int RIL_bsd_setsockopt(int fd, int level, int name, const void* value, uint32_t len){
+    RIL_BsdDesc* desc = _desc(fd);
+    if (desc == NULL){
+        return _fail(RIL_EBADF);
+    }
+    if (level != RIL_SOL_SOCKET || (name != RIL_SO_RCVTIMEO && name != RIL_SO_SNDTIMEO)){
+        return _fail(RIL_ENOPROTOOPT);
+    }
+    if (value == NULL || len < sizeof(struct RIL_timeval)){
+        return _fail(RIL_EINVAL);
+    }
+    uint32_t timeOut = _timeval((const struct RIL_timeval*) value);
+    if (name == RIL_SO_RCVTIMEO){
+        desc->RcvTimeout = timeOut;
+    }
+    else {
+        desc->SndTimeout = timeOut;
+    }
+    return 0;
+}
+
+int RIL_bsd_getsockopt(int fd, int level, int name, void* value, uint32_t* len){
+    RIL_BsdDesc* desc = _desc(fd);
+    int error = 0;
+    if (desc == NULL){
+        return _fail(RIL_EBADF);
+    }
+    if (level != RIL_SOL_SOCKET || name != RIL_SO_ERROR){
+        return _fail(RIL_ENOPROTOOPT);
+    }
+    if (value == NULL || len == NULL || *len < sizeof(int)){
+        return _fail(RIL_EINVAL);
+    }
+    if (desc->Sock != NO_SOCKET && RIL_socket_state((uint8_t) desc->Sock) == RIL_SOCKET_FAILED){
+        error = RIL_ECONNREFUSED;
+    }
+    *(int*) value = error;
+    *len = sizeof(int);
+    return 0;
+}
+
+int RIL_bsd_fcntl(int fd, int cmd, int arg){
+    RIL_BsdDesc* desc = _desc(fd);
+    if (desc == NULL){
+        return _fail(RIL_EBADF);
+    }
+    switch (cmd){
+        case RIL_F_GETFL:
+            return (desc->Flags & DESC_NONBLOCK) ? RIL_O_NONBLOCK : 0;
+        case RIL_F_SETFL:
+            if (arg & RIL_O_NONBLOCK){
+                desc->Flags |= DESC_NONBLOCK;
+            }
+            else {
+                desc->Flags &= ~DESC_NONBLOCK;
+            }
+            return 0;
+        default:
+            return _fail(RIL_EINVAL);
+    }
+}
+
+int RIL_bsd_poll(struct RIL_pollfd* fds, uint32_t nfds, int timeout){
+    uint32_t start = HAL_GetTick();
+    for (;;){
+        int ready = 0;
+        for (uint32_t i = 0; i < nfds; i++){
+            // Errors and hangups are reported even when not asked for
+            fds[i].revents = (short) (_revents(fds[i].fd) & (fds[i].events | RIL_POLLERR | RIL_POLLHUP | RIL_POLLNVAL));
+            if (fds[i].revents != 0){
+                ready++;
+            }
+        }
+        if (ready > 0 || (timeout >= 0 && HAL_GetTick() - start >= (uint32_t) timeout)){
+            return ready;
+        }
+        RIL_process();
+    }
+}
+
+static RIL_BsdDesc* _desc(int fd){
+    return fd >= 0 && fd < RIL_SOCKET_COUNT && (descs[fd].Flags & DESC_USED) ? &descs[fd] : NULL;
+}
+
+static bool _mayWait(const RIL_BsdDesc* desc, int flags){
+    return !(desc->Flags & DESC_NONBLOCK) && !(flags & RIL_MSG_DONTWAIT);
+}
+
+/**
+ * @brief runs the engine until one of the RIL_SOCKET_* events is true
+ * @return false on timeout
+ */
+static bool _wait(const RIL_BsdDesc* desc, uint8_t events, uint32_t timeOut){
+    uint32_t start = HAL_GetTick();
+    while (!(RIL_socket_events((uint8_t) desc->Sock) & events)){
+        if (timeOut > 0 && HAL_GetTick() - start >= timeOut){
+            return false;
+        }
+        RIL_process();
+    }
+    return true;
+}
+
+static short _revents(int fd){
+    RIL_BsdDesc* desc = _desc(fd);
+    short revents = 0;
+    if (fd < 0){
+        return 0;
+    }
+    if (desc == NULL){
+        return RIL_POLLNVAL;
+    }
+    // Not connected: writable and hung up, as a fresh stream socket on Linux
+    if (desc->Sock == NO_SOCKET){
+        return RIL_POLLOUT | RIL_POLLHUP;
+    }
+    uint8_t events = RIL_socket_events((uint8_t) desc->Sock);
+    if (events & RIL_SOCKET_READABLE){
+        revents |= RIL_POLLIN;
+    }
+    if (events & RIL_SOCKET_WRITABLE){
+        revents |= RIL_POLLOUT;
+    }
+    if (events & RIL_SOCKET_HUP){
+        // recv returns the end of the stream
+        revents |= RIL_POLLIN | RIL_POLLHUP;
+    }
+    if (events & RIL_SOCKET_ERROR){
+        revents |= RIL_POLLERR | RIL_POLLHUP;
+    }
+    return revents;
+}
+
+static uint32_t _timeval(const struct RIL_timeval* tv){
+    uint32_t ms = (uint32_t) tv->tv_sec * 1000 + (uint32_t) tv->tv_usec / 1000;
+    // Less than a millisecond still times out
+    return ms == 0 && tv->tv_usec > 0 ? 1 : ms;
+}
+
+static int _fail(int error){
+    RIL_bsd_errno = error;
+    return -1;
+}
+
+#endif
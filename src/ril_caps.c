@@ -0,0 +1,230 @@
+/**
+ * @file ril_caps.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Modem capability discovery, cached per firmware revision
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_caps.h"
+
+#if RIL_FEATURE_CAPS
+
+#include "ril_store.h"
+#if RIL_FEATURE_VENDOR
+    #include "ril_vendor.h"
+#endif
+#include <stddef.h>
+#include <string.h>
+
+/* Part of RIL_Caps covered by Check */
+#define CAPS_BODY_OFFSET        offsetof(RIL_Caps, Flags)
+#define CAPS_BODY_LEN           (sizeof(RIL_Caps) - CAPS_BODY_OFFSET)
+
+/**
+ * AT+CLAC entry that sets a flag
+ */
+typedef struct {
+    const char*         Name;
+    uint16_t            Flag;
+} RIL_CapCommand;
+
+static const RIL_CapCommand CAP_COMMANDS[] = {
+    { "+CMUX",      RIL_CAP_CMUX },
+    { "+QISEND",    RIL_CAP_BINARY_SEND },
+    { "+CIPSEND",   RIL_CAP_BINARY_SEND },
+    { "+USOWR",     RIL_CAP_BINARY_SEND },
+    { "+QIRD",      RIL_CAP_BUFFERED_RECV },
+    { "+CIPRXGET",  RIL_CAP_BUFFERED_RECV },
+    { "+USORD",     RIL_CAP_BUFFERED_RECV },
+    { "+QIOPEN",    RIL_CAP_PUSH_RECV },
+    { "+QFUPL",     RIL_CAP_FILE_UPLOAD },
+    { "+CFTRANRX",  RIL_CAP_FILE_UPLOAD },
+    { "+UDWNFILE",  RIL_CAP_FILE_UPLOAD },
+    { "+IPR",       RIL_CAP_BAUD },
+    { "+CPSMS",     RIL_CAP_PSM },
+};
+
+/* Flags assumed from the vendor when AT+CLAC is not supported, indexed by RIL_VENDOR_* */
+static const uint32_t VENDOR_DEFAULTS[] = {
+    0,
+    RIL_CAP_BINARY_SEND | RIL_CAP_BUFFERED_RECV | RIL_CAP_PUSH_RECV | RIL_CAP_FILE_UPLOAD | RIL_CAP_CMUX,
+    RIL_CAP_BINARY_SEND | RIL_CAP_BUFFERED_RECV | RIL_CAP_FILE_UPLOAD | RIL_CAP_CMUX,
+    RIL_CAP_BINARY_SEND | RIL_CAP_BUFFERED_RECV | RIL_CAP_FILE_UPLOAD | RIL_CAP_CMUX,
+};
+
+static RIL_Caps caps;
+static bool fromStore;
+static bool valid;
+
+RIL_STATIC_ASSERT(sizeof(caps) + sizeof(fromStore) + sizeof(valid) <= RIL_RAM_CAPS, "RIL_RAM_CAPS under-counts ril_caps.c");
+
+static uint32_t _onFirmware(char* line, uint32_t len, void* userData);
+static uint32_t _onCommand(char* line, uint32_t len, void* userData);
+static uint32_t _onBaud(char* line, uint32_t len, void* userData);
+#if RIL_FEATURE_VENDOR
+static uint32_t _onIdent(char* line, uint32_t len, void* userData);
+#endif
+static uint32_t _check(const RIL_Caps* record);
+static void _discover(void);
+static void _applyVendor(void);
+
+RIL_ATSndError RIL_caps_discover(bool force){
+    char firmware[RIL_CAPS_FIRMWARE_LEN] = { 0 };
+    RIL_ATSndError result = RIL_SendATCmd("AT+CGMR", 7, _onFirmware, firmware, 0);
+    if (result != RIL_AT_SUCCESS){
+        return result;
+    }
+
+    RIL_Caps stored;
+    fromStore = !force && RIL_store_load(RIL_STORE_CAPS, &stored, sizeof(stored)) &&
+                stored.Check == _check(&stored) && strcmp(stored.Firmware, firmware) == 0;
+    if (fromStore){
+        caps = stored;
+    }
+    else {
+        memset(&caps, 0, sizeof(caps));
+        memcpy(caps.Firmware, firmware, sizeof(firmware));
+        _discover();
+        caps.Check = _check(&caps);
+        RIL_store_save(RIL_STORE_CAPS, &caps, sizeof(caps));
+    }
+    valid = true;
+    _applyVendor();
+    return RIL_AT_SUCCESS;
+}
+
+const RIL_Caps* RIL_caps(void){
+    return &caps;
+}
+
+bool RIL_caps_valid(void){
+    return valid;
+}
+
+bool RIL_caps_has(uint32_t flags){
+    return (caps.Flags & flags) == flags;
+}
+
+bool RIL_caps_fromStore(void){
+    return fromStore;
+}
+
+bool RIL_caps_restore(const RIL_Caps* record){
+    if (record->Check != _check(record)){
+        return false;
+    }
+    caps = *record;
+    fromStore = valid = true;
+    _applyVendor();
+    return true;
+}
+
+/**
+ * @brief runs the discovery commands, a command the modem rejects leaves its flags clear
+ */
+static void _discover(void){
+#if RIL_FEATURE_VENDOR
+    RIL_SendATCmd("ATI", 3, _onIdent, &caps, 0);
+#endif
+    if (RIL_SendATCmd("AT+CLAC", 7, _onCommand, &caps, 0) == RIL_AT_SUCCESS){
+        caps.Flags |= RIL_CAP_CLAC;
+    }
+    else if (caps.Vendor < sizeof(VENDOR_DEFAULTS) / sizeof(VENDOR_DEFAULTS[0])){
+        caps.Flags |= VENDOR_DEFAULTS[caps.Vendor];
+    }
+    if (RIL_SendATCmd("AT+IPR=?", 8, _onBaud, &caps, 0) == RIL_AT_SUCCESS && caps.MaxBaud != 0){
+        caps.Flags |= RIL_CAP_BAUD;
+    }
+    // Two harmless queries on one line, a modem without V.250 concatenation answers ERROR
+    if (RIL_SendATCmd("AT+CMEE?;+CSCS?", 15, NULL, NULL, 0) == RIL_AT_SUCCESS){
+        caps.Flags |= RIL_CAP_COMPOUND;
+    }
+}
+
+/**
+ * @brief lets the vendor of the record pick the profile, unless one is selected already
+ */
+static void _applyVendor(void){
+#if RIL_FEATURE_VENDOR && RIL_VENDOR == RIL_VENDOR_AUTO
+    if (RIL_vendor() == NULL){
+        RIL_vendor_set(RIL_vendor_byId(caps.Vendor));
+    }
+#endif
+}
+
+static uint32_t _check(const RIL_Caps* record){
+    return RIL_hash(RIL_HASH_INIT, (const uint8_t*) record + CAPS_BODY_OFFSET, CAPS_BODY_LEN);
+}
+
+/**
+ * @brief keeps the first line, "Revision: " included when the modem sends it
+ */
+static uint32_t _onFirmware(char* line, uint32_t len, void* userData){
+    char* firmware = (char*) userData;
+    if (firmware[0] == 0 && len > 0){
+        if (len > RIL_CAPS_FIRMWARE_LEN - 1){
+            len = RIL_CAPS_FIRMWARE_LEN - 1;
+        }
+        memcpy(firmware, line, len);
+        firmware[len] = 0;
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+
+/**
+ * @brief one AT+CLAC line, "AT+CMUX" or "+CMUX" depending on the vendor
+ */
+static uint32_t _onCommand(char* line, uint32_t len, void* userData){
+    RIL_Caps* record = (RIL_Caps*) userData;
+    if (len >= 2 && line[0] == 'A' && line[1] == 'T'){
+        line += 2;
+        len -= 2;
+    }
+    while (len > 0 && line[len - 1] == ' '){
+        len--;
+    }
+    for (uint8_t i = 0; i < sizeof(CAP_COMMANDS) / sizeof(CAP_COMMANDS[0]); i++){
+        if (strlen(CAP_COMMANDS[i].Name) == len && memcmp(CAP_COMMANDS[i].Name, line, len) == 0){
+            record->Flags |= CAP_COMMANDS[i].Flag;
+            break;
+        }
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+
+/**
+ * @brief +IPR: (list of auto-detectable rates),(list of fixed rates), keeps the highest
+ */
+static uint32_t _onBaud(char* line, uint32_t len, void* userData){
+    RIL_Caps* record = (RIL_Caps*) userData;
+    uint32_t value = 0;
+    for (uint32_t i = 0; i <= len; i++){
+        if (i < len && line[i] >= '0' && line[i] <= '9'){
+            value = value * 10 + (uint32_t) (line[i] - '0');
+        }
+        else {
+            if (value > record->MaxBaud){
+                record->MaxBaud = value;
+            }
+            value = 0;
+        }
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+
+#if RIL_FEATURE_VENDOR
+static uint32_t _onIdent(char* line, uint32_t len, void* userData){
+    RIL_Caps* record = (RIL_Caps*) userData;
+    const RIL_VendorProfile* profile = RIL_vendor_match(line, len);
+    if (record->Vendor == RIL_VENDOR_AUTO && profile != NULL){
+        record->Vendor = profile->Id;
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+#endif
+
+#endif
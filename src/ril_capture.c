@@ -0,0 +1,71 @@
+/**
+ * @file ril_capture.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Whole-response capture into a caller provided arena
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_capture.h"
+#include <string.h>
+
+#if RIL_FEATURE_CAPTURE
+
+void RIL_capture_init(RIL_Capture* capture, char* arena, uint16_t arenaSize, RIL_LineSpan* lines, uint16_t maxLines){
+    capture->Arena = arena;
+    capture->ArenaSize = arenaSize;
+    capture->Lines = lines;
+    capture->MaxLines = maxLines;
+    capture->ArenaUsed = 0;
+    capture->LineCount = 0;
+    capture->Truncated = 0;
+    capture->Result = RIL_AT_SUCCESS;
+    capture->ErrCode = 0;
+}
+
+uint32_t RIL_capture_callback(char* line, uint32_t len, void* userData){
+    RIL_Capture* capture = (RIL_Capture*) userData;
+
+    // The line and its null terminator must both fit
+    if (capture->LineCount >= capture->MaxLines || (uint32_t) (capture->ArenaSize - capture->ArenaUsed) < len + 1){
+        capture->Truncated = 1;
+        return RIL_AT_RSP_CONTINUE;
+    }
+
+    RIL_LineSpan* span = &capture->Lines[capture->LineCount++];
+    span->Offset = capture->ArenaUsed;
+    span->Len = (uint16_t) len;
+    memcpy(&capture->Arena[span->Offset], line, len);
+    capture->Arena[span->Offset + len] = 0;
+    capture->ArenaUsed += (uint16_t) (len + 1);
+
+    return RIL_AT_RSP_CONTINUE;
+}
+
+RIL_ATSndError RIL_SendATCmdCapture(const char* atCmd, uint32_t atCmdLen, RIL_Capture* capture, uint32_t timeOut){
+    capture->ArenaUsed = 0;
+    capture->LineCount = 0;
+    capture->Truncated = 0;
+    capture->ErrCode = 0;
+
+    capture->Result = RIL_SendATCmd(atCmd, atCmdLen, RIL_capture_callback, capture, timeOut);
+    if (capture->Result == RIL_AT_FAILED){
+        capture->ErrCode = Ql_RIL_AT_GetErrCode().atError;
+    }
+    return capture->Result;
+}
+
+const char* RIL_capture_line(const RIL_Capture* capture, uint16_t index, uint32_t* len){
+    if (index >= capture->LineCount){
+        return NULL;
+    }
+    if (len != NULL){
+        *len = capture->Lines[index].Len;
+    }
+    return &capture->Arena[capture->Lines[index].Offset];
+}
+
+#endif
@@ -0,0 +1,274 @@
+/**
+ * @file ril_cmd.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Generated AT command bindings: timeouts, retries, response cache
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_cmd.h"
+#include <string.h>
+
+static const char* _skipSpaces(const char* pos, const char* end);
+
+#if RIL_FEATURE_COMMANDS
+/**
+ * State of the line callback while one command runs
+ */
+typedef struct {
+    const RIL_CmdInfo*  Info;
+    void*               Rsp;
+    int32_t             Status;
+} RIL_CmdLine;
+
+static uint32_t cacheStamp[RIL_CMD_COUNT];
+static bool cacheValid[RIL_CMD_COUNT];
+static int32_t parseStatus = RIL_CMD_PARSE_OK;
+
+RIL_STATIC_ASSERT(RIL_CMD_CACHE_SIZE + sizeof(cacheStamp) + sizeof(cacheValid) + sizeof(parseStatus) <= RIL_RAM_COMMANDS,
+                  "RIL_RAM_COMMANDS under-counts the response cache");
+
+static uint32_t _onLine(char* line, uint32_t len, void* userData);
+
+RIL_ATSndError RIL_cmd_exec(RIL_CmdId id, const char* cmd, uint32_t cmdLen, void* rsp){
+    if (id >= RIL_CMD_COUNT){
+        return RIL_AT_INVALID_PARAM;
+    }
+    const RIL_CmdInfo* info = &RIL_CMD_TABLE[id];
+
+    if (info->Cache != NULL && cacheValid[id] && HAL_GetTick() - cacheStamp[id] < info->CacheAge){
+        if (rsp != NULL){
+            memcpy(rsp, info->Cache, info->RspSize);
+        }
+        return RIL_AT_SUCCESS;
+    }
+
+    RIL_CmdLine ctx = {
+        .Info = info,
+        .Rsp = rsp != NULL ? rsp : info->Cache,
+    };
+    RIL_ATSndError result;
+    uint8_t attempts = info->Retry + 1;
+    do {
+        ctx.Status = RIL_CMD_PARSE_NO_LINE;
+        result = RIL_SendATCmd(cmd, cmdLen, info->Parse != NULL && ctx.Rsp != NULL ? _onLine : NULL, &ctx, info->TimeOut);
+    } while (--attempts > 0 &&
+             (result == RIL_AT_TIMEOUT || (result == RIL_AT_FAILED && (info->Flags & RIL_CMD_RETRY_ON_ERROR))));
+
+    parseStatus = ctx.Status;
+    if (result != RIL_AT_SUCCESS || info->Parse == NULL || ctx.Rsp == NULL){
+        return result;
+    }
+    if (ctx.Status != RIL_CMD_PARSE_OK){
+        return RIL_AT_FAILED;
+    }
+    if (info->Cache != NULL){
+        if (ctx.Rsp != info->Cache){
+            memcpy(info->Cache, ctx.Rsp, info->RspSize);
+        }
+        cacheStamp[id] = HAL_GetTick();
+        cacheValid[id] = true;
+    }
+    return RIL_AT_SUCCESS;
+}
+
+void RIL_cmd_invalidate(RIL_CmdId id){
+    if (id < RIL_CMD_COUNT){
+        cacheValid[id] = false;
+    }
+    else {
+        memset(cacheValid, 0, sizeof(cacheValid));
+    }
+}
+
+int32_t RIL_cmd_parseStatus(void){
+    return parseStatus;
+}
+
+#if RIL_FEATURE_SESSION
+/* Cache entry in the session blob: id, response size, age in ms, response */
+#define CACHE_ENTRY_HEADER      7
+
+uint32_t RIL_cmd_suspend(uint8_t* out, uint32_t size){
+    uint32_t now = HAL_GetTick();
+    uint32_t len = 0;
+    for (uint8_t id = 0; id < RIL_CMD_COUNT; id++){
+        const RIL_CmdInfo* info = &RIL_CMD_TABLE[id];
+        uint32_t age = now - cacheStamp[id];
+        if (!cacheValid[id] || age >= info->CacheAge || len + CACHE_ENTRY_HEADER + info->RspSize > size){
+            continue;
+        }
+        out[len] = id;
+        memcpy(&out[len + 1], &info->RspSize, sizeof(uint16_t));
+        memcpy(&out[len + 3], &age, sizeof(uint32_t));
+        memcpy(&out[len + CACHE_ENTRY_HEADER], info->Cache, info->RspSize);
+        len += CACHE_ENTRY_HEADER + info->RspSize;
+    }
+    return len;
+}
+
+void RIL_cmd_resume(const uint8_t* data, uint32_t len, uint32_t sleptMs){
+    uint32_t now = HAL_GetTick();
+    uint32_t pos = 0;
+    memset(cacheValid, 0, sizeof(cacheValid));
+    while (pos + CACHE_ENTRY_HEADER <= len){
+        uint8_t id = data[pos];
+        uint16_t rspSize;
+        uint32_t age;
+        memcpy(&rspSize, &data[pos + 1], sizeof(uint16_t));
+        memcpy(&age, &data[pos + 3], sizeof(uint32_t));
+        if (pos + CACHE_ENTRY_HEADER + rspSize > len){
+            break;
+        }
+        // A response of another size comes from another build of the table
+        if (id < RIL_CMD_COUNT && RIL_CMD_TABLE[id].Cache != NULL && RIL_CMD_TABLE[id].RspSize == rspSize &&
+            age + sleptMs >= age && age + sleptMs < RIL_CMD_TABLE[id].CacheAge)
+        {
+            memcpy(RIL_CMD_TABLE[id].Cache, &data[pos + CACHE_ENTRY_HEADER], rspSize);
+            cacheStamp[id] = now - (age + sleptMs);
+            cacheValid[id] = true;
+        }
+        pos += CACHE_ENTRY_HEADER + rspSize;
+    }
+}
+#endif
+
+#endif
+
+char* RIL_cmd_putUint(char* pos, uint32_t value){
+    char digits[10];
+    uint8_t len = 0;
+    do {
+        digits[len++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (len > 0){
+        *pos++ = digits[--len];
+    }
+    return pos;
+}
+
+char* RIL_cmd_putInt(char* pos, int32_t value){
+    if (value < 0){
+        *pos++ = '-';
+        return RIL_cmd_putUint(pos, 0U - (uint32_t) value);
+    }
+    return RIL_cmd_putUint(pos, (uint32_t) value);
+}
+
+char* RIL_cmd_putStr(char* pos, const char* str, uint32_t max){
+    while (*str != 0){
+        if (max-- == 0){
+            return NULL;
+        }
+        *pos++ = *str++;
+    }
+    return pos;
+}
+
+bool RIL_cmd_nextField(const char** pos, const char* end){
+    if (*pos == end || **pos != ','){
+        return false;
+    }
+    (*pos)++;
+    return true;
+}
+
+bool RIL_cmd_fieldEmpty(const char* pos, const char* end){
+    pos = _skipSpaces(pos, end);
+    return pos == end || *pos == ',';
+}
+
+bool RIL_cmd_parseInt(const char** pos, const char* end, int32_t* value){
+    const char* p = _skipSpaces(*pos, end);
+    bool negative = p != end && *p == '-';
+    uint32_t magnitude;
+    if (p != end && (*p == '-' || *p == '+')){
+        p++;
+    }
+    if (!RIL_cmd_parseUint(&p, end, &magnitude) || magnitude > (negative ? 0x80000000UL : 0x7FFFFFFFUL)){
+        return false;
+    }
+    *value = negative ? (int32_t) (0U - magnitude) : (int32_t) magnitude;
+    *pos = p;
+    return true;
+}
+
+bool RIL_cmd_parseUint(const char** pos, const char* end, uint32_t* value){
+    const char* p = _skipSpaces(*pos, end);
+    const char* digits = p;
+    uint32_t result = 0;
+    while (p != end && *p >= '0' && *p <= '9'){
+        if (result > (0xFFFFFFFFUL - 9) / 10){
+            return false;
+        }
+        result = result * 10 + (uint32_t) (*p++ - '0');
+    }
+    p = _skipSpaces(p, end);
+    if (p == digits || (p != end && *p != ',')){
+        return false;
+    }
+    *value = result;
+    *pos = p;
+    return true;
+}
+
+bool RIL_cmd_parseStr(const char** pos, const char* end, char* out, uint32_t size){
+    const char* p = _skipSpaces(*pos, end);
+    const char* start = p;
+    const char* stop;
+    if (p != end && *p == '"'){
+        start = p + 1;
+        stop = (const char*) memchr(start, '"', end - start);
+        if (stop == NULL){
+            return false;
+        }
+        p = _skipSpaces(stop + 1, end);
+        if (p != end && *p != ','){
+            return false;
+        }
+    }
+    else {
+        stop = (const char*) memchr(start, ',', end - start);
+        if (stop == NULL){
+            stop = end;
+        }
+        p = stop;
+    }
+    uint32_t len = (uint32_t) (stop - start);
+    if (len > size - 1){
+        len = size - 1;
+    }
+    memcpy(out, start, len);
+    out[len] = 0;
+    *pos = p;
+    return true;
+}
+
+#if RIL_FEATURE_COMMANDS
+/**
+ * @brief decodes the first line with the prefix of the command, a bad line fails the command
+ */
+static uint32_t _onLine(char* line, uint32_t len, void* userData){
+    RIL_CmdLine* ctx = (RIL_CmdLine*) userData;
+    const RIL_CmdInfo* info = ctx->Info;
+
+    if (ctx->Status != RIL_CMD_PARSE_NO_LINE || len < info->PrefixLen ||
+        memcmp(line, info->Prefix, info->PrefixLen) != 0)
+    {
+        return RIL_AT_RSP_CONTINUE;
+    }
+    ctx->Status = info->Parse(line + info->PrefixLen, line + len, ctx->Rsp);
+    return ctx->Status == RIL_CMD_PARSE_OK ? RIL_AT_RSP_CONTINUE : (uint32_t) RIL_AT_RSP_FAILED;
+}
+#endif
+
+static const char* _skipSpaces(const char* pos, const char* end){
+    while (pos != end && *pos == ' '){
+        pos++;
+    }
+    return pos;
+}
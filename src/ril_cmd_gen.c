@@ -0,0 +1,749 @@
+/**
+ * @file ril_cmd_gen.c
+ * @brief Generated by tools/ril_cmdgen.py from tools/ril_commands.json, do not edit.
+ */
+
+#include "ril_cmd.h"
+
+#if RIL_FEATURE_COMMANDS
+
+#include <string.h>
+
+static RIL_CSQ_Response csqCache;
+static RIL_CREG_Response cregCache;
+static RIL_CGREG_Response cgregCache;
+static RIL_CEREG_Response ceregCache;
+static RIL_COPS_Response copsCache;
+static RIL_CGMI_Response cgmiCache;
+static RIL_CGMM_Response cgmmCache;
+static RIL_CGMR_Response cgmrCache;
+static RIL_CGSN_Response cgsnCache;
+
+uint32_t RIL_AT_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_AT_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT", 2);
+    pos += 2;
+    return (uint32_t) (pos - buff);
+}
+
+RIL_ATSndError RIL_AT_send(void){
+    return RIL_cmd_exec(RIL_CMD_AT, "AT", 2, NULL);
+}
+
+uint32_t RIL_CSQ_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CSQ_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CSQ", 6);
+    pos += 6;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CSQ_fields(const char* pos, const char* end, void* out){
+    RIL_CSQ_Response* rsp = (RIL_CSQ_Response*) out;
+    if (!RIL_cmd_parseInt(&pos, end, &rsp->Rssi)){
+        return 0;
+    }
+    if (!RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseInt(&pos, end, &rsp->Ber)){
+        return 1;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CSQ_parse(const char* line, uint32_t len, RIL_CSQ_Response* rsp){
+    if (len < 5 || memcmp(line, "+CSQ:", 5) != 0){
+        return RIL_CMD_PARSE_NO_LINE;
+    }
+    return _CSQ_fields(line + 5, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CSQ_send(RIL_CSQ_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CSQ, "AT+CSQ", 6, rsp);
+}
+
+uint32_t RIL_CREG_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CREG_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CREG?", 8);
+    pos += 8;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CREG_fields(const char* pos, const char* end, void* out){
+    RIL_CREG_Response* rsp = (RIL_CREG_Response*) out;
+    rsp->Present = 0;
+    if (!RIL_cmd_parseUint(&pos, end, &rsp->N)){
+        return 0;
+    }
+    if (!RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseUint(&pos, end, &rsp->Stat)){
+        return 1;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseStr(&pos, end, rsp->Lac, sizeof(rsp->Lac))){
+            return 2;
+        }
+        rsp->Present |= 1U << 2;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseStr(&pos, end, rsp->Ci, sizeof(rsp->Ci))){
+            return 3;
+        }
+        rsp->Present |= 1U << 3;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CREG_parse(const char* line, uint32_t len, RIL_CREG_Response* rsp){
+    if (len < 6 || memcmp(line, "+CREG:", 6) != 0){
+        return RIL_CMD_PARSE_NO_LINE;
+    }
+    return _CREG_fields(line + 6, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CREG_send(RIL_CREG_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CREG, "AT+CREG?", 8, rsp);
+}
+
+uint32_t RIL_CGREG_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CGREG_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CGREG?", 9);
+    pos += 9;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CGREG_fields(const char* pos, const char* end, void* out){
+    RIL_CGREG_Response* rsp = (RIL_CGREG_Response*) out;
+    rsp->Present = 0;
+    if (!RIL_cmd_parseUint(&pos, end, &rsp->N)){
+        return 0;
+    }
+    if (!RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseUint(&pos, end, &rsp->Stat)){
+        return 1;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseStr(&pos, end, rsp->Lac, sizeof(rsp->Lac))){
+            return 2;
+        }
+        rsp->Present |= 1U << 2;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseStr(&pos, end, rsp->Ci, sizeof(rsp->Ci))){
+            return 3;
+        }
+        rsp->Present |= 1U << 3;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CGREG_parse(const char* line, uint32_t len, RIL_CGREG_Response* rsp){
+    if (len < 7 || memcmp(line, "+CGREG:", 7) != 0){
+        return RIL_CMD_PARSE_NO_LINE;
+    }
+    return _CGREG_fields(line + 7, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CGREG_send(RIL_CGREG_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CGREG, "AT+CGREG?", 9, rsp);
+}
+
+uint32_t RIL_CEREG_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CEREG_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CEREG?", 9);
+    pos += 9;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CEREG_fields(const char* pos, const char* end, void* out){
+    RIL_CEREG_Response* rsp = (RIL_CEREG_Response*) out;
+    rsp->Present = 0;
+    if (!RIL_cmd_parseUint(&pos, end, &rsp->N)){
+        return 0;
+    }
+    if (!RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseUint(&pos, end, &rsp->Stat)){
+        return 1;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseStr(&pos, end, rsp->Tac, sizeof(rsp->Tac))){
+            return 2;
+        }
+        rsp->Present |= 1U << 2;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseStr(&pos, end, rsp->Ci, sizeof(rsp->Ci))){
+            return 3;
+        }
+        rsp->Present |= 1U << 3;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CEREG_parse(const char* line, uint32_t len, RIL_CEREG_Response* rsp){
+    if (len < 7 || memcmp(line, "+CEREG:", 7) != 0){
+        return RIL_CMD_PARSE_NO_LINE;
+    }
+    return _CEREG_fields(line + 7, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CEREG_send(RIL_CEREG_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CEREG, "AT+CEREG?", 9, rsp);
+}
+
+uint32_t RIL_COPS_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_COPS_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+COPS?", 8);
+    pos += 8;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _COPS_fields(const char* pos, const char* end, void* out){
+    RIL_COPS_Response* rsp = (RIL_COPS_Response*) out;
+    rsp->Present = 0;
+    if (!RIL_cmd_parseUint(&pos, end, &rsp->Mode)){
+        return 0;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseUint(&pos, end, &rsp->Format)){
+            return 1;
+        }
+        rsp->Present |= 1U << 1;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseStr(&pos, end, rsp->Oper, sizeof(rsp->Oper))){
+            return 2;
+        }
+        rsp->Present |= 1U << 2;
+    }
+    if (RIL_cmd_nextField(&pos, end) && !RIL_cmd_fieldEmpty(pos, end)){
+        if (!RIL_cmd_parseUint(&pos, end, &rsp->Act)){
+            return 3;
+        }
+        rsp->Present |= 1U << 3;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_COPS_parse(const char* line, uint32_t len, RIL_COPS_Response* rsp){
+    if (len < 6 || memcmp(line, "+COPS:", 6) != 0){
+        return RIL_CMD_PARSE_NO_LINE;
+    }
+    return _COPS_fields(line + 6, line + len, rsp);
+}
+
+RIL_ATSndError RIL_COPS_send(RIL_COPS_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_COPS, "AT+COPS?", 8, rsp);
+}
+
+uint32_t RIL_CPIN_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CPIN_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CPIN?", 8);
+    pos += 8;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CPIN_fields(const char* pos, const char* end, void* out){
+    RIL_CPIN_Response* rsp = (RIL_CPIN_Response*) out;
+    if (!RIL_cmd_parseStr(&pos, end, rsp->Code, sizeof(rsp->Code))){
+        return 0;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CPIN_parse(const char* line, uint32_t len, RIL_CPIN_Response* rsp){
+    if (len < 6 || memcmp(line, "+CPIN:", 6) != 0){
+        return RIL_CMD_PARSE_NO_LINE;
+    }
+    return _CPIN_fields(line + 6, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CPIN_send(RIL_CPIN_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CPIN, "AT+CPIN?", 8, rsp);
+}
+
+uint32_t RIL_CGMI_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CGMI_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CGMI", 7);
+    pos += 7;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CGMI_fields(const char* pos, const char* end, void* out){
+    RIL_CGMI_Response* rsp = (RIL_CGMI_Response*) out;
+    if (!RIL_cmd_parseStr(&pos, end, rsp->Manufacturer, sizeof(rsp->Manufacturer))){
+        return 0;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CGMI_parse(const char* line, uint32_t len, RIL_CGMI_Response* rsp){
+    return _CGMI_fields(line + 0, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CGMI_send(RIL_CGMI_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CGMI, "AT+CGMI", 7, rsp);
+}
+
+uint32_t RIL_CGMM_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CGMM_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CGMM", 7);
+    pos += 7;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CGMM_fields(const char* pos, const char* end, void* out){
+    RIL_CGMM_Response* rsp = (RIL_CGMM_Response*) out;
+    if (!RIL_cmd_parseStr(&pos, end, rsp->Model, sizeof(rsp->Model))){
+        return 0;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CGMM_parse(const char* line, uint32_t len, RIL_CGMM_Response* rsp){
+    return _CGMM_fields(line + 0, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CGMM_send(RIL_CGMM_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CGMM, "AT+CGMM", 7, rsp);
+}
+
+uint32_t RIL_CGMR_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CGMR_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CGMR", 7);
+    pos += 7;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CGMR_fields(const char* pos, const char* end, void* out){
+    RIL_CGMR_Response* rsp = (RIL_CGMR_Response*) out;
+    if (!RIL_cmd_parseStr(&pos, end, rsp->Revision, sizeof(rsp->Revision))){
+        return 0;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CGMR_parse(const char* line, uint32_t len, RIL_CGMR_Response* rsp){
+    return _CGMR_fields(line + 0, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CGMR_send(RIL_CGMR_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CGMR, "AT+CGMR", 7, rsp);
+}
+
+uint32_t RIL_CGSN_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CGSN_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CGSN", 7);
+    pos += 7;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CGSN_fields(const char* pos, const char* end, void* out){
+    RIL_CGSN_Response* rsp = (RIL_CGSN_Response*) out;
+    if (!RIL_cmd_parseStr(&pos, end, rsp->Imei, sizeof(rsp->Imei))){
+        return 0;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CGSN_parse(const char* line, uint32_t len, RIL_CGSN_Response* rsp){
+    return _CGSN_fields(line + 0, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CGSN_send(RIL_CGSN_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CGSN, "AT+CGSN", 7, rsp);
+}
+
+uint32_t RIL_CIMI_build(char* buff, uint32_t size){
+    char* pos = buff;
+    if (size < RIL_CIMI_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CIMI", 7);
+    pos += 7;
+    return (uint32_t) (pos - buff);
+}
+
+static int32_t _CIMI_fields(const char* pos, const char* end, void* out){
+    RIL_CIMI_Response* rsp = (RIL_CIMI_Response*) out;
+    if (!RIL_cmd_parseStr(&pos, end, rsp->Imsi, sizeof(rsp->Imsi))){
+        return 0;
+    }
+    return RIL_CMD_PARSE_OK;
+}
+
+int32_t RIL_CIMI_parse(const char* line, uint32_t len, RIL_CIMI_Response* rsp){
+    return _CIMI_fields(line + 0, line + len, rsp);
+}
+
+RIL_ATSndError RIL_CIMI_send(RIL_CIMI_Response* rsp){
+    return RIL_cmd_exec(RIL_CMD_CIMI, "AT+CIMI", 7, rsp);
+}
+
+uint32_t RIL_CFUN_SET_build(char* buff, uint32_t size, uint32_t fun){
+    char* pos = buff;
+    if (size < RIL_CFUN_SET_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CFUN=", 8);
+    pos += 8;
+    pos = RIL_cmd_putUint(pos, fun);
+    return (uint32_t) (pos - buff);
+}
+
+RIL_ATSndError RIL_CFUN_SET_send(uint32_t fun){
+    char cmd[RIL_CFUN_SET_MAX_LEN];
+    uint32_t len = RIL_CFUN_SET_build(cmd, sizeof(cmd), fun);
+    if (len == 0){
+        return RIL_AT_INVALID_PARAM;
+    }
+    return RIL_cmd_exec(RIL_CMD_CFUN_SET, cmd, len, NULL);
+}
+
+uint32_t RIL_CGATT_SET_build(char* buff, uint32_t size, uint32_t state){
+    char* pos = buff;
+    if (size < RIL_CGATT_SET_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+CGATT=", 9);
+    pos += 9;
+    pos = RIL_cmd_putUint(pos, state);
+    return (uint32_t) (pos - buff);
+}
+
+RIL_ATSndError RIL_CGATT_SET_send(uint32_t state){
+    char cmd[RIL_CGATT_SET_MAX_LEN];
+    uint32_t len = RIL_CGATT_SET_build(cmd, sizeof(cmd), state);
+    if (len == 0){
+        return RIL_AT_INVALID_PARAM;
+    }
+    return RIL_cmd_exec(RIL_CMD_CGATT_SET, cmd, len, NULL);
+}
+
+uint32_t RIL_QIACT_build(char* buff, uint32_t size, uint32_t contextId){
+    char* pos = buff;
+    if (size < RIL_QIACT_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+QIACT=", 9);
+    pos += 9;
+    pos = RIL_cmd_putUint(pos, contextId);
+    return (uint32_t) (pos - buff);
+}
+
+RIL_ATSndError RIL_QIACT_send(uint32_t contextId){
+    char cmd[RIL_QIACT_MAX_LEN];
+    uint32_t len = RIL_QIACT_build(cmd, sizeof(cmd), contextId);
+    if (len == 0){
+        return RIL_AT_INVALID_PARAM;
+    }
+    return RIL_cmd_exec(RIL_CMD_QIACT, cmd, len, NULL);
+}
+
+uint32_t RIL_QIDEACT_build(char* buff, uint32_t size, uint32_t contextId){
+    char* pos = buff;
+    if (size < RIL_QIDEACT_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+QIDEACT=", 11);
+    pos += 11;
+    pos = RIL_cmd_putUint(pos, contextId);
+    return (uint32_t) (pos - buff);
+}
+
+RIL_ATSndError RIL_QIDEACT_send(uint32_t contextId){
+    char cmd[RIL_QIDEACT_MAX_LEN];
+    uint32_t len = RIL_QIDEACT_build(cmd, sizeof(cmd), contextId);
+    if (len == 0){
+        return RIL_AT_INVALID_PARAM;
+    }
+    return RIL_cmd_exec(RIL_CMD_QIDEACT, cmd, len, NULL);
+}
+
+uint32_t RIL_QIOPEN_build(char* buff, uint32_t size, uint32_t contextId, uint32_t connectId, const char* service, const char* host, uint32_t port){
+    char* pos = buff;
+    if (size < RIL_QIOPEN_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+QIOPEN=", 10);
+    pos += 10;
+    pos = RIL_cmd_putUint(pos, contextId);
+    memcpy(pos, ",", 1);
+    pos += 1;
+    pos = RIL_cmd_putUint(pos, connectId);
+    memcpy(pos, ",\"", 2);
+    pos += 2;
+    if ((pos = RIL_cmd_putStr(pos, service, 11)) == NULL){
+        return 0;
+    }
+    memcpy(pos, "\",\"", 3);
+    pos += 3;
+    if ((pos = RIL_cmd_putStr(pos, host, 64)) == NULL){
+        return 0;
+    }
+    memcpy(pos, "\",", 2);
+    pos += 2;
+    pos = RIL_cmd_putUint(pos, port);
+    memcpy(pos, ",0,1", 4);
+    pos += 4;
+    return (uint32_t) (pos - buff);
+}
+
+RIL_ATSndError RIL_QIOPEN_send(uint32_t contextId, uint32_t connectId, const char* service, const char* host, uint32_t port){
+    char cmd[RIL_QIOPEN_MAX_LEN];
+    uint32_t len = RIL_QIOPEN_build(cmd, sizeof(cmd), contextId, connectId, service, host, port);
+    if (len == 0){
+        return RIL_AT_INVALID_PARAM;
+    }
+    return RIL_cmd_exec(RIL_CMD_QIOPEN, cmd, len, NULL);
+}
+
+uint32_t RIL_QICLOSE_build(char* buff, uint32_t size, uint32_t connectId){
+    char* pos = buff;
+    if (size < RIL_QICLOSE_MAX_LEN){
+        return 0;
+    }
+    memcpy(pos, "AT+QICLOSE=", 11);
+    pos += 11;
+    pos = RIL_cmd_putUint(pos, connectId);
+    return (uint32_t) (pos - buff);
+}
+
+RIL_ATSndError RIL_QICLOSE_send(uint32_t connectId){
+    char cmd[RIL_QICLOSE_MAX_LEN];
+    uint32_t len = RIL_QICLOSE_build(cmd, sizeof(cmd), connectId);
+    if (len == 0){
+        return RIL_AT_INVALID_PARAM;
+    }
+    return RIL_cmd_exec(RIL_CMD_QICLOSE, cmd, len, NULL);
+}
+
+const RIL_CmdInfo RIL_CMD_TABLE[RIL_CMD_COUNT] = {
+    [RIL_CMD_AT] = {
+        .Prefix = NULL,
+        .Parse = NULL,
+        .Cache = NULL,
+        .TimeOut = 300,
+        .CacheAge = 0,
+        .RspSize = 0,
+        .PrefixLen = 0,
+        .Retry = 2,
+        .Flags = 0,
+    },
+    [RIL_CMD_CSQ] = {
+        .Prefix = "+CSQ:",
+        .Parse = _CSQ_fields,
+        .Cache = &csqCache,
+        .TimeOut = 300,
+        .CacheAge = 2000,
+        .RspSize = sizeof(RIL_CSQ_Response),
+        .PrefixLen = 5,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CREG] = {
+        .Prefix = "+CREG:",
+        .Parse = _CREG_fields,
+        .Cache = &cregCache,
+        .TimeOut = 300,
+        .CacheAge = 1000,
+        .RspSize = sizeof(RIL_CREG_Response),
+        .PrefixLen = 6,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CGREG] = {
+        .Prefix = "+CGREG:",
+        .Parse = _CGREG_fields,
+        .Cache = &cgregCache,
+        .TimeOut = 300,
+        .CacheAge = 1000,
+        .RspSize = sizeof(RIL_CGREG_Response),
+        .PrefixLen = 7,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CEREG] = {
+        .Prefix = "+CEREG:",
+        .Parse = _CEREG_fields,
+        .Cache = &ceregCache,
+        .TimeOut = 300,
+        .CacheAge = 1000,
+        .RspSize = sizeof(RIL_CEREG_Response),
+        .PrefixLen = 7,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_COPS] = {
+        .Prefix = "+COPS:",
+        .Parse = _COPS_fields,
+        .Cache = &copsCache,
+        .TimeOut = 180000,
+        .CacheAge = 5000,
+        .RspSize = sizeof(RIL_COPS_Response),
+        .PrefixLen = 6,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CPIN] = {
+        .Prefix = "+CPIN:",
+        .Parse = _CPIN_fields,
+        .Cache = NULL,
+        .TimeOut = 5000,
+        .CacheAge = 0,
+        .RspSize = sizeof(RIL_CPIN_Response),
+        .PrefixLen = 6,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CGMI] = {
+        .Prefix = "",
+        .Parse = _CGMI_fields,
+        .Cache = &cgmiCache,
+        .TimeOut = 300,
+        .CacheAge = 3600000,
+        .RspSize = sizeof(RIL_CGMI_Response),
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CGMM] = {
+        .Prefix = "",
+        .Parse = _CGMM_fields,
+        .Cache = &cgmmCache,
+        .TimeOut = 300,
+        .CacheAge = 3600000,
+        .RspSize = sizeof(RIL_CGMM_Response),
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CGMR] = {
+        .Prefix = "",
+        .Parse = _CGMR_fields,
+        .Cache = &cgmrCache,
+        .TimeOut = 300,
+        .CacheAge = 3600000,
+        .RspSize = sizeof(RIL_CGMR_Response),
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CGSN] = {
+        .Prefix = "",
+        .Parse = _CGSN_fields,
+        .Cache = &cgsnCache,
+        .TimeOut = 300,
+        .CacheAge = 3600000,
+        .RspSize = sizeof(RIL_CGSN_Response),
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CIMI] = {
+        .Prefix = "",
+        .Parse = _CIMI_fields,
+        .Cache = NULL,
+        .TimeOut = 5000,
+        .CacheAge = 0,
+        .RspSize = sizeof(RIL_CIMI_Response),
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CFUN_SET] = {
+        .Prefix = NULL,
+        .Parse = NULL,
+        .Cache = NULL,
+        .TimeOut = 180000,
+        .CacheAge = 0,
+        .RspSize = 0,
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_CGATT_SET] = {
+        .Prefix = NULL,
+        .Parse = NULL,
+        .Cache = NULL,
+        .TimeOut = 180000,
+        .CacheAge = 0,
+        .RspSize = 0,
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_QIACT] = {
+        .Prefix = NULL,
+        .Parse = NULL,
+        .Cache = NULL,
+        .TimeOut = 180000,
+        .CacheAge = 0,
+        .RspSize = 0,
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_QIDEACT] = {
+        .Prefix = NULL,
+        .Parse = NULL,
+        .Cache = NULL,
+        .TimeOut = 150000,
+        .CacheAge = 0,
+        .RspSize = 0,
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_QIOPEN] = {
+        .Prefix = NULL,
+        .Parse = NULL,
+        .Cache = NULL,
+        .TimeOut = 150000,
+        .CacheAge = 0,
+        .RspSize = 0,
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+    [RIL_CMD_QICLOSE] = {
+        .Prefix = NULL,
+        .Parse = NULL,
+        .Cache = NULL,
+        .TimeOut = 5000,
+        .CacheAge = 0,
+        .RspSize = 0,
+        .PrefixLen = 0,
+        .Retry = 0,
+        .Flags = 0,
+    },
+};
+
+#endif
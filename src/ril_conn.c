@@ -0,0 +1,186 @@
+/**
+ * @file ril_conn.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Pool of open modem sockets, reused per host, port, type and TLS context
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_conn.h"
+
+#if RIL_FEATURE_CONN
+
+#include <string.h>
+
+/* RIL_ConnEntry.Flags */
+#define CONN_OWNED              0x01    /* Acquired through the pool */
+#define CONN_IDLE               0x02    /* Released for reuse, open and unused */
+
+/**
+ * Pool state of one socket, indexed by the socket number
+ */
+typedef struct {
+    uint32_t                IdleSince;
+    uint8_t                 Flags;
+    uint8_t                 Type;           /**< RIL_ConnKey.Type, with the push flag as asked for */
+    uint8_t                 Tls;
+} RIL_ConnEntry;
+
+static RIL_ConnEntry entries[RIL_SOCKET_COUNT];
+static RIL_ConnStats stats;
+
+RIL_STATIC_ASSERT(sizeof(entries) + sizeof(stats) <= RIL_RAM_CONN, "RIL_RAM_CONN under-counts ril_conn.c");
+
+static bool _healthy(uint8_t sock);
+static bool _match(uint8_t sock, const RIL_ConnKey* key);
+static bool _evictOldest(void);
+static void _drop(uint8_t sock);
+
+int32_t RIL_conn_acquire(const RIL_ConnKey* key, Callback_SocketEvent fn, void* userData, bool* reused){
+    int32_t sock;
+    if (reused != NULL){
+        *reused = false;
+    }
+    if (key == NULL || key->Host == NULL){
+        return RIL_AT_INVALID_PARAM;
+    }
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        if (!(entries[i].Flags & CONN_IDLE)){
+            continue;
+        }
+        // The close URC may have arrived since the last RIL_process
+        if (!_healthy(i)){
+            _drop(i);
+            stats.Dead++;
+            continue;
+        }
+        if (_match(i, key)){
+            entries[i].Flags &= ~CONN_IDLE;
+            RIL_socket_bind(i, fn, userData);
+            stats.Reused++;
+            if (reused != NULL){
+                *reused = true;
+            }
+            return i;
+        }
+    }
+    sock = RIL_socket_open(key->Type, key->Host, key->Port, fn, userData);
+    if (sock == RIL_AT_BUSY){
+        // The slot is free once the close command is done
+        if (_evictOldest()){
+            stats.Evicted++;
+        }
+        return RIL_AT_BUSY;
+    }
+    if (sock >= 0){
+        entries[sock].Flags = CONN_OWNED;
+        entries[sock].Type = key->Type;
+        entries[sock].Tls = key->Tls;
+        stats.Opened++;
+    }
+    return sock;
+}
+
+void RIL_conn_release(uint8_t sock, bool reuse){
+    RIL_ConnEntry* entry;
+    uint8_t idle = 0;
+    if (sock >= RIL_SOCKET_COUNT || (entries[sock].Flags & (CONN_OWNED | CONN_IDLE)) != CONN_OWNED){
+        return;
+    }
+    entry = &entries[sock];
+    if (!reuse || RIL_CONN_IDLE_MAX == 0 || !_healthy(sock)){
+        _drop(sock);
+        return;
+    }
+    RIL_socket_bind(sock, NULL, NULL);
+    entry->Flags |= CONN_IDLE;
+    entry->IdleSince = HAL_GetTick();
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        if (entries[i].Flags & CONN_IDLE){
+            idle++;
+        }
+    }
+    if (idle > RIL_CONN_IDLE_MAX && _evictOldest()){
+        stats.Evicted++;
+    }
+}
+
+void RIL_conn_flush(void){
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        if (entries[i].Flags & CONN_IDLE){
+            _drop(i);
+        }
+    }
+}
+
+void RIL_conn_process(void){
+    uint32_t now = HAL_GetTick();
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        RIL_ConnEntry* entry = &entries[i];
+        if (!(entry->Flags & CONN_OWNED)){
+            continue;
+        }
+        // Closed by the application with RIL_socket_close
+        if (RIL_socket_state(i) == RIL_SOCKET_FREE || RIL_socket_state(i) == RIL_SOCKET_CLOSING){
+            entry->Flags = 0;
+            continue;
+        }
+        if (!(entry->Flags & CONN_IDLE)){
+            continue;
+        }
+        if (!_healthy(i)){
+            _drop(i);
+            stats.Dead++;
+        }
+        else if (now - entry->IdleSince >= RIL_CONN_IDLE_MS){
+            _drop(i);
+            stats.Expired++;
+        }
+    }
+}
+
+const RIL_ConnStats* RIL_conn_stats(void){
+    return &stats;
+}
+
+/**
+ * @brief open, not hung up, and no data the next owner would mistake for
+ *  the answer to its own request
+ */
+static bool _healthy(uint8_t sock){
+    return RIL_socket_state(sock) == RIL_SOCKET_OPEN &&
+           !(RIL_socket_events(sock) & (RIL_SOCKET_READABLE | RIL_SOCKET_HUP | RIL_SOCKET_ERROR));
+}
+
+static bool _match(uint8_t sock, const RIL_ConnKey* key){
+    const RIL_VendorSocket* peer = RIL_socket_peer(sock);
+    return peer != NULL && entries[sock].Type == key->Type && entries[sock].Tls == key->Tls &&
+           peer->Port == key->Port && strcmp(peer->Host, key->Host) == 0;
+}
+
+static bool _evictOldest(void){
+    uint32_t now = HAL_GetTick();
+    uint8_t oldest = RIL_SOCKET_COUNT;
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        if ((entries[i].Flags & CONN_IDLE) &&
+            (oldest == RIL_SOCKET_COUNT || now - entries[i].IdleSince > now - entries[oldest].IdleSince))
+        {
+            oldest = i;
+        }
+    }
+    if (oldest == RIL_SOCKET_COUNT){
+        return false;
+    }
+    _drop(oldest);
+    return true;
+}
+
+static void _drop(uint8_t sock){
+    RIL_socket_close(sock);
+    entries[sock].Flags = 0;
+}
+
+#endif
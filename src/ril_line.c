@@ -0,0 +1,78 @@
+/**
+ * @file ril_line.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Response line assembly and parsing shared by ril.c and ril_basic.hpp
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_line.h"
+#include "ril_error.h"
+#include <stdlib.h>
+#include <string.h>
+
+uint32_t RIL_lineAppend(char* line, uint32_t* lineLen, uint32_t size, const uint8_t* data, uint32_t avail,
+                        int32_t eol, bool* cut){
+    uint32_t take = eol < 0 ? avail : (uint32_t) eol;
+    uint32_t space = (size - 1) - *lineLen;
+    uint32_t copy = take < space ? take : space;
+
+    memcpy(&line[*lineLen], data, copy);
+    *lineLen += copy;
+    if (cut != NULL){
+        *cut |= take > space;
+    }
+    return eol < 0 ? avail : take + 1;
+}
+
+int32_t RIL_lineEnd(char* line, uint32_t* lineLen, int32_t eol){
+    if (eol < 0 || *lineLen == 0){
+        return -1;
+    }
+    int32_t len = (int32_t) *lineLen;
+    line[len] = 0;
+    *lineLen = 0;
+    return len;
+}
+
+const RIL_Prefix* RIL_lineClassify(const char* line, int32_t len, bool numeric){
+#if RIL_FEATURE_NUMERIC_RESULT
+    if (numeric && len == 1){
+        const RIL_Prefix* prefix = RIL_classifyNumeric(line[0]);
+        if (prefix != NULL){
+            return prefix;
+        }
+    }
+#else
+    (void) numeric;
+#endif
+    return RIL_classifyLine(line, (uint32_t) len);
+}
+
+bool RIL_lineIsEcho(const char* line, int32_t len, uint32_t size, const char* atCmd, uint32_t atCmdLen){
+    return ((uint32_t) len == atCmdLen || ((uint32_t) len == size - 1 && (uint32_t) len < atCmdLen)) &&
+           memcmp(line, atCmd, (size_t) len) == 0;
+}
+
+bool RIL_lineIsResponseOf(const RIL_Prefix* prefix, const char* atCmd, uint32_t atCmdLen){
+    uint32_t nameLen = prefix->Len - 1u;
+    if (prefix->Str[0] != '+' || atCmdLen < nameLen + 2 || memcmp(atCmd + 2, prefix->Str, nameLen) != 0){
+        return false;
+    }
+    // The whole name: "+CMT:" does not answer AT+CMTI
+    if (atCmdLen == nameLen + 2){
+        return true;
+    }
+    char next = atCmd[nameLen + 2];
+    return next == '=' || next == '?' || next == ';';
+}
+
+uint32_t RIL_lineErrCode(const RIL_Prefix* prefix, const char* line){
+    if (prefix->Id == RIL_PREFIX_CME_ERROR || prefix->Id == RIL_PREFIX_CMS_ERROR){
+        return (uint32_t) strtoul(line + prefix->Len, NULL, 10);
+    }
+    return (uint32_t) RIL_AT_FAILED;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file ril_pool.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Fixed-size O(1) object pools, RIL never touches the heap
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_pool.h"
+#include <stddef.h>
+
+void RIL_pool_init(RIL_Pool* pool, void* storage, uint16_t blockSize, uint16_t capacity){
+    uint8_t* block = (uint8_t*) storage;
+    pool->Free = NULL;
+    // Link from the last block down, so allocation starts at the first one
+    for (uint16_t i = capacity; i > 0; i--){
+        void** link = (void**) (block + (uint32_t) (i - 1) * blockSize);
+        *link = pool->Free;
+        pool->Free = link;
+    }
+    pool->Stats.Capacity = capacity;
+    pool->Stats.Used = 0;
+    pool->Stats.Peak = 0;
+    pool->Stats.Failures = 0;
+}
+
+void* RIL_pool_alloc(RIL_Pool* pool){
+    void** block = (void**) pool->Free;
+    if (block == NULL){
+        pool->Stats.Failures++;
+        return NULL;
+    }
+    pool->Free = *block;
+    if (++pool->Stats.Used > pool->Stats.Peak){
+        pool->Stats.Peak = pool->Stats.Used;
+    }
+    return block;
+}
+
+void RIL_pool_free(RIL_Pool* pool, void* block){
+    *(void**) block = pool->Free;
+    pool->Free = block;
+    pool->Stats.Used--;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file ril_power.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief DTR sleep control and RI wakeup around the command queue
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_power.h"
+
+#if RIL_FEATURE_POWER
+
+#include <stddef.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define _RIL_POWER_SIM          1
+#endif
+
+static const RIL_PowerHooks* hooks = NULL;
+static RIL_PowerState state = RIL_POWER_OFF;
+static RIL_PowerStats stats;
+static uint32_t wakeDelay;
+static uint32_t idleTimeout;
+/* Ready time while waking, start of the idle period while awake */
+static uint32_t stateTick;
+static uint32_t awakeSince;
+static volatile bool ringPending = false;
+
+RIL_STATIC_ASSERT(sizeof(hooks) + sizeof(state) + sizeof(stats) + 4 * sizeof(uint32_t) + sizeof(ringPending) <= RIL_RAM_POWER,
+                  "RIL_RAM_POWER under-counts ril_power.c");
+
+static void _wake(void);
+static void _sleep(void);
+#if _RIL_POWER_SIM
+static void _simSetDtr(bool awake, void* args);
+#endif
+
+void RIL_power_init(const RIL_PowerHooks* powerHooks, uint32_t wakeMs, uint32_t idleMs){
+    // The line of the previous hooks is left asserted, as without power management
+    if (hooks != NULL){
+        hooks->setDtr(true, hooks->Args);
+    }
+    hooks = powerHooks;
+    wakeDelay = wakeMs != 0 ? wakeMs : RIL_POWER_WAKE_MS;
+    idleTimeout = idleMs != 0 ? idleMs : RIL_POWER_IDLE_MS;
+    ringPending = false;
+    state = RIL_POWER_OFF;
+    if (hooks != NULL){
+        // Counted from here, the modem was awake while the application set it up
+        state = RIL_POWER_AWAKE;
+        stateTick = awakeSince = HAL_GetTick();
+        hooks->setDtr(true, hooks->Args);
+    }
+}
+
+void RIL_power_ringIndicator(void){
+    ringPending = true;
+}
+
+bool RIL_power_ready(void){
+    switch (state){
+        case RIL_POWER_ASLEEP:
+            stats.Wakes++;
+            _wake();
+            return false;
+        case RIL_POWER_WAKING:
+            if ((int32_t) (HAL_GetTick() - stateTick) < 0){
+                return false;
+            }
+            state = RIL_POWER_AWAKE;
+            stateTick = HAL_GetTick();
+            return true;
+        case RIL_POWER_AWAKE:
+            stateTick = HAL_GetTick();
+            return true;
+        default:
+            return true;
+    }
+}
+
+void RIL_power_process(void){
+    if (state == RIL_POWER_OFF){
+        return;
+    }
+    if (ringPending){
+        ringPending = false;
+        // The modem is already up to send its URC, no wake-to-ready delay
+        if (state == RIL_POWER_ASLEEP){
+            stats.RingWakes++;
+            _wake();
+        }
+        state = RIL_POWER_AWAKE;
+        stateTick = HAL_GetTick();
+    }
+    if (state == RIL_POWER_AWAKE){
+        if (!RIL_isIdle()){
+            stateTick = HAL_GetTick();
+        }
+        else if (HAL_GetTick() - stateTick >= idleTimeout){
+            _sleep();
+        }
+    }
+}
+
+RIL_PowerState RIL_power_state(void){
+    return state;
+}
+
+const RIL_PowerStats* RIL_power_stats(void){
+    // The awake period so far, the rest is added by the next call or _sleep
+    if (state == RIL_POWER_WAKING || state == RIL_POWER_AWAKE){
+        uint32_t now = HAL_GetTick();
+        stats.AwakeMs += now - awakeSince;
+        awakeSince = now;
+    }
+    return &stats;
+}
+
+static void _wake(void){
+    hooks->setDtr(true, hooks->Args);
+    state = RIL_POWER_WAKING;
+    awakeSince = HAL_GetTick();
+    stateTick = awakeSince + wakeDelay;
+}
+
+static void _sleep(void){
+    hooks->setDtr(false, hooks->Args);
+    state = RIL_POWER_ASLEEP;
+    stats.Sleeps++;
+    stats.AwakeMs += HAL_GetTick() - awakeSince;
+}
+
+#if _RIL_POWER_SIM
+RIL_PowerHooks RIL_power_simulated(RIL_PowerSim* sim){
+    RIL_PowerHooks simHooks = {
+        .setDtr = _simSetDtr,
+        .Args = sim,
+    };
+    return simHooks;
+}
+
+static void _simSetDtr(bool awake, void* args){
+    RIL_PowerSim* sim = (RIL_PowerSim*) args;
+    if (sim->Dtr != awake){
+        sim->Edges++;
+    }
+    sim->Dtr = awake;
+}
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file ril_prefix.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Perfect hash classification of response and URC lines
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_prefix.h"
+#include <string.h>
+
+#define _RIL_FNV_BASIS      0x811C9DC5UL
+#define _RIL_FNV_PRIME      0x01000193UL
+
+#if RIL_FEATURE_NUMERIC_RESULT
+/* V.250 numeric result codes, indexed by digit */
+static const RIL_Prefix NUMERIC_RESULTS[] = {
+    { "0", 1, RIL_PREFIX_OK,          RIL_LINE_FINAL_OK    },
+    { "1", 1, RIL_PREFIX_CONNECT,     RIL_LINE_FINAL_OK    },
+    { "2", 1, RIL_PREFIX_RING,        RIL_LINE_URC         },
+    { "3", 1, RIL_PREFIX_NO_CARRIER,  RIL_LINE_FINAL_ERROR },
+    { "4", 1, RIL_PREFIX_ERROR,       RIL_LINE_FINAL_ERROR },
+    { NULL, 0, RIL_PREFIX_NONE,       RIL_LINE_INFO        },
+    { "6", 1, RIL_PREFIX_NO_DIALTONE, RIL_LINE_FINAL_ERROR },
+    { "7", 1, RIL_PREFIX_BUSY,        RIL_LINE_FINAL_ERROR },
+    { "8", 1, RIL_PREFIX_NO_ANSWER,   RIL_LINE_FINAL_ERROR },
+};
+#endif
+
+/**
+ * @brief one table lookup for the first keyLen bytes of line
+ */
+static const RIL_Prefix* _lookup(const char* line, uint32_t keyLen){
+    uint32_t hash = _RIL_FNV_BASIS ^ RIL_PREFIX_SEED;
+
+    for (uint32_t i = 0; i < keyLen; i++){
+        hash ^= (uint8_t) line[i];
+        hash *= _RIL_FNV_PRIME;
+    }
+
+    const RIL_Prefix* prefix = &RIL_PREFIX_TABLE[
+        ((hash >> 16) + RIL_PREFIX_DISPLACEMENT[hash % RIL_PREFIX_BUCKETS]) % RIL_PREFIX_COUNT];
+    if (prefix->Len == keyLen && memcmp(prefix->Str, line, keyLen) == 0){
+        return prefix;
+    }
+    return NULL;
+}
+
+const RIL_Prefix* RIL_classifyLine(const char* line, uint32_t len){
+    const void* colon = memchr(line, ':', len);
+    if (colon != NULL){
+        return _lookup(line, (uint32_t) ((const char*) colon - line) + 1);
+    }
+    const RIL_Prefix* prefix = _lookup(line, len);
+    // A result code with text behind it, "CONNECT 115200": a key that ends at one of the first spaces
+    uint32_t spaces = 0;
+    for (uint32_t i = 0; prefix == NULL && i < len && spaces <= RIL_PREFIX_SPACES; i++){
+        if (line[i] == ' '){
+            spaces++;
+            prefix = _lookup(line, i);
+        }
+    }
+    return prefix;
+}
+
+#if RIL_FEATURE_NUMERIC_RESULT
+const RIL_Prefix* RIL_classifyNumeric(char code){
+    uint8_t index = (uint8_t) (code - '0');
+    if (index < sizeof(NUMERIC_RESULTS) / sizeof(NUMERIC_RESULTS[0]) && NUMERIC_RESULTS[index].Str != NULL){
+        return &NUMERIC_RESULTS[index];
+    }
+    return NULL;
+}
+#endif
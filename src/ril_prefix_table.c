@@ -0,0 +1,59 @@
+/**
+ * @file ril_prefix_table.c
+ * @brief Generated by tools/ril_prefixgen.py from tools/ril_prefixes.txt, do not edit.
+ */
+
+#include "ril_prefix.h"
+
+const uint8_t RIL_PREFIX_DISPLACEMENT[RIL_PREFIX_BUCKETS] = {
+    16, 0, 0, 2, 16, 12, 32, 0, 18, 5, 2, 14, 31, 2, 0, 17,
+    43, 0, 0, 5, 39, 1, 36,
+};
+
+const RIL_Prefix RIL_PREFIX_TABLE[RIL_PREFIX_COUNT] = {
+    { "+UUSOCL:",             8, RIL_PREFIX_UUSOCL,            RIL_LINE_URC          },
+    { "OK",                   2, RIL_PREFIX_OK,                RIL_LINE_FINAL_OK     },
+    { "+CTZV:",               6, RIL_PREFIX_CTZV,              RIL_LINE_URC          },
+    { "+UUSORD:",             8, RIL_PREFIX_UUSORD,            RIL_LINE_URC          },
+    { "+CMS ERROR:",         11, RIL_PREFIX_CMS_ERROR,         RIL_LINE_FINAL_ERROR  },
+    { "CONNECT",              7, RIL_PREFIX_CONNECT,           RIL_LINE_FINAL_OK     },
+    { "Call Ready",          10, RIL_PREFIX_CALL_READY,        RIL_LINE_URC          },
+    { "+QPSMTIMER:",         11, RIL_PREFIX_QPSMTIMER,         RIL_LINE_URC          },
+    { "+CMT:",                5, RIL_PREFIX_CMT,               RIL_LINE_URC          },
+    { "+IPCLOSE:",            9, RIL_PREFIX_IPCLOSE,           RIL_LINE_URC          },
+    { "+CUSD:",               6, RIL_PREFIX_CUSD,              RIL_LINE_URC          },
+    { "+CGREG:",              7, RIL_PREFIX_CGREG,             RIL_LINE_URC          },
+    { "NO ANSWER",            9, RIL_PREFIX_NO_ANSWER,         RIL_LINE_FINAL_ERROR  },
+    { "SEND FAIL",            9, RIL_PREFIX_SEND_FAIL,         RIL_LINE_FINAL_ERROR  },
+    { "RING",                 4, RIL_PREFIX_RING,              RIL_LINE_URC          },
+    { "+UUPSDD:",             8, RIL_PREFIX_UUPSDD,            RIL_LINE_URC          },
+    { "SEND OK",              7, RIL_PREFIX_SEND_OK,           RIL_LINE_FINAL_OK     },
+    { "BUSY",                 4, RIL_PREFIX_BUSY,              RIL_LINE_FINAL_ERROR  },
+    { "ERROR",                5, RIL_PREFIX_ERROR,             RIL_LINE_FINAL_ERROR  },
+    { "+CPIN:",               6, RIL_PREFIX_CPIN,              RIL_LINE_URC          },
+    { "NO CARRIER",          10, RIL_PREFIX_NO_CARRIER,        RIL_LINE_FINAL_ERROR  },
+    { "NORMAL POWER DOWN",   17, RIL_PREFIX_NORMAL_POWER_DOWN, RIL_LINE_URC          },
+    { "+CME ERROR:",         11, RIL_PREFIX_CME_ERROR,         RIL_LINE_FINAL_ERROR  },
+    { "+CREG:",               6, RIL_PREFIX_CREG,              RIL_LINE_URC          },
+    { "+UUPSDA:",             8, RIL_PREFIX_UUPSDA,            RIL_LINE_URC          },
+    { "+QIND:",               6, RIL_PREFIX_QIND,              RIL_LINE_URC          },
+    { "+UUSORF:",             8, RIL_PREFIX_UUSORF,            RIL_LINE_URC          },
+    { "+CRING:",              7, RIL_PREFIX_CRING,             RIL_LINE_URC          },
+    { "+CIPOPEN:",            9, RIL_PREFIX_CIPOPEN,           RIL_LINE_URC          },
+    { "+QIURC:",              7, RIL_PREFIX_QIURC,             RIL_LINE_URC          },
+    { "RDY",                  3, RIL_PREFIX_RDY,               RIL_LINE_URC          },
+    { "+CLIP:",               6, RIL_PREFIX_CLIP,              RIL_LINE_URC          },
+    { "+QSSLOPEN:",          10, RIL_PREFIX_QSSLOPEN,          RIL_LINE_URC          },
+    { "+QIOPEN:",             8, RIL_PREFIX_QIOPEN,            RIL_LINE_URC          },
+    { "+CIPEVENT:",          10, RIL_PREFIX_CIPEVENT,          RIL_LINE_URC          },
+    { "+QMTRECV:",            9, RIL_PREFIX_QMTRECV,           RIL_LINE_URC          },
+    { "+CIPRXGET:",          10, RIL_PREFIX_CIPRXGET,          RIL_LINE_URC          },
+    { "POWERED DOWN",        12, RIL_PREFIX_POWERED_DOWN,      RIL_LINE_URC          },
+    { "+CFUN:",               6, RIL_PREFIX_CFUN,              RIL_LINE_URC          },
+    { "+CEREG:",              7, RIL_PREFIX_CEREG,             RIL_LINE_URC          },
+    { "NO DIALTONE",         11, RIL_PREFIX_NO_DIALTONE,       RIL_LINE_FINAL_ERROR  },
+    { "+QSSLURC:",            9, RIL_PREFIX_QSSLURC,           RIL_LINE_URC          },
+    { "SMS Ready",            9, RIL_PREFIX_SMS_READY,         RIL_LINE_URC          },
+    { "+CMTI:",               6, RIL_PREFIX_CMTI,              RIL_LINE_URC          },
+    { "+QMTSTAT:",            9, RIL_PREFIX_QMTSTAT,           RIL_LINE_URC          },
+};
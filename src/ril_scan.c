@@ -0,0 +1,119 @@
+/**
+ * @file ril_scan.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Byte scanning kernels used by the line reader and argument parser
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_scan.h"
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+    #include "cmsis_compiler.h"
+    #define _RIL_SCAN_DSP       1
+#endif
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#define _RIL_SCAN_ONES          0x01010101UL
+#define _RIL_SCAN_HIGHS         0x80808080UL
+
+static inline uint32_t _wordMatch(uint32_t word, uint32_t maskA, uint32_t maskB);
+static inline int32_t _scanTail(const uint8_t* base, const uint8_t* p, const uint8_t* end, uint8_t a, uint8_t b);
+
+int32_t RIL_scanBytes(const uint8_t* buff, uint32_t len, uint8_t a, uint8_t b){
+    const uint8_t* p = buff;
+    const uint8_t* end = buff + len;
+
+#if defined(__AVX2__)
+    const __m256i vecA32 = _mm256_set1_epi8((char) a);
+    const __m256i vecB32 = _mm256_set1_epi8((char) b);
+    while (end - p >= 32){
+        __m256i data = _mm256_loadu_si256((const __m256i*) p);
+        uint32_t hits = (uint32_t) _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(data, vecA32), _mm256_cmpeq_epi8(data, vecB32)));
+        if (hits){
+            return (int32_t) (p - buff) + __builtin_ctz(hits);
+        }
+        p += 32;
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i vecA = _mm_set1_epi8((char) a);
+    const __m128i vecB = _mm_set1_epi8((char) b);
+    while (end - p >= 16){
+        __m128i data = _mm_loadu_si128((const __m128i*) p);
+        uint32_t hits = (uint32_t) _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(data, vecA), _mm_cmpeq_epi8(data, vecB)));
+        if (hits){
+            return (int32_t) (p - buff) + __builtin_ctz(hits);
+        }
+        p += 16;
+    }
+#endif
+
+    // Walk byte by byte until p is word aligned
+    while (p < end && ((uintptr_t) p & 3U)){
+        if (*p == a || *p == b){
+            return (int32_t) (p - buff);
+        }
+        p++;
+    }
+
+    const uint32_t maskA = a * _RIL_SCAN_ONES;
+    const uint32_t maskB = b * _RIL_SCAN_ONES;
+    while (end - p >= 4){
+        uint32_t word;
+        memcpy(&word, p, sizeof(word));
+        if (_wordMatch(word, maskA, maskB)){
+            // The matching word is resolved by the tail loop
+            break;
+        }
+        p += 4;
+    }
+
+    return _scanTail(buff, p, end, a, b);
+}
+
+int32_t RIL_scanBytesRef(const uint8_t* buff, uint32_t len, uint8_t a, uint8_t b){
+    return _scanTail(buff, buff, buff + len, a, b);
+}
+
+/**
+ * @brief returns non-zero when any byte of word equals a byte of maskA or maskB
+ */
+static inline uint32_t _wordMatch(uint32_t word, uint32_t maskA, uint32_t maskB){
+#if _RIL_SCAN_DSP
+    /* UADD8 with 0xFF sets GE for every non-zero byte, SEL then keeps 0xFF
+       only in the lanes that were zero, that is the lanes that matched */
+    uint32_t hitA, hitB;
+    __UADD8(word ^ maskA, 0xFFFFFFFFUL);
+    hitA = __SEL(0, 0xFFFFFFFFUL);
+    __UADD8(word ^ maskB, 0xFFFFFFFFUL);
+    hitB = __SEL(0, 0xFFFFFFFFUL);
+    return hitA | hitB;
+#else
+    uint32_t xa = word ^ maskA;
+    uint32_t xb = word ^ maskB;
+    return ((xa - _RIL_SCAN_ONES) & ~xa & _RIL_SCAN_HIGHS) |
+           ((xb - _RIL_SCAN_ONES) & ~xb & _RIL_SCAN_HIGHS);
+#endif
+}
+
+static inline int32_t _scanTail(const uint8_t* base, const uint8_t* p, const uint8_t* end, uint8_t a, uint8_t b){
+    while (p < end){
+        if (*p == a || *p == b){
+            return (int32_t) (p - base);
+        }
+        p++;
+    }
+    return -1;
+}
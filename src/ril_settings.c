@@ -0,0 +1,208 @@
+/**
+ * @file ril_settings.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Modem settings applied once and verified on later boots
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_settings.h"
+
+#if RIL_FEATURE_SETTINGS
+
+#include "ril_store.h"
+#if RIL_FEATURE_CAPS
+    #include "ril_caps.h"
+#endif
+#include <stddef.h>
+#include <string.h>
+
+RIL_STATIC_ASSERT(RIL_SETTINGS_MAX <= 32, "RIL_SETTINGS_MAX must fit the 32 bit entry masks");
+
+/**
+ * Stored record, one hash per applied entry
+ */
+typedef struct {
+    uint32_t            Check;          /**< RIL_hash over the fields below */
+    uint32_t            Hashes[RIL_SETTINGS_MAX];
+    uint8_t             Count;
+} RIL_SettingsRecord;
+
+/**
+ * State of the line callback while the verify query runs
+ */
+typedef struct {
+    const RIL_Setting*  Table;
+    uint8_t             Count;
+    uint32_t            Queried;
+    uint32_t            Confirmed;
+} RIL_SettingsVerify;
+
+static uint32_t _entryHash(const RIL_Setting* setting);
+static uint32_t _check(const RIL_SettingsRecord* record);
+static uint32_t _verify(const RIL_Setting* table, uint8_t count, uint32_t mask, RIL_SettingsReport* report);
+static uint32_t _onQueryLine(char* line, uint32_t len, void* userData);
+
+RIL_ATSndError RIL_settings_apply(const RIL_Setting* table, uint8_t count, RIL_SettingsReport* report){
+    RIL_SettingsReport local;
+    RIL_SettingsRecord stored;
+    RIL_SettingsRecord record;
+    RIL_ATSndError result;
+    uint32_t pending = 0;
+    uint32_t kept = 0;
+
+    if (table == NULL || count > RIL_SETTINGS_MAX){
+        return RIL_AT_INVALID_PARAM;
+    }
+    if (report == NULL){
+        report = &local;
+    }
+    memset(report, 0, sizeof(*report));
+    memset(&record, 0, sizeof(record));
+    record.Count = count;
+
+    bool valid = RIL_store_load(RIL_STORE_CONFIG, &stored, sizeof(stored)) && stored.Check == _check(&stored) &&
+                 stored.Count <= RIL_SETTINGS_MAX;
+    for (uint8_t i = 0; i < count; i++){
+        record.Hashes[i] = _entryHash(&table[i]);
+        bool known = false;
+        for (uint8_t j = 0; valid && j < stored.Count && !known; j++){
+            known = stored.Hashes[j] == record.Hashes[i];
+        }
+        if (!known){
+            pending |= 1UL << i;
+        }
+        else if (table[i].Query != NULL && table[i].Expect != NULL){
+            kept |= 1UL << i;
+        }
+    }
+
+    // Entries the modem should still hold, the ones it lost are applied again
+    if (kept != 0){
+        pending |= _verify(table, count, kept, report);
+    }
+
+    for (uint8_t i = 0; i < count; i++){
+        if (pending & (1UL << i)){
+            result = RIL_SendATCmd(table[i].Set, (uint32_t) strlen(table[i].Set), NULL, NULL, 0);
+            if (result != RIL_AT_SUCCESS){
+                return result;
+            }
+            report->Applied++;
+        }
+    }
+
+    bool changed = !valid || stored.Count != count || memcmp(stored.Hashes, record.Hashes, count * sizeof(uint32_t)) != 0;
+    if (report->Applied > 0 && sizeof(RIL_SETTINGS_SAVE_CMD) > 1){
+        result = RIL_SendATCmd(RIL_SETTINGS_SAVE_CMD, sizeof(RIL_SETTINGS_SAVE_CMD) - 1, NULL, NULL, 0);
+        if (result != RIL_AT_SUCCESS){
+            return result;
+        }
+        report->Saved = 1;
+    }
+    if (changed){
+        record.Check = _check(&record);
+        RIL_store_save(RIL_STORE_CONFIG, &record, sizeof(record));
+    }
+    return RIL_AT_SUCCESS;
+}
+
+/**
+ * @brief queries the entries in mask, one compound command when the modem takes them
+ * @return mask of the entries that did not answer as expected
+ */
+static uint32_t _verify(const RIL_Setting* table, uint8_t count, uint32_t mask, RIL_SettingsReport* report){
+    uint32_t kept = mask;
+    RIL_SettingsVerify verify = {
+        .Table = table,
+        .Count = count,
+        .Confirmed = 0,
+    };
+#if RIL_FEATURE_CAPS
+    if (RIL_caps_has(RIL_CAP_COMPOUND)){
+        // AT+A?;+B?;+C?, every query after the first without its "AT"
+        char query[RIL_SETTINGS_QUERY_LEN];
+        uint32_t len = 0;
+        verify.Queried = 0;
+        for (uint8_t i = 0; i < count; i++){
+            if ((mask & (1UL << i)) == 0){
+                continue;
+            }
+            const char* text = table[i].Query + (len > 0 ? 2 : 0);
+            uint32_t textLen = (uint32_t) strlen(text);
+            if (len + (len > 0) + textLen > sizeof(query)){
+                break;
+            }
+            if (len > 0){
+                query[len++] = ';';
+            }
+            memcpy(&query[len], text, textLen);
+            len += textLen;
+            verify.Queried |= 1UL << i;
+        }
+        if (verify.Queried != 0){
+            report->Queries++;
+            if (RIL_SendATCmd(query, len, _onQueryLine, &verify, 0) != RIL_AT_SUCCESS){
+                verify.Confirmed = 0;
+            }
+        }
+        // What did not fit the buffer goes one by one
+        mask &= ~verify.Queried;
+    }
+#endif
+    for (uint8_t i = 0; i < count; i++){
+        if ((mask & (1UL << i)) == 0){
+            continue;
+        }
+        uint32_t confirmed = verify.Confirmed;
+        verify.Queried = 1UL << i;
+        report->Queries++;
+        if (RIL_SendATCmd(table[i].Query, (uint32_t) strlen(table[i].Query), _onQueryLine, &verify, 0) != RIL_AT_SUCCESS){
+            verify.Confirmed = confirmed;
+        }
+    }
+    for (uint8_t i = 0; i < count; i++){
+        if (verify.Confirmed & (1UL << i)){
+            report->Verified++;
+        }
+    }
+    return kept & ~verify.Confirmed;
+}
+
+/**
+ * @brief confirms the queried entries whose Expect starts the line
+ */
+static uint32_t _onQueryLine(char* line, uint32_t len, void* userData){
+    RIL_SettingsVerify* verify = (RIL_SettingsVerify*) userData;
+    for (uint8_t i = 0; i < verify->Count; i++){
+        const char* expect = verify->Table[i].Expect;
+        if ((verify->Queried & (1UL << i)) && expect != NULL){
+            uint32_t expectLen = (uint32_t) strlen(expect);
+            if (expectLen <= len && memcmp(line, expect, expectLen) == 0){
+                verify->Confirmed |= 1UL << i;
+            }
+        }
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+
+static uint32_t _entryHash(const RIL_Setting* setting){
+    uint32_t hash = RIL_hash(RIL_HASH_INIT, setting->Set, (uint32_t) strlen(setting->Set) + 1);
+    if (setting->Query != NULL){
+        hash = RIL_hash(hash, setting->Query, (uint32_t) strlen(setting->Query) + 1);
+    }
+    if (setting->Expect != NULL){
+        hash = RIL_hash(hash, setting->Expect, (uint32_t) strlen(setting->Expect) + 1);
+    }
+    return hash;
+}
+
+static uint32_t _check(const RIL_SettingsRecord* record){
+    return RIL_hash(RIL_HASH_INIT, (const uint8_t*) record + offsetof(RIL_SettingsRecord, Hashes),
+                    sizeof(RIL_SettingsRecord) - offsetof(RIL_SettingsRecord, Hashes));
+}
+
+#endif
@@ -0,0 +1,861 @@
+/**
+ * @file ril_socket.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief TCP/UDP sockets of the modem's embedded IP stack
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_socket.h"
+
+#if RIL_FEATURE_SOCKET
+
+#include "StreamBuffer.h"
+#if RIL_FEATURE_CAPS
+    #include "ril_caps.h"
+#endif
+#include <string.h>
+
+/* RIL_SocketSlot.Flags */
+#define SOCK_RECV_PENDING       0x01    /* The modem holds data, read until a read returns nothing */
+
+/* RIL_SocketOp.Kind */
+#define OP_NONE                 0
+#define OP_OPEN                 1
+#define OP_SEND                 2
+#define OP_READ                 3
+#define OP_CLOSE                4
+
+/* Timeout of send, read and close commands, in ms */
+#define SOCKET_CMD_TIMEOUT      10000
+
+/* Commands in flight, the first one and the reads queued behind it */
+#define SOCKET_OPS              (1 + RIL_SOCKET_PREFETCH)
+
+#if RIL_VENDOR == RIL_VENDOR_AUTO
+    #define VENDOR_READY()      (RIL_vendor() != NULL)
+#else
+    #define VENDOR_READY()      true
+#endif
+
+/**
+ * One socket, the rings are views of rxStorage and txStorage
+ */
+typedef struct {
+    RIL_VendorSocket        Sock;
+    Callback_SocketEvent    Fn;
+    void*                   UserData;
+    StreamBuffer            Rx;
+    StreamBuffer            Tx;
+    uint32_t                OpenDeadline;
+    uint32_t                RetryAt;        /**< A refused send is not tried again before */
+    uint8_t                 State;          /**< RIL_SocketState */
+    uint8_t                 Step;           /**< Open steps the modem acknowledged */
+    uint8_t                 Flags;
+    char                    Host[RIL_SOCKET_HOST_LEN];
+} RIL_SocketSlot;
+
+/**
+ * A command in flight. Reads of one socket may be queued behind each other,
+ * any other command runs alone.
+ */
+typedef struct {
+    RIL_SocketSlot*         Slot;
+    uint32_t                Len;            /**< Bytes sent or asked for */
+    int32_t                 Got;            /**< Length in the read header, -1 before it arrived */
+    uint8_t                 Kind;
+} RIL_SocketOp;
+
+static RIL_SocketSlot slots[RIL_SOCKET_COUNT];
+static uint8_t rxStorage[RIL_SOCKET_COUNT][RIL_SOCKET_RX_SIZE];
+static uint8_t txStorage[RIL_SOCKET_COUNT][RIL_SOCKET_TX_SIZE];
+static RIL_SocketOp ops[SOCKET_OPS];
+static uint8_t opCount = 0;
+static RIL_SocketStats stats;
+static uint8_t pdpContext;
+/* Slot the scheduler looks at first, so one busy socket does not starve the others */
+static uint8_t cursor = 0;
+static bool initialized = false;
+
+RIL_STATIC_ASSERT(sizeof(slots) + sizeof(rxStorage) + sizeof(txStorage) + sizeof(ops) + sizeof(stats) + 4 <= RIL_RAM_SOCKET,
+                  "RIL_RAM_SOCKET under-counts ril_socket.c");
+
+static bool _startOp(RIL_SocketSlot* slot, uint32_t now);
+static bool _prefetch(void);
+static RIL_SocketOp* _issue(RIL_SocketSlot* slot, uint8_t kind, const char* cmd, uint32_t cmdLen, const RIL_Payload* payload,
+                            Callback_ATResponse onLine, Callback_ATDone onDone, uint32_t timeOut);
+static bool _open(RIL_SocketSlot* slot);
+static bool _send(RIL_SocketSlot* slot);
+static bool _read(RIL_SocketSlot* slot, uint32_t reserved);
+static bool _mayRead(RIL_SocketSlot* slot, uint32_t reserved);
+static bool _close(RIL_SocketSlot* slot);
+static uint32_t _onOpenLine(char* line, uint32_t len, void* userData);
+static void _onOpenDone(RIL_ATSndError result, void* userData);
+static void _onSendDone(RIL_ATSndError result, void* userData);
+static uint32_t _onReadLine(char* line, uint32_t len, void* userData);
+static void _onData(const uint8_t* data, uint32_t len, void* userData);
+static void _onReadDone(RIL_ATSndError result, void* userData);
+static void _onCloseDone(RIL_ATSndError result, void* userData);
+static void _onURC(const char* line, uint32_t len, RIL_PrefixId id, void* userData);
+static void _onURCData(const char* line, uint32_t len, RIL_PrefixId id, void* userData);
+static void _onPush(const uint8_t* data, uint32_t len, void* userData);
+static void _onEvent(const RIL_VendorEvent* event);
+static void _opened(RIL_SocketSlot* slot);
+static void _failed(RIL_SocketSlot* slot);
+static void _hangup(RIL_SocketSlot* slot, bool drain);
+static void _free(RIL_SocketSlot* slot);
+static void _notify(RIL_SocketSlot* slot, uint8_t events);
+static void _done(RIL_SocketOp* cur);
+static bool _busy(const RIL_SocketSlot* slot);
+static RIL_SocketSlot* _slot(uint8_t sock);
+static RIL_SocketSlot* _find(uint8_t modemId);
+static bool _capable(uint32_t flags);
+
+RIL_ATSndError RIL_socket_init(uint8_t context){
+    if (!initialized){
+        RIL_ATSndError result = RIL_addURCHandler(_onURC, NULL);
+        if (result != RIL_AT_SUCCESS){
+            return result;
+        }
+        RIL_setURCDataHandler(_onURCData, NULL);
+        initialized = true;
+    }
+    pdpContext = context;
+#if RIL_VENDOR == RIL_VENDOR_AUTO
+    if (RIL_vendor() == NULL){
+        return RIL_vendor_probe();
+    }
+#endif
+    return RIL_AT_SUCCESS;
+}
+
+RIL_ATSndError RIL_socket_attach(void){
+    char cmd[RIL_CMD_LEN];
+    if (!VENDOR_READY()){
+        return RIL_AT_UNINITIALIZED;
+    }
+    for (uint8_t step = 0; step < RIL_vendor()->AttachSteps; step++){
+        uint32_t len = RIL_vendor_buildAttach(cmd, sizeof(cmd), step, pdpContext);
+        RIL_ATSndError result = RIL_SendATCmd(cmd, len, NULL, NULL, RIL_SOCKET_OPEN_TIMEOUT);
+        if (result != RIL_AT_SUCCESS){
+            return result;
+        }
+    }
+    return RIL_AT_SUCCESS;
+}
+
+int32_t RIL_socket_open(uint8_t type, const char* host, uint16_t port, Callback_SocketEvent fn, void* userData){
+    if (!initialized || !VENDOR_READY()){
+        return RIL_AT_UNINITIALIZED;
+    }
+    uint32_t hostLen = host != NULL ? (uint32_t) strlen(host) : 0;
+    uint8_t proto = type & ~RIL_SOCKET_PUSH;
+    if (hostLen == 0 || hostLen >= RIL_SOCKET_HOST_LEN || proto > RIL_SOCKET_UDP){
+        return RIL_AT_INVALID_PARAM;
+    }
+    // Buffer mode where the modem can not push
+    bool push = (type & RIL_SOCKET_PUSH) && (RIL_vendor()->Flags & RIL_VENDOR_RECV_PUSH) && _capable(RIL_CAP_PUSH_RECV);
+    // No raw send or no way to receive, the profile's commands would only fail
+    if (!_capable(RIL_CAP_BINARY_SEND) || !(push || _capable(RIL_CAP_BUFFERED_RECV))){
+        return RIL_AT_FAILED;
+    }
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        RIL_SocketSlot* slot = &slots[i];
+        if (slot->State != RIL_SOCKET_FREE){
+            continue;
+        }
+        memcpy(slot->Host, host, hostLen + 1);
+        slot->Sock.Host = slot->Host;
+        slot->Sock.Port = port;
+        slot->Sock.Type = proto;
+        slot->Sock.Push = push;
+        slot->Sock.Context = pdpContext;
+        slot->Sock.Id = i;
+        // u-blox assigns the number in the first of its open steps
+        slot->Sock.ModemId = RIL_vendor()->OpenSteps > 1 ? RIL_VENDOR_NO_SOCKET : i;
+        slot->Fn = fn;
+        slot->UserData = userData;
+        Stream_init(&slot->Rx, rxStorage[i], RIL_SOCKET_RX_SIZE);
+        Stream_init(&slot->Tx, txStorage[i], RIL_SOCKET_TX_SIZE);
+        slot->OpenDeadline = HAL_GetTick() + RIL_SOCKET_OPEN_TIMEOUT;
+        slot->RetryAt = HAL_GetTick();
+        slot->Step = 0;
+        slot->Flags = 0;
+        slot->State = RIL_SOCKET_OPENING;
+        return i;
+    }
+    return RIL_AT_BUSY;
+}
+
+RIL_ATSndError RIL_socket_close(uint8_t sock){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot == NULL){
+        return RIL_AT_INVALID_PARAM;
+    }
+    if (slot->State != RIL_SOCKET_OPEN){
+        Stream_clear(&slot->Tx);
+    }
+    Stream_clear(&slot->Rx);
+    slot->Flags &= ~SOCK_RECV_PENDING;
+    slot->Fn = NULL;
+    slot->State = RIL_SOCKET_CLOSING;
+    return RIL_AT_SUCCESS;
+}
+
+int32_t RIL_socket_send(uint8_t sock, const void* data, uint32_t len){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot == NULL || (slot->State != RIL_SOCKET_OPEN && slot->State != RIL_SOCKET_OPENING)){
+        return RIL_AT_FAILED;
+    }
+    uint32_t space = (uint32_t) Stream_space(&slot->Tx);
+    if (len > space){
+        len = space;
+    }
+    if (len > 0){
+        Stream_writeBytes(&slot->Tx, (uint8_t*) data, (Stream_LenType) len);
+    }
+    return (int32_t) len;
+}
+
+int32_t RIL_socket_recv(uint8_t sock, void* buff, uint32_t len){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot == NULL || slot->State == RIL_SOCKET_CLOSING){
+        return RIL_AT_FAILED;
+    }
+    uint32_t avail = (uint32_t) Stream_available(&slot->Rx);
+    if (len > avail){
+        len = avail;
+    }
+    if (len > 0){
+        Stream_readBytes(&slot->Rx, (uint8_t*) buff, (Stream_LenType) len);
+        return (int32_t) len;
+    }
+    // Nothing more will arrive
+    if (slot->State == RIL_SOCKET_FAILED ||
+        (slot->State == RIL_SOCKET_REMOTE_CLOSED && !(slot->Flags & SOCK_RECV_PENDING) && !_busy(slot)))
+    {
+        return RIL_AT_FAILED;
+    }
+    return 0;
+}
+
+uint32_t RIL_socket_sendSpan(uint8_t sock, uint8_t** data){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot == NULL || (slot->State != RIL_SOCKET_OPEN && slot->State != RIL_SOCKET_OPENING)){
+        return 0;
+    }
+    *data = Stream_getWritePtr(&slot->Tx);
+    return (uint32_t) Stream_directSpace(&slot->Tx);
+}
+
+void RIL_socket_sendCommit(uint8_t sock, uint32_t len){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot != NULL && len > 0){
+        Stream_moveWritePos(&slot->Tx, (Stream_LenType) len);
+    }
+}
+
+uint32_t RIL_socket_recvSpan(uint8_t sock, const uint8_t** data){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot == NULL){
+        return 0;
+    }
+    *data = Stream_getReadPtr(&slot->Rx);
+    return (uint32_t) Stream_directAvailable(&slot->Rx);
+}
+
+void RIL_socket_recvConsume(uint8_t sock, uint32_t len){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot != NULL && len > 0){
+        Stream_moveReadPos(&slot->Rx, (Stream_LenType) len);
+    }
+}
+
+uint8_t RIL_socket_events(uint8_t sock){
+    RIL_SocketSlot* slot = _slot(sock);
+    uint8_t events = 0;
+    if (slot == NULL){
+        return 0;
+    }
+    if (Stream_available(&slot->Rx) > 0){
+        events |= RIL_SOCKET_READABLE;
+    }
+    switch (slot->State){
+        case RIL_SOCKET_OPEN:
+            if (Stream_space(&slot->Tx) > 0){
+                events |= RIL_SOCKET_WRITABLE;
+            }
+            break;
+        case RIL_SOCKET_REMOTE_CLOSED:
+            // Reported once the data the modem still held is read
+            if (!(slot->Flags & SOCK_RECV_PENDING) && !_busy(slot)){
+                events |= RIL_SOCKET_HUP;
+            }
+            break;
+        case RIL_SOCKET_FAILED:
+            events |= RIL_SOCKET_ERROR;
+            break;
+        default:
+            break;
+    }
+    return events;
+}
+
+RIL_SocketState RIL_socket_state(uint8_t sock){
+    return sock < RIL_SOCKET_COUNT ? (RIL_SocketState) slots[sock].State : RIL_SOCKET_FREE;
+}
+
+const RIL_VendorSocket* RIL_socket_peer(uint8_t sock){
+    RIL_SocketSlot* slot = _slot(sock);
+    return slot != NULL ? &slot->Sock : NULL;
+}
+
+void RIL_socket_bind(uint8_t sock, Callback_SocketEvent fn, void* userData){
+    RIL_SocketSlot* slot = _slot(sock);
+    if (slot != NULL && slot->State != RIL_SOCKET_CLOSING){
+        slot->Fn = fn;
+        slot->UserData = userData;
+    }
+}
+
+uint32_t RIL_socket_unsent(uint8_t sock){
+    RIL_SocketSlot* slot = _slot(sock);
+    return slot != NULL ? (uint32_t) Stream_available(&slot->Tx) : 0;
+}
+
+void RIL_socket_process(void){
+    uint32_t now = HAL_GetTick();
+    if (!initialized || !VENDOR_READY()){
+        return;
+    }
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        RIL_SocketSlot* slot = &slots[i];
+        if (slot->State == RIL_SOCKET_OPENING && !_busy(slot) && (int32_t) (now - slot->OpenDeadline) >= 0){
+            _failed(slot);
+        }
+    }
+    if (opCount > 0){
+        _prefetch();
+        return;
+    }
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        uint8_t index = (uint8_t) ((cursor + i) % RIL_SOCKET_COUNT);
+        if (_startOp(&slots[index], now)){
+            cursor = (uint8_t) ((index + 1) % RIL_SOCKET_COUNT);
+            return;
+        }
+    }
+}
+
+const RIL_SocketStats* RIL_socket_stats(void){
+    return &stats;
+}
+
+#if RIL_FEATURE_SESSION
+/* Socket entry in the session blob: number, state, type, push, modem id, context, port, host length, host */
+#define SESSION_ENTRY_HEADER    9
+
+int32_t RIL_socket_suspend(uint8_t* out, uint32_t size){
+    uint32_t len = 0;
+    if (opCount > 0){
+        return -1;
+    }
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        RIL_SocketSlot* slot = &slots[i];
+        if (slot->State == RIL_SOCKET_FREE){
+            continue;
+        }
+        uint32_t hostLen = (uint32_t) strlen(slot->Host);
+        if ((slot->State != RIL_SOCKET_OPEN && slot->State != RIL_SOCKET_REMOTE_CLOSED) ||
+            Stream_available(&slot->Rx) > 0 || Stream_available(&slot->Tx) > 0 ||
+            len + SESSION_ENTRY_HEADER + hostLen > size)
+        {
+            return -1;
+        }
+        out[len] = i;
+        out[len + 1] = slot->State;
+        out[len + 2] = slot->Sock.Type;
+        out[len + 3] = slot->Sock.Push;
+        out[len + 4] = slot->Sock.ModemId;
+        out[len + 5] = slot->Sock.Context;
+        memcpy(&out[len + 6], &slot->Sock.Port, sizeof(uint16_t));
+        out[len + 8] = (uint8_t) hostLen;
+        memcpy(&out[len + SESSION_ENTRY_HEADER], slot->Host, hostLen);
+        len += SESSION_ENTRY_HEADER + hostLen;
+    }
+    return (int32_t) len;
+}
+
+void RIL_socket_resume(const uint8_t* data, uint32_t len){
+    uint32_t pos = 0;
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        _free(&slots[i]);
+    }
+    memset(ops, 0, sizeof(ops));
+    opCount = 0;
+    // The sockets were opened through the restored vendor profile
+    if (!VENDOR_READY()){
+        return;
+    }
+    while (pos + SESSION_ENTRY_HEADER <= len){
+        uint8_t id = data[pos];
+        uint8_t hostLen = data[pos + 8];
+        if (pos + SESSION_ENTRY_HEADER + hostLen > len){
+            break;
+        }
+        if (id < RIL_SOCKET_COUNT && hostLen > 0 && hostLen < RIL_SOCKET_HOST_LEN && data[pos + 2] <= RIL_SOCKET_UDP &&
+            (data[pos + 1] == RIL_SOCKET_OPEN || data[pos + 1] == RIL_SOCKET_REMOTE_CLOSED))
+        {
+            RIL_SocketSlot* slot = &slots[id];
+            memcpy(slot->Host, &data[pos + SESSION_ENTRY_HEADER], hostLen);
+            slot->Host[hostLen] = '\0';
+            slot->Sock.Host = slot->Host;
+            memcpy(&slot->Sock.Port, &data[pos + 6], sizeof(uint16_t));
+            slot->Sock.Type = data[pos + 2];
+            slot->Sock.Push = data[pos + 3] != 0;
+            slot->Sock.Context = data[pos + 5];
+            slot->Sock.Id = id;
+            slot->Sock.ModemId = data[pos + 4];
+            Stream_init(&slot->Rx, rxStorage[id], RIL_SOCKET_RX_SIZE);
+            Stream_init(&slot->Tx, txStorage[id], RIL_SOCKET_TX_SIZE);
+            slot->RetryAt = HAL_GetTick();
+            slot->Step = RIL_vendor()->OpenSteps;
+            // The receive URC of data that came during sleep is gone, ask once
+            slot->Flags = slot->Sock.Push ? 0 : SOCK_RECV_PENDING;
+            slot->State = data[pos + 1];
+        }
+        pos += SESSION_ENTRY_HEADER + hostLen;
+    }
+}
+#endif
+
+/**
+ * @brief picks the next command of a socket: open steps, then sends before reads
+ */
+static bool _startOp(RIL_SocketSlot* slot, uint32_t now){
+    bool canSend = Stream_available(&slot->Tx) > 0 && (int32_t) (now - slot->RetryAt) >= 0;
+    bool canRead = _mayRead(slot, 0);
+    switch (slot->State){
+        case RIL_SOCKET_OPENING:
+            return slot->Step < RIL_vendor()->OpenSteps && _open(slot);
+        case RIL_SOCKET_OPEN:
+            return (canSend && _send(slot)) || (canRead && _read(slot, 0));
+        case RIL_SOCKET_REMOTE_CLOSED:
+            return canRead && _read(slot, 0);
+        case RIL_SOCKET_CLOSING:
+            if (Stream_available(&slot->Tx) > 0){
+                return canSend && _send(slot);
+            }
+            // Nothing reached the modem yet, there is nothing to close
+            if (slot->Step == 0){
+                _free(slot);
+                return false;
+            }
+            return _close(slot);
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief queues the next read behind the read in flight, so it goes out as
+ *  soon as the modem finished the previous one instead of one RIL_process
+ *  round later. The data of the reads ahead is reserved in the RX ring.
+ */
+static bool _prefetch(void){
+    RIL_SocketSlot* slot = NULL;
+    uint32_t reserved = 0;
+    for (uint8_t i = 0; i < SOCKET_OPS; i++){
+        if (ops[i].Kind == OP_NONE){
+            continue;
+        }
+        if (ops[i].Kind != OP_READ || (slot != NULL && ops[i].Slot != slot)){
+            return false;
+        }
+        slot = ops[i].Slot;
+        reserved += ops[i].Len;
+    }
+    // Only a full chunk is worth a round trip that may come back empty
+    if (opCount >= SOCKET_OPS || slot == NULL || slot->State != RIL_SOCKET_OPEN || !_mayRead(slot, reserved) ||
+        Stream_space(&slot->Rx) - reserved < RIL_vendor()->MaxRead)
+    {
+        return false;
+    }
+    if (!_read(slot, reserved)){
+        return false;
+    }
+    stats.Prefetches++;
+    return true;
+}
+
+/**
+ * @brief hands a command to the engine
+ * @return NULL when the command pool is exhausted, it is tried again later
+ */
+static RIL_SocketOp* _issue(RIL_SocketSlot* slot, uint8_t kind, const char* cmd, uint32_t cmdLen, const RIL_Payload* payload,
+                            Callback_ATResponse onLine, Callback_ATDone onDone, uint32_t timeOut){
+    static const RIL_Payload NO_PAYLOAD = { 0 };
+    RIL_SocketOp* cur = NULL;
+    for (uint8_t i = 0; i < SOCKET_OPS && cur == NULL; i++){
+        if (ops[i].Kind == OP_NONE){
+            cur = &ops[i];
+        }
+    }
+    if (cur == NULL || cmdLen == 0 ||
+        RIL_SendATCmdPayload(cmd, cmdLen, payload != NULL ? payload : &NO_PAYLOAD, onLine, onDone, cur, timeOut) != RIL_AT_SUCCESS)
+    {
+        return NULL;
+    }
+    cur->Slot = slot;
+    cur->Kind = kind;
+    cur->Got = -1;
+    cur->Len = 0;
+    opCount++;
+    return cur;
+}
+
+static bool _open(RIL_SocketSlot* slot){
+    char cmd[RIL_CMD_LEN];
+    uint32_t len = RIL_vendor_buildOpen(cmd, sizeof(cmd), slot->Step, &slot->Sock);
+    if (len == 0){
+        // Does not fit RIL_CMD_LEN, the host is too long for this modem
+        _failed(slot);
+        return false;
+    }
+    return _issue(slot, OP_OPEN, cmd, len, NULL, _onOpenLine, _onOpenDone, RIL_SOCKET_OPEN_TIMEOUT) != NULL;
+}
+
+static bool _send(RIL_SocketSlot* slot){
+    char cmd[RIL_CMD_LEN];
+    // The contiguous part of the ring goes out in place, a wrapped ring takes two sends
+    RIL_Payload payload = {
+        .Data = Stream_getReadPtr(&slot->Tx),
+        .Len = (uint32_t) Stream_directAvailable(&slot->Tx),
+        .Prompt = RIL_vendor()->SendPrompt,
+    };
+    if (payload.Len > RIL_vendor()->MaxSend){
+        payload.Len = RIL_vendor()->MaxSend;
+    }
+    uint32_t len = RIL_vendor_buildSend(cmd, sizeof(cmd), &slot->Sock, payload.Len);
+    RIL_SocketOp* cur = _issue(slot, OP_SEND, cmd, len, &payload, NULL, _onSendDone, SOCKET_CMD_TIMEOUT);
+    if (cur == NULL){
+        return false;
+    }
+    cur->Len = payload.Len;
+    stats.SendCommands++;
+    return true;
+}
+
+/**
+ * @param reserved RX ring space the reads in flight may still fill
+ */
+static bool _read(RIL_SocketSlot* slot, uint32_t reserved){
+    char cmd[RIL_CMD_LEN];
+    // Never more than the ring takes, the rest stays in the modem
+    uint32_t want = (uint32_t) Stream_space(&slot->Rx) - reserved;
+    if (want > RIL_vendor()->MaxRead){
+        want = RIL_vendor()->MaxRead;
+    }
+    RIL_Payload payload = {
+        .Inline = (RIL_vendor()->Flags & RIL_VENDOR_READ_INLINE) ? RIL_vendor()->ReadPrefix : NULL,
+    };
+    uint32_t len = RIL_vendor_buildRead(cmd, sizeof(cmd), &slot->Sock, want);
+    RIL_SocketOp* cur = _issue(slot, OP_READ, cmd, len, &payload, _onReadLine, _onReadDone, SOCKET_CMD_TIMEOUT);
+    if (cur == NULL){
+        return false;
+    }
+    cur->Len = want;
+    stats.ReadCommands++;
+    return true;
+}
+
+/**
+ * @brief the modem holds data and the ring has room for a read worth its
+ *  round trip, a nearly full ring waits until the application consumed
+ */
+static bool _mayRead(RIL_SocketSlot* slot, uint32_t reserved){
+    uint32_t space = (uint32_t) Stream_space(&slot->Rx);
+    uint32_t min = RIL_SOCKET_READ_MIN < RIL_SOCKET_RX_SIZE ? RIL_SOCKET_READ_MIN : RIL_SOCKET_RX_SIZE;
+    if (!(slot->Flags & SOCK_RECV_PENDING) || space <= reserved){
+        return false;
+    }
+    return space - reserved >= min || (reserved == 0 && Stream_available(&slot->Rx) == 0);
+}
+
+static bool _close(RIL_SocketSlot* slot){
+    char cmd[RIL_CMD_LEN];
+    uint32_t len = RIL_vendor_buildClose(cmd, sizeof(cmd), &slot->Sock);
+    return _issue(slot, OP_CLOSE, cmd, len, NULL, NULL, _onCloseDone, SOCKET_CMD_TIMEOUT) != NULL;
+}
+
+/**
+ * @brief open step response, u-blox reports its socket number here and SIMCom
+ *  may answer +CIPOPEN before OK, which the engine hands over as a response line
+ */
+static uint32_t _onOpenLine(char* line, uint32_t len, void* userData){
+    RIL_SocketOp* cur = (RIL_SocketOp*) userData;
+    RIL_VendorEvent event;
+    const RIL_Prefix* prefix = RIL_classifyLine(line, len);
+    RIL_vendor_parseOpen(cur->Slot->Step, line, len, &cur->Slot->Sock);
+    if (prefix != NULL && RIL_vendor_parseUrc(line, len, (RIL_PrefixId) prefix->Id, &event)){
+        _onEvent(&event);
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+
+static void _onOpenDone(RIL_ATSndError result, void* userData){
+    RIL_SocketSlot* slot = ((RIL_SocketOp*) userData)->Slot;
+    _done((RIL_SocketOp*) userData);
+    if (result == RIL_AT_SUCCESS){
+        slot->Step++;
+    }
+    if (slot->State != RIL_SOCKET_OPENING){
+        // Closed meanwhile, or the result URC came with the response
+        return;
+    }
+    if (result != RIL_AT_SUCCESS){
+        _failed(slot);
+    }
+    else if (slot->Step == RIL_vendor()->OpenSteps){
+        if (RIL_vendor()->Flags & RIL_VENDOR_OPEN_URC){
+            slot->OpenDeadline = HAL_GetTick() + RIL_SOCKET_OPEN_TIMEOUT;
+        }
+        else {
+            _opened(slot);
+        }
+    }
+}
+
+static void _onSendDone(RIL_ATSndError result, void* userData){
+    RIL_SocketSlot* slot = ((RIL_SocketOp*) userData)->Slot;
+    uint32_t sent = ((RIL_SocketOp*) userData)->Len;
+    _done((RIL_SocketOp*) userData);
+    if (result != RIL_AT_SUCCESS){
+        // SEND FAIL: the modem buffer is full, the data stays in the ring
+        stats.SendRetries++;
+        slot->RetryAt = HAL_GetTick() + RIL_SOCKET_RETRY_MS;
+        return;
+    }
+    Stream_moveReadPos(&slot->Tx, (Stream_LenType) sent);
+    stats.Sent += sent;
+    if (slot->State == RIL_SOCKET_OPEN){
+        _notify(slot, RIL_SOCKET_WRITABLE);
+    }
+}
+
+static uint32_t _onReadLine(char* line, uint32_t len, void* userData){
+    RIL_SocketOp* cur = (RIL_SocketOp*) userData;
+    if (cur->Got < 0){
+        int32_t got = RIL_vendor_parseRead(line, len);
+        if (got >= 0){
+            cur->Got = got;
+            RIL_readPayload((uint32_t) got, _onData, cur->Slot);
+        }
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+
+static void _onData(const uint8_t* data, uint32_t len, void* userData){
+    RIL_SocketSlot* slot = (RIL_SocketSlot*) userData;
+    // The read was sized to the free space, a closed socket drops what still arrives
+    if (slot->State != RIL_SOCKET_CLOSING && Stream_space(&slot->Rx) >= (Stream_LenType) len){
+        Stream_writeBytes(&slot->Rx, (uint8_t*) data, (Stream_LenType) len);
+        stats.Received += len;
+    }
+}
+
+static void _onReadDone(RIL_ATSndError result, void* userData){
+    RIL_SocketSlot* slot = ((RIL_SocketOp*) userData)->Slot;
+    int32_t got = ((RIL_SocketOp*) userData)->Got;
+    _done((RIL_SocketOp*) userData);
+    // Only an empty read tells the modem buffer is drained, it reports the next data with a new URC
+    if (result != RIL_AT_SUCCESS || got <= 0){
+        slot->Flags &= ~SOCK_RECV_PENDING;
+    }
+    if (slot->State == RIL_SOCKET_CLOSING){
+        return;
+    }
+    uint8_t events = got > 0 ? RIL_SOCKET_READABLE : 0;
+    if (slot->State == RIL_SOCKET_REMOTE_CLOSED && !(slot->Flags & SOCK_RECV_PENDING) && !_busy(slot)){
+        events |= RIL_SOCKET_HUP;
+    }
+    _notify(slot, events);
+}
+
+static void _onCloseDone(RIL_ATSndError result, void* userData){
+    RIL_SocketSlot* slot = ((RIL_SocketOp*) userData)->Slot;
+    (void) result;
+    _done((RIL_SocketOp*) userData);
+    _free(slot);
+}
+
+static void _onURC(const char* line, uint32_t len, RIL_PrefixId id, void* userData){
+    RIL_VendorEvent event;
+    (void) userData;
+    if (VENDOR_READY() && RIL_vendor_parseUrc(line, len, id, &event)){
+        _onEvent(&event);
+    }
+}
+
+/**
+ * @brief a receive URC of a push socket carries the data, it is taken here
+ *  before the parser would split it into lines
+ */
+static void _onURCData(const char* line, uint32_t len, RIL_PrefixId id, void* userData){
+    RIL_VendorEvent event;
+    RIL_SocketSlot* slot;
+    (void) userData;
+    if (VENDOR_READY() && RIL_vendor_parseUrc(line, len, id, &event) && event.Type == RIL_VENDOR_EVENT_RECV &&
+        event.Value > 0 && (slot = _find(event.Socket)) != NULL && slot->Sock.Push)
+    {
+        RIL_readPayload((uint32_t) event.Value, _onPush, slot);
+    }
+}
+
+/**
+ * @brief pushed data, straight from the UART stream into the RX ring
+ */
+static void _onPush(const uint8_t* data, uint32_t len, void* userData){
+    RIL_SocketSlot* slot = (RIL_SocketSlot*) userData;
+    uint32_t take = (uint32_t) Stream_space(&slot->Rx);
+    if (slot->State == RIL_SOCKET_CLOSING){
+        take = 0;
+    }
+    if (take > len){
+        take = len;
+    }
+    if (take > 0){
+        Stream_writeBytes(&slot->Rx, (uint8_t*) data, (Stream_LenType) take);
+        stats.Received += take;
+        _notify(slot, RIL_SOCKET_READABLE);
+    }
+    stats.Dropped += len - take;
+}
+
+static void _onEvent(const RIL_VendorEvent* event){
+    RIL_SocketSlot* slot;
+    if (event->Type == RIL_VENDOR_EVENT_DETACHED){
+        // The data of a lost context is gone with it
+        for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+            if (slots[i].State == RIL_SOCKET_OPEN || slots[i].State == RIL_SOCKET_OPENING){
+                _hangup(&slots[i], false);
+            }
+        }
+        return;
+    }
+    if ((slot = _find(event->Socket)) == NULL){
+        return;
+    }
+    switch (event->Type){
+        case RIL_VENDOR_EVENT_OPENED:
+            if (slot->State == RIL_SOCKET_OPENING){
+                if (event->Value == 0){
+                    _opened(slot);
+                }
+                else {
+                    _failed(slot);
+                }
+            }
+            break;
+        case RIL_VENDOR_EVENT_RECV:
+            // A push socket got the data with the URC already
+            if (slot->State == RIL_SOCKET_OPEN && !(slot->Sock.Push && event->Value >= 0)){
+                slot->Flags |= SOCK_RECV_PENDING;
+            }
+            break;
+        case RIL_VENDOR_EVENT_CLOSED:
+            if (slot->State == RIL_SOCKET_OPEN || slot->State == RIL_SOCKET_OPENING){
+                _hangup(slot, slot->State == RIL_SOCKET_OPEN);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void _opened(RIL_SocketSlot* slot){
+    slot->State = RIL_SOCKET_OPEN;
+    slot->RetryAt = HAL_GetTick();
+    _notify(slot, RIL_SOCKET_WRITABLE);
+}
+
+static void _failed(RIL_SocketSlot* slot){
+    slot->State = RIL_SOCKET_FAILED;
+    Stream_clear(&slot->Tx);
+    _notify(slot, RIL_SOCKET_ERROR);
+}
+
+/**
+ * @brief the peer or the network ended the socket,
+ *  with drain one more read fetches what the modem still holds
+ */
+static void _hangup(RIL_SocketSlot* slot, bool drain){
+    slot->State = RIL_SOCKET_REMOTE_CLOSED;
+    Stream_clear(&slot->Tx);
+    if (drain){
+        slot->Flags |= SOCK_RECV_PENDING;
+    }
+    else {
+        slot->Flags &= ~SOCK_RECV_PENDING;
+        _notify(slot, RIL_SOCKET_HUP);
+    }
+}
+
+static void _free(RIL_SocketSlot* slot){
+    slot->State = RIL_SOCKET_FREE;
+    slot->Fn = NULL;
+    slot->Flags = 0;
+    Stream_clear(&slot->Rx);
+    Stream_clear(&slot->Tx);
+}
+
+static void _notify(RIL_SocketSlot* slot, uint8_t events){
+    if (slot->Fn != NULL && events != 0){
+        slot->Fn(slot->Sock.Id, events, slot->UserData);
+    }
+}
+
+static void _done(RIL_SocketOp* cur){
+    cur->Slot = NULL;
+    cur->Kind = OP_NONE;
+    opCount--;
+}
+
+static bool _busy(const RIL_SocketSlot* slot){
+    for (uint8_t i = 0; i < SOCKET_OPS; i++){
+        if (ops[i].Kind != OP_NONE && ops[i].Slot == slot){
+            return true;
+        }
+    }
+    return false;
+}
+
+static RIL_SocketSlot* _slot(uint8_t sock){
+    return sock < RIL_SOCKET_COUNT && slots[sock].State != RIL_SOCKET_FREE ? &slots[sock] : NULL;
+}
+
+static RIL_SocketSlot* _find(uint8_t modemId){
+    for (uint8_t i = 0; i < RIL_SOCKET_COUNT; i++){
+        if (slots[i].State != RIL_SOCKET_FREE && slots[i].Sock.ModemId == modemId){
+            return &slots[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief the discovered flags once RIL_caps_discover ran, the profile alone before it
+ */
+static bool _capable(uint32_t flags){
+#if RIL_FEATURE_CAPS
+    return !RIL_caps_valid() || RIL_caps_has(flags);
+#else
+    (void) flags;
+    return true;
+#endif
+}
+
+#endif
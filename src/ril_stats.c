@@ -0,0 +1,71 @@
+/**
+ * @file ril_stats.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Buffer high-water-mark tracking and size recommendations
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_stats.h"
+#include <string.h>
+
+void RIL_bufferStats_init(RIL_BufferStats* stats, uint32_t size){
+    memset(stats, 0, sizeof(*stats));
+    stats->Size = size;
+}
+
+static void _trackAbove75(RIL_BufferStats* stats, uint32_t used, uint32_t now);
+
+void RIL_bufferStats_sample(RIL_BufferStats* stats, uint32_t used, uint32_t now){
+    stats->Samples++;
+    // The usage above Size that marks an overrun is no peak the buffer held
+    uint32_t held = used < stats->Size ? used : stats->Size;
+    if (held > stats->HighWater){
+        stats->HighWater = held;
+    }
+    if (used >= stats->Size - stats->Size / RIL_STATS_NEAR_OVERRUN_DIV){
+        stats->NearOverrun++;
+    }
+    _trackAbove75(stats, used, now);
+}
+
+void RIL_bufferStats_tick(RIL_BufferStats* stats, uint32_t used, uint32_t now){
+    if (used > stats->HighWater && used <= stats->Size){
+        stats->HighWater = used;
+    }
+    _trackAbove75(stats, used, now);
+}
+
+uint32_t RIL_bufferStats_recommend(const RIL_BufferStats* stats){
+    if (stats->Samples == 0){
+        return 0;
+    }
+    uint32_t size = stats->HighWater + stats->HighWater / 4;
+    if (stats->NearOverrun && size < 2 * stats->Size){
+        size = 2 * stats->Size;
+    }
+    return (size + RIL_STATS_SIZE_ALIGN - 1) / RIL_STATS_SIZE_ALIGN * RIL_STATS_SIZE_ALIGN;
+}
+
+/**
+ * @brief adds the time since the last call while the buffer stays above 75%,
+ *  so TimeAbove75 is current at every sample and tick
+ */
+static void _trackAbove75(RIL_BufferStats* stats, uint32_t used, uint32_t now){
+    if (stats->Above75){
+        stats->TimeAbove75 += now - stats->AboveSince;
+        stats->AboveSince = now;
+    }
+    if (used * 4 > stats->Size * 3){
+        if (!stats->Above75){
+            stats->Above75 = 1;
+            stats->AboveSince = now;
+        }
+    }
+    else {
+        stats->Above75 = 0;
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * @file ril_store.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Persistent storage hook for state RIL keeps across boots
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_store.h"
+#include <stddef.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <stdio.h>
+    #define _RIL_STORE_FILE         1
+#endif
+
+static const RIL_Store* store;
+
+RIL_STATIC_ASSERT(sizeof(store) <= RIL_RAM_SETTINGS, "RIL_RAM_SETTINGS under-counts ril_store.c");
+
+#if _RIL_STORE_FILE
+static bool _fileLoad(RIL_StoreKey key, void* data, uint32_t len, void* args);
+static bool _fileSave(RIL_StoreKey key, const void* data, uint32_t len, void* args);
+static void _filePath(char* path, uint32_t size, const char* dir, RIL_StoreKey key);
+#endif
+
+void RIL_store_set(const RIL_Store* hook){
+    store = hook;
+}
+
+bool RIL_store_load(RIL_StoreKey key, void* data, uint32_t len){
+    return store != NULL && store->load(key, data, len, store->Args);
+}
+
+bool RIL_store_save(RIL_StoreKey key, const void* data, uint32_t len){
+    return store != NULL && store->save(key, data, len, store->Args);
+}
+
+uint32_t RIL_hash(uint32_t hash, const void* data, uint32_t len){
+    const uint8_t* bytes = (const uint8_t*) data;
+    while (len-- > 0){
+        hash = (hash ^ *bytes++) * 0x01000193UL;
+    }
+    return hash;
+}
+
+#if _RIL_STORE_FILE
+RIL_Store RIL_store_file(const char* dir){
+    RIL_Store hook = {
+        .load = _fileLoad,
+        .save = _fileSave,
+        .Args = (void*) dir,
+    };
+    return hook;
+}
+
+static bool _fileLoad(RIL_StoreKey key, void* data, uint32_t len, void* args){
+    char path[256];
+    _filePath(path, sizeof(path), (const char*) args, key);
+    FILE* file = fopen(path, "rb");
+    if (file == NULL){
+        return false;
+    }
+    // One byte more than expected tells a record of another size apart
+    uint8_t extra;
+    bool ok = fread(data, 1, len, file) == len && fread(&extra, 1, 1, file) == 0;
+    fclose(file);
+    return ok;
+}
+
+static bool _fileSave(RIL_StoreKey key, const void* data, uint32_t len, void* args){
+    char path[256];
+    _filePath(path, sizeof(path), (const char*) args, key);
+    FILE* file = fopen(path, "wb");
+    if (file == NULL){
+        return false;
+    }
+    bool ok = fwrite(data, 1, len, file) == len;
+    return fclose(file) == 0 && ok;
+}
+
+static void _filePath(char* path, uint32_t size, const char* dir, RIL_StoreKey key){
+    snprintf(path, size, "%s/ril_%u.bin", dir, (unsigned) key);
+}
+#endif
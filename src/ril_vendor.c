@@ -0,0 +1,120 @@
+/**
+ * @file ril_vendor.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Vendor profiles: selection and probing
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_vendor.h"
+
+#if RIL_FEATURE_VENDOR
+
+#include <string.h>
+
+/**
+ * State of the line callback while a probe command runs
+ */
+typedef struct {
+    const RIL_VendorProfile*    Found;
+} RIL_VendorProbe;
+
+/* Profiles linked in, RIL_vendor_match tries them in this order */
+static const RIL_VendorProfile* const PROFILES[] = {
+#if RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_QUECTEL
+    &RIL_VENDOR_QUECTEL_PROFILE,
+#endif
+#if RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_SIMCOM
+    &RIL_VENDOR_SIMCOM_PROFILE,
+#endif
+#if RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_UBLOX
+    &RIL_VENDOR_UBLOX_PROFILE,
+#endif
+};
+
+#if RIL_VENDOR == RIL_VENDOR_AUTO
+static const RIL_VendorProfile* active;
+
+RIL_STATIC_ASSERT(sizeof(active) <= RIL_RAM_VENDOR, "RIL_RAM_VENDOR under-counts ril_vendor.c");
+
+static uint32_t _onProbeLine(char* line, uint32_t len, void* userData);
+#endif
+static bool _containsNoCase(const char* text, uint32_t len, const char* word);
+
+#if RIL_VENDOR == RIL_VENDOR_AUTO
+const RIL_VendorProfile* RIL_vendor(void){
+    return active;
+}
+
+void RIL_vendor_set(const RIL_VendorProfile* profile){
+    active = profile;
+}
+
+RIL_ATSndError RIL_vendor_probe(void){
+    RIL_VendorProbe probe = { .Found = NULL };
+    RIL_ATSndError result = RIL_SendATCmd("AT+CGMI", 7, _onProbeLine, &probe, 0);
+    // Some firmwares answer CGMI with a model code only, ATI lists the manufacturer too
+    if (probe.Found == NULL && result != RIL_AT_BUSY){
+        result = RIL_SendATCmd("ATI", 3, _onProbeLine, &probe, 0);
+    }
+    if (probe.Found == NULL){
+        return result == RIL_AT_SUCCESS ? RIL_AT_FAILED : result;
+    }
+    active = probe.Found;
+    return RIL_AT_SUCCESS;
+}
+#else
+RIL_ATSndError RIL_vendor_probe(void){
+    return RIL_AT_SUCCESS;
+}
+#endif
+
+const RIL_VendorProfile* RIL_vendor_match(const char* text, uint32_t len){
+    for (uint8_t i = 0; i < sizeof(PROFILES) / sizeof(PROFILES[0]); i++){
+        if (_containsNoCase(text, len, PROFILES[i]->Manufacturer)){
+            return PROFILES[i];
+        }
+    }
+    return NULL;
+}
+
+const RIL_VendorProfile* RIL_vendor_byId(RIL_VendorId id){
+    for (uint8_t i = 0; i < sizeof(PROFILES) / sizeof(PROFILES[0]); i++){
+        if (PROFILES[i]->Id == id){
+            return PROFILES[i];
+        }
+    }
+    return NULL;
+}
+
+#if RIL_VENDOR == RIL_VENDOR_AUTO
+/**
+ * @brief keeps the first profile any response line names
+ */
+static uint32_t _onProbeLine(char* line, uint32_t len, void* userData){
+    RIL_VendorProbe* probe = (RIL_VendorProbe*) userData;
+    if (probe->Found == NULL){
+        probe->Found = RIL_vendor_match(line, len);
+    }
+    return RIL_AT_RSP_CONTINUE;
+}
+#endif
+
+static bool _containsNoCase(const char* text, uint32_t len, const char* word){
+    uint32_t wordLen = (uint32_t) strlen(word);
+    for (uint32_t start = 0; start + wordLen <= len; start++){
+        uint32_t i = 0;
+        while (i < wordLen && (text[start + i] | 0x20) == (word[i] | 0x20)){
+            i++;
+        }
+        if (i == wordLen){
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file ril_vendor_quectel.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Quectel profile: BG9x, EG9x, EC2x TCP/IP commands
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_vendor.h"
+
+#if RIL_FEATURE_VENDOR && (RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_QUECTEL)
+
+#include "ril_cmd.h"
+#include <string.h>
+
+/* Longest fixed part of AT+QIOPEN, the host comes on top */
+#define QUECTEL_OPEN_LEN        48
+
+const RIL_VendorProfile RIL_VENDOR_QUECTEL_PROFILE = {
+    .Name = "Quectel",
+    .Manufacturer = "Quectel",
+    .ReadPrefix = "+QIRD:",
+    .UploadPrompt = "CONNECT",
+    .Id = RIL_VENDOR_QUECTEL,
+    .SendPrompt = '>',
+    .Flags = RIL_VENDOR_OPEN_URC | RIL_VENDOR_RECV_PUSH,
+    .AttachSteps = 1,
+    .OpenSteps = 1,
+    .MaxSend = 1460,
+    .MaxRead = 1500,
+    .buildAttach = RIL_quectel_buildAttach,
+    .buildOpen = RIL_quectel_buildOpen,
+    .parseOpen = RIL_quectel_parseOpen,
+    .buildSend = RIL_quectel_buildSend,
+    .buildRead = RIL_quectel_buildRead,
+    .parseRead = RIL_quectel_parseRead,
+    .buildClose = RIL_quectel_buildClose,
+    .buildUpload = RIL_quectel_buildUpload,
+    .parseUrc = RIL_quectel_parseUrc,
+};
+
+uint32_t RIL_quectel_buildAttach(char* buff, uint32_t size, uint8_t step, uint8_t context){
+    if (step != 0 || size < 16){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+QIACT=");
+    pos = RIL_cmd_putUint(pos, context);
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_quectel_buildOpen(char* buff, uint32_t size, uint8_t step, const RIL_VendorSocket* sock){
+    uint32_t hostLen = (uint32_t) strlen(sock->Host);
+    if (step != 0 || size < QUECTEL_OPEN_LEN + hostLen){
+        return 0;
+    }
+    // Buffer access mode keeps the data in the modem until AT+QIRD, direct push sends it with the URC
+    char* pos = RIL_cmd_putLit(buff, "AT+QIOPEN=");
+    pos = RIL_cmd_putUint(pos, sock->Context);
+    *pos++ = ',';
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    pos = sock->Type == RIL_SOCKET_UDP ? RIL_cmd_putLit(pos, ",\"UDP\",\"") : RIL_cmd_putLit(pos, ",\"TCP\",\"");
+    memcpy(pos, sock->Host, hostLen);
+    pos += hostLen;
+    pos = RIL_cmd_putLit(pos, "\",");
+    pos = RIL_cmd_putUint(pos, sock->Port);
+    pos = sock->Push ? RIL_cmd_putLit(pos, ",0,1") : RIL_cmd_putLit(pos, ",0,0");
+    return (uint32_t) (pos - buff);
+}
+
+void RIL_quectel_parseOpen(uint8_t step, const char* line, uint32_t len, RIL_VendorSocket* sock){
+    // The socket number is the one sent, the result comes as +QIOPEN
+    (void) step;
+    (void) line;
+    (void) len;
+    (void) sock;
+}
+
+uint32_t RIL_quectel_buildSend(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len){
+    if (size < 24){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+QISEND=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    *pos++ = ',';
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_quectel_buildRead(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len){
+    if (size < 24){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+QIRD=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    *pos++ = ',';
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+int32_t RIL_quectel_parseRead(const char* line, uint32_t len){
+    // +QIRD: <read_len>
+    const char* end = line + len;
+    const char* pos = line + 6;
+    uint32_t dataLen;
+    if (len < 7 || memcmp(line, "+QIRD:", 6) != 0 || !RIL_cmd_parseUint(&pos, end, &dataLen) || pos != end){
+        return -1;
+    }
+    return (int32_t) dataLen;
+}
+
+uint32_t RIL_quectel_buildClose(char* buff, uint32_t size, const RIL_VendorSocket* sock){
+    if (size < 16){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+QICLOSE=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_quectel_buildUpload(char* buff, uint32_t size, const char* name, uint32_t len){
+    // AT+QFUPL="<name>",<len>, the data follows CONNECT
+    uint32_t nameLen = (uint32_t) strlen(name);
+    if (size < 24 + nameLen){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+QFUPL=\"");
+    memcpy(pos, name, nameLen);
+    pos += nameLen;
+    pos = RIL_cmd_putLit(pos, "\",");
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+bool RIL_quectel_parseUrc(const char* line, uint32_t len, RIL_PrefixId id, RIL_VendorEvent* event){
+    const char* end = line + len;
+    const char* pos;
+    uint32_t value;
+    char kind[10];
+
+    if (id == RIL_PREFIX_QIOPEN){
+        // +QIOPEN: <connectID>,<err>
+        int32_t err;
+        pos = line + 8;
+        if (!RIL_cmd_parseUint(&pos, end, &value) || !RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseInt(&pos, end, &err)){
+            return false;
+        }
+        event->Type = RIL_VENDOR_EVENT_OPENED;
+        event->Socket = (uint8_t) value;
+        event->Value = err;
+        return true;
+    }
+    if (id != RIL_PREFIX_QIURC){
+        return false;
+    }
+    // +QIURC: "recv",<connectID>  +QIURC: "closed",<connectID>  +QIURC: "pdpdeact",<contextID>
+    pos = line + 7;
+    if (!RIL_cmd_parseStr(&pos, end, kind, sizeof(kind)) || !RIL_cmd_nextField(&pos, end) ||
+        !RIL_cmd_parseUint(&pos, end, &value))
+    {
+        return false;
+    }
+    event->Socket = (uint8_t) value;
+    event->Value = -1;
+    if (strcmp(kind, "recv") == 0){
+        // Direct push mode appends the length
+        event->Type = RIL_VENDOR_EVENT_RECV;
+        if (RIL_cmd_nextField(&pos, end) && RIL_cmd_parseUint(&pos, end, &value)){
+            event->Value = (int32_t) value;
+        }
+    }
+    else if (strcmp(kind, "closed") == 0){
+        event->Type = RIL_VENDOR_EVENT_CLOSED;
+    }
+    else if (strcmp(kind, "pdpdeact") == 0){
+        event->Type = RIL_VENDOR_EVENT_DETACHED;
+        event->Socket = RIL_VENDOR_NO_SOCKET;
+        event->Value = (int32_t) value;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file ril_vendor_simcom.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief SIMCom profile: SIM7500/SIM7600 and A76xx TCP/IP commands
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_vendor.h"
+
+#if RIL_FEATURE_VENDOR && (RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_SIMCOM)
+
+#include "ril_cmd.h"
+#include <string.h>
+
+/* Longest fixed part of AT+CIPOPEN, the host comes on top */
+#define SIMCOM_OPEN_LEN         40
+
+const RIL_VendorProfile RIL_VENDOR_SIMCOM_PROFILE = {
+    .Name = "SIMCom",
+    .Manufacturer = "SIMCOM",
+    .ReadPrefix = "+CIPRXGET: 2,",
+    .UploadPrompt = NULL,
+    .Id = RIL_VENDOR_SIMCOM,
+    .SendPrompt = '>',
+    .Flags = RIL_VENDOR_OPEN_URC,
+    .AttachSteps = 2,
+    .OpenSteps = 1,
+    .MaxSend = 1500,
+    .MaxRead = 1500,
+    .buildAttach = RIL_simcom_buildAttach,
+    .buildOpen = RIL_simcom_buildOpen,
+    .parseOpen = RIL_simcom_parseOpen,
+    .buildSend = RIL_simcom_buildSend,
+    .buildRead = RIL_simcom_buildRead,
+    .parseRead = RIL_simcom_parseRead,
+    .buildClose = RIL_simcom_buildClose,
+    .buildUpload = RIL_simcom_buildUpload,
+    .parseUrc = RIL_simcom_parseUrc,
+};
+
+uint32_t RIL_simcom_buildAttach(char* buff, uint32_t size, uint8_t step, uint8_t context){
+    // NETOPEN uses the context set by AT+CSOCKSETPN, the default is 1
+    (void) context;
+    if (size < 16){
+        return 0;
+    }
+    switch (step){
+        case 0:
+            // Manual receive, data waits in the modem until AT+CIPRXGET=2
+            return (uint32_t) (RIL_cmd_putLit(buff, "AT+CIPRXGET=1") - buff);
+        case 1:
+            return (uint32_t) (RIL_cmd_putLit(buff, "AT+NETOPEN") - buff);
+        default:
+            return 0;
+    }
+}
+
+uint32_t RIL_simcom_buildOpen(char* buff, uint32_t size, uint8_t step, const RIL_VendorSocket* sock){
+    uint32_t hostLen = (uint32_t) strlen(sock->Host);
+    if (step != 0 || size < SIMCOM_OPEN_LEN + hostLen){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+CIPOPEN=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    pos = sock->Type == RIL_SOCKET_UDP ? RIL_cmd_putLit(pos, ",\"UDP\",\"") : RIL_cmd_putLit(pos, ",\"TCP\",\"");
+    memcpy(pos, sock->Host, hostLen);
+    pos += hostLen;
+    pos = RIL_cmd_putLit(pos, "\",");
+    pos = RIL_cmd_putUint(pos, sock->Port);
+    if (sock->Type == RIL_SOCKET_UDP){
+        // UDP needs a local port, 0 lets the modem pick one
+        pos = RIL_cmd_putLit(pos, ",0");
+    }
+    return (uint32_t) (pos - buff);
+}
+
+void RIL_simcom_parseOpen(uint8_t step, const char* line, uint32_t len, RIL_VendorSocket* sock){
+    // The link number is the one sent, the result comes as +CIPOPEN
+    (void) step;
+    (void) line;
+    (void) len;
+    (void) sock;
+}
+
+uint32_t RIL_simcom_buildSend(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len){
+    if (size < 24){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+CIPSEND=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    *pos++ = ',';
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_simcom_buildRead(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len){
+    if (size < 28){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+CIPRXGET=2,");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    *pos++ = ',';
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+int32_t RIL_simcom_parseRead(const char* line, uint32_t len){
+    // +CIPRXGET: 2,<link_num>,<read_len>,<rest_len>
+    const char* end = line + len;
+    const char* pos = line + 13;
+    uint32_t link;
+    uint32_t dataLen;
+    if (len < 14 || memcmp(line, "+CIPRXGET: 2,", 13) != 0 || !RIL_cmd_parseUint(&pos, end, &link) ||
+        !RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseUint(&pos, end, &dataLen))
+    {
+        return -1;
+    }
+    return (int32_t) dataLen;
+}
+
+uint32_t RIL_simcom_buildClose(char* buff, uint32_t size, const RIL_VendorSocket* sock){
+    if (size < 16){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+CIPCLOSE=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_simcom_buildUpload(char* buff, uint32_t size, const char* name, uint32_t len){
+    // AT+CFTRANRX="c:/<name>",<len>, the data follows '>'
+    uint32_t nameLen = (uint32_t) strlen(name);
+    if (size < 32 + nameLen){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+CFTRANRX=\"c:/");
+    memcpy(pos, name, nameLen);
+    pos += nameLen;
+    pos = RIL_cmd_putLit(pos, "\",");
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+bool RIL_simcom_parseUrc(const char* line, uint32_t len, RIL_PrefixId id, RIL_VendorEvent* event){
+    const char* end = line + len;
+    const char* pos;
+    uint32_t mode;
+    uint32_t value;
+    int32_t err;
+
+    switch (id){
+        case RIL_PREFIX_CIPOPEN:
+            // +CIPOPEN: <link_num>,<err>
+            pos = line + 9;
+            if (!RIL_cmd_parseUint(&pos, end, &value) || !RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseInt(&pos, end, &err)){
+                return false;
+            }
+            event->Type = RIL_VENDOR_EVENT_OPENED;
+            event->Value = err;
+            break;
+        case RIL_PREFIX_CIPRXGET:
+            // +CIPRXGET: 1,<link_num>, the read responses (mode 2, 4) are not URCs
+            pos = line + 10;
+            if (!RIL_cmd_parseUint(&pos, end, &mode) || mode != 1 || !RIL_cmd_nextField(&pos, end) ||
+                !RIL_cmd_parseUint(&pos, end, &value))
+            {
+                return false;
+            }
+            event->Type = RIL_VENDOR_EVENT_RECV;
+            event->Value = -1;
+            break;
+        case RIL_PREFIX_IPCLOSE:
+            // +IPCLOSE: <link_num>,<close_reason>
+            pos = line + 9;
+            if (!RIL_cmd_parseUint(&pos, end, &value)){
+                return false;
+            }
+            event->Type = RIL_VENDOR_EVENT_CLOSED;
+            event->Value = 0;
+            if (RIL_cmd_nextField(&pos, end) && RIL_cmd_parseInt(&pos, end, &err)){
+                event->Value = err;
+            }
+            break;
+        case RIL_PREFIX_CIPEVENT:
+            // +CIPEVENT: NETWORK CLOSED UNEXPECTEDLY
+            value = RIL_VENDOR_NO_SOCKET;
+            event->Type = RIL_VENDOR_EVENT_DETACHED;
+            event->Value = 0;
+            break;
+        default:
+            return false;
+    }
+    event->Socket = (uint8_t) value;
+    return true;
+}
+
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @file ril_vendor_ublox.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief u-blox profile: SARA-R4/R5 and SARA-U2 socket commands
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_vendor.h"
+
+#if RIL_FEATURE_VENDOR && (RIL_VENDOR == RIL_VENDOR_AUTO || RIL_VENDOR == RIL_VENDOR_UBLOX)
+
+#include "ril_cmd.h"
+#include <string.h>
+
+/* Longest fixed part of AT+USOCO, the host comes on top */
+#define UBLOX_CONNECT_LEN       32
+
+const RIL_VendorProfile RIL_VENDOR_UBLOX_PROFILE = {
+    .Name = "u-blox",
+    .Manufacturer = "u-blox",
+    .ReadPrefix = "+USORD:",
+    .UploadPrompt = NULL,
+    .Id = RIL_VENDOR_UBLOX,
+    .SendPrompt = '@',
+    .Flags = RIL_VENDOR_READ_INLINE,
+    .AttachSteps = 1,
+    .OpenSteps = 2,
+    .MaxSend = 1024,
+    .MaxRead = 1024,
+    .buildAttach = RIL_ublox_buildAttach,
+    .buildOpen = RIL_ublox_buildOpen,
+    .parseOpen = RIL_ublox_parseOpen,
+    .buildSend = RIL_ublox_buildSend,
+    .buildRead = RIL_ublox_buildRead,
+    .parseRead = RIL_ublox_parseRead,
+    .buildClose = RIL_ublox_buildClose,
+    .buildUpload = RIL_ublox_buildUpload,
+    .parseUrc = RIL_ublox_parseUrc,
+};
+
+uint32_t RIL_ublox_buildAttach(char* buff, uint32_t size, uint8_t step, uint8_t context){
+    // Activates PSD profile <context>, its APN is set up with AT+UPSD
+    if (step != 0 || size < 16){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+UPSDA=");
+    pos = RIL_cmd_putUint(pos, context);
+    pos = RIL_cmd_putLit(pos, ",3");
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_ublox_buildOpen(char* buff, uint32_t size, uint8_t step, const RIL_VendorSocket* sock){
+    uint32_t hostLen = (uint32_t) strlen(sock->Host);
+    char* pos;
+    switch (step){
+        case 0:
+            // The modem assigns the socket number, see RIL_ublox_parseOpen
+            if (size < 16){
+                return 0;
+            }
+            pos = sock->Type == RIL_SOCKET_UDP ? RIL_cmd_putLit(buff, "AT+USOCR=17") : RIL_cmd_putLit(buff, "AT+USOCR=6");
+            break;
+        case 1:
+            if (size < UBLOX_CONNECT_LEN + hostLen){
+                return 0;
+            }
+            pos = RIL_cmd_putLit(buff, "AT+USOCO=");
+            pos = RIL_cmd_putUint(pos, sock->ModemId);
+            pos = RIL_cmd_putLit(pos, ",\"");
+            memcpy(pos, sock->Host, hostLen);
+            pos += hostLen;
+            pos = RIL_cmd_putLit(pos, "\",");
+            pos = RIL_cmd_putUint(pos, sock->Port);
+            break;
+        default:
+            return 0;
+    }
+    return (uint32_t) (pos - buff);
+}
+
+void RIL_ublox_parseOpen(uint8_t step, const char* line, uint32_t len, RIL_VendorSocket* sock){
+    // +USOCR: <socket>
+    const char* end = line + len;
+    const char* pos = line + 7;
+    uint32_t socket;
+    if (step == 0 && len > 7 && memcmp(line, "+USOCR:", 7) == 0 && RIL_cmd_parseUint(&pos, end, &socket)){
+        sock->ModemId = (uint8_t) socket;
+    }
+}
+
+uint32_t RIL_ublox_buildSend(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len){
+    // Binary mode, the data follows '@' without hex encoding
+    if (size < 24){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+USOWR=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    *pos++ = ',';
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_ublox_buildRead(char* buff, uint32_t size, const RIL_VendorSocket* sock, uint32_t len){
+    if (size < 24){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+USORD=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    *pos++ = ',';
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+int32_t RIL_ublox_parseRead(const char* line, uint32_t len){
+    // +USORD: <socket>,<length>,"<data>", the header ends before the opening quote
+    const char* end = line + len;
+    const char* pos = line + 7;
+    uint32_t socket;
+    uint32_t dataLen;
+    if (len < 8 || memcmp(line, "+USORD:", 7) != 0 || !RIL_cmd_parseUint(&pos, end, &socket) ||
+        !RIL_cmd_nextField(&pos, end) || !RIL_cmd_parseUint(&pos, end, &dataLen))
+    {
+        return -1;
+    }
+    return (int32_t) dataLen;
+}
+
+uint32_t RIL_ublox_buildClose(char* buff, uint32_t size, const RIL_VendorSocket* sock){
+    if (size < 16){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+USOCL=");
+    pos = RIL_cmd_putUint(pos, sock->ModemId);
+    return (uint32_t) (pos - buff);
+}
+
+uint32_t RIL_ublox_buildUpload(char* buff, uint32_t size, const char* name, uint32_t len){
+    // AT+UDWNFILE="<name>",<len>, the data follows '>'
+    uint32_t nameLen = (uint32_t) strlen(name);
+    if (size < 28 + nameLen){
+        return 0;
+    }
+    char* pos = RIL_cmd_putLit(buff, "AT+UDWNFILE=\"");
+    memcpy(pos, name, nameLen);
+    pos += nameLen;
+    pos = RIL_cmd_putLit(pos, "\",");
+    pos = RIL_cmd_putUint(pos, len);
+    return (uint32_t) (pos - buff);
+}
+
+bool RIL_ublox_parseUrc(const char* line, uint32_t len, RIL_PrefixId id, RIL_VendorEvent* event){
+    const char* end = line + len;
+    const char* pos = line + 8;
+    uint32_t value;
+    uint32_t pending;
+
+    switch (id){
+        case RIL_PREFIX_UUSORD:
+        case RIL_PREFIX_UUSORF:
+            // +UUSORD: <socket>,<length>  +UUSORF: <socket>,<length>
+            if (!RIL_cmd_parseUint(&pos, end, &value) || !RIL_cmd_nextField(&pos, end) ||
+                !RIL_cmd_parseUint(&pos, end, &pending))
+            {
+                return false;
+            }
+            event->Type = RIL_VENDOR_EVENT_RECV;
+            event->Socket = (uint8_t) value;
+            event->Value = (int32_t) pending;
+            return true;
+        case RIL_PREFIX_UUSOCL:
+            // +UUSOCL: <socket>
+            if (!RIL_cmd_parseUint(&pos, end, &value)){
+                return false;
+            }
+            event->Type = RIL_VENDOR_EVENT_CLOSED;
+            event->Socket = (uint8_t) value;
+            event->Value = 0;
+            return true;
+        case RIL_PREFIX_UUPSDD:
+            // +UUPSDD: <profile_id>
+            if (!RIL_cmd_parseUint(&pos, end, &value)){
+                return false;
+            }
+            event->Type = RIL_VENDOR_EVENT_DETACHED;
+            event->Socket = RIL_VENDOR_NO_SOCKET;
+            event->Value = (int32_t) value;
+            return true;
+        default:
+            return false;
+    }
+}
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * @file bench_basic.cpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief CPU cost of one AT+CSQ round trip, BasicRil against RIL_SendATCmd
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Both engines talk to a modem that answers at once with the same bytes,
+ * echo included, so the time is what the engine itself spends on the
+ * command and its response. The C engine gets its UART from the loopback
+ * below instead of the simulator, BasicRil reads the reply from memory.
+ * Time is the host clock, best of BENCH_RUNS.
+ */
+
+#include "ril_basic.hpp"
+#include <chrono>
+#include <cstdio>
+
+extern "C" {
+#include "ril.h"
+#include "UARTStream.h"
+}
+
+#define BENCH_ROUNDS        200000
+#define BENCH_RUNS          5
+
+/**
+ * @brief the reply of the loopback modem to cmd: its echo, +CSQ for AT+CSQ, then OK
+ */
+static uint32_t _reply(const uint8_t* cmd, uint32_t len, uint8_t* out){
+    static const char CSQ[] = "\r\n+CSQ: 20,99\r\n";
+    static const char OK[] = "\r\nOK\r\n";
+    uint32_t n = 0;
+    // The command ends with CRLF, the echo with CR
+    uint32_t cmdLen = len >= 2 ? len - 2 : len;
+    std::memcpy(out, cmd, cmdLen);
+    n += cmdLen;
+    out[n++] = '\r';
+    if (cmdLen == 6 && std::memcmp(cmd, "AT+CSQ", 6) == 0) {
+        std::memcpy(&out[n], CSQ, sizeof(CSQ) - 1);
+        n += sizeof(CSQ) - 1;
+    }
+    std::memcpy(&out[n], OK, sizeof(OK) - 1);
+    return n + sizeof(OK) - 1;
+}
+
+/* Loopback UART of the C engine, served from HAL_GetTick as the simulator does */
+static uint8_t replyBuff[RIL_CMD_LEN + 32];
+static uint8_t cmdBuff[RIL_CMD_LEN];
+static uint32_t cmdLen = 0;
+static uint32_t replyLen = 0;
+static uint32_t replyPos = 0;
+static IStream* rxStream;
+static uint8_t* rxBuf;
+static uint32_t rxLen;
+static bool rxArmed = false;
+static uint8_t* txBuf;
+static uint32_t txLen;
+static bool txBusy = false;
+static uint32_t ticks = 0;
+
+extern "C" Stream_Result UARTStream_receive(IStream* stream, uint8_t* buff, Stream_LenType len){
+    rxStream = stream;
+    rxBuf = buff;
+    rxLen = len;
+    rxArmed = true;
+    return Stream_Ok;
+}
+
+extern "C" Stream_Result UARTStream_transmit(OStream* stream, uint8_t* buff, Stream_LenType len){
+    (void) stream;
+    txBuf = buff;
+    txLen = len;
+    txBusy = true;
+    return Stream_Ok;
+}
+
+extern "C" Stream_LenType UARTStream_checkReceivedBytes(IStream* stream){
+    (void) stream;
+    return 0;
+}
+
+extern "C" uint32_t HAL_GetTick(void){
+    if (txBusy) {
+        // A command that wraps around the TX ring comes in two blocks
+        txBusy = false;
+        std::memcpy(&cmdBuff[cmdLen], txBuf, txLen);
+        cmdLen += txLen;
+        if (cmdBuff[cmdLen - 1] == '\n') {
+            replyLen = _reply(cmdBuff, cmdLen, replyBuff);
+            replyPos = 0;
+            cmdLen = 0;
+        }
+        RIL_txCpltHandle();
+    }
+    if (rxArmed && replyPos < replyLen) {
+        uint32_t len = replyLen - replyPos < rxLen ? replyLen - replyPos : rxLen;
+        std::memcpy(rxBuf, &replyBuff[replyPos], len);
+        replyPos += len;
+        rxArmed = false;
+        rxStream->IncomingBytes = static_cast<Stream_LenType>(len);
+        RIL_rxCpltHandle();
+    }
+    // Time stands still, no command times out
+    return ticks;
+}
+
+/**
+ * Transport of BasicRil, the reply is ready as soon as the command is written
+ */
+class LoopbackTransport {
+public:
+    uint32_t readable() {
+        return len_ - pos_;
+    }
+
+    const uint8_t* readPtr() {
+        return &buff_[pos_];
+    }
+
+    void consume(uint32_t len) {
+        pos_ += len;
+    }
+
+    bool write(const uint8_t* data, uint32_t len) {
+        len_ = _reply(data, len, buff_);
+        pos_ = 0;
+        return true;
+    }
+
+private:
+    uint8_t         buff_[RIL_CMD_LEN + 32];
+    uint32_t        len_ = 0;
+    uint32_t        pos_ = 0;
+};
+
+struct FrozenClock {
+    static uint32_t now() {
+        return 0;
+    }
+};
+
+static uint32_t csqLines = 0;
+
+static uint32_t _onCsq(char* line, uint32_t len, void* userData){
+    (void) line;
+    (void) len;
+    (void) userData;
+    csqLines++;
+    return RIL_AT_RSP_CONTINUE;
+}
+
+template <typename F>
+static double _best(F&& round){
+    double best = 0;
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < BENCH_ROUNDS; i++) {
+            if (round() != RIL_AT_SUCCESS) {
+                return 0;
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / BENCH_ROUNDS;
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+int main(){
+    static UART_HandleTypeDef uart;
+    static LoopbackTransport transport;
+    static ril::BasicRil<LoopbackTransport, FrozenClock> basic(transport);
+    int failed = 0;
+
+    if (RIL_initialize(&uart) != RIL_AT_SUCCESS || basic.init() != RIL_AT_SUCCESS) {
+        printf("bench_basic: init failed\n");
+        return 1;
+    }
+
+    double c = _best([] { return RIL_SendATCmd("AT+CSQ", 6, _onCsq, nullptr, 1000); });
+    uint32_t expected = csqLines;
+    csqLines = 0;
+    double cpp = _best([] {
+        return basic.send("AT+CSQ", [](std::string_view) { csqLines++; return RIL_AT_RSP_CONTINUE; }, 1000);
+    });
+
+    printf("bench_basic AT+CSQ with echo, %u round trips, best of %u\n", BENCH_ROUNDS, BENCH_RUNS);
+    printf("  RIL_SendATCmd   %6.1f ns\n", c);
+    printf("  BasicRil::send  %6.1f ns\n", cpp);
+    // Every round trip delivered its +CSQ line to the callback
+    if (c == 0 || cpp == 0 || expected != BENCH_ROUNDS * BENCH_RUNS || csqLines != expected) {
+        printf("  failed\n");
+        failed = 1;
+    }
+    return failed;
+}
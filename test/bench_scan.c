@@ -0,0 +1,101 @@
+/**
+ * @file bench_scan.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief RIL_scanBytes against the byte-at-a-time reference on a modem transcript
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Splits the transcript into lines the way the line reader does, then
+ * walks the argument delimiters of every line, once with each kernel.
+ * Usage: bench_scan [transcript], data/transcript.txt by default.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "ril_scan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef SCAN_KERNEL
+    #define SCAN_KERNEL     "scan"
+#endif
+
+#define BENCH_BYTES         (64UL * 1024 * 1024)
+
+typedef int32_t (*ScanFn)(const uint8_t* buff, uint32_t len, uint8_t a, uint8_t b);
+
+static double _now(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief one pass over the corpus, returns the number of tokens so the work is not optimized out
+ */
+static uint32_t _pass(ScanFn scan, const uint8_t* data, uint32_t len){
+    uint32_t tokens = 0;
+    uint32_t pos = 0;
+    while (pos < len){
+        int32_t eol = scan(&data[pos], len - pos, '\r', '\n');
+        uint32_t lineLen = eol < 0 ? len - pos : (uint32_t) eol;
+        const uint8_t* line = &data[pos];
+        uint32_t at = 0;
+        int32_t delim;
+        while (at < lineLen && (delim = scan(&line[at], lineLen - at, '"', ',')) >= 0){
+            at += (uint32_t) delim + 1;
+            tokens++;
+        }
+        pos += lineLen + 1;
+        tokens++;
+    }
+    return tokens;
+}
+
+static double _run(ScanFn scan, const uint8_t* data, uint32_t len, uint32_t* tokens){
+    uint32_t passes = (uint32_t) (BENCH_BYTES / len) + 1;
+    double start = _now();
+    for (uint32_t i = 0; i < passes; i++){
+        *tokens += _pass(scan, data, len);
+    }
+    return (double) passes * len / (_now() - start) / 1e6;
+}
+
+#ifdef SCAN_NEEDS_AVX2
+    #define SCAN_SUPPORTED()    __builtin_cpu_supports("avx2")
+#else
+    #define SCAN_SUPPORTED()    1
+#endif
+
+int main(int argc, char** argv){
+    if (!SCAN_SUPPORTED()){
+        printf("bench_scan " SCAN_KERNEL ": skipped, the CPU lacks it\n");
+        return 0;
+    }
+    const char* path = argc > 1 ? argv[1] : "data/transcript.txt";
+    FILE* file = fopen(path, "rb");
+    if (file == NULL){
+        printf("bench_scan: can not open %s\n", path);
+        return 1;
+    }
+    static uint8_t data[1 << 20];
+    uint32_t len = (uint32_t) fread(data, 1, sizeof(data), file);
+    fclose(file);
+    if (len == 0){
+        printf("bench_scan: %s is empty\n", path);
+        return 1;
+    }
+
+    uint32_t tokens = 0;
+    // Warm up the caches and the branch predictors of both
+    _run(RIL_scanBytes, data, len, &tokens);
+    _run(RIL_scanBytesRef, data, len, &tokens);
+    double fast = _run(RIL_scanBytes, data, len, &tokens);
+    double ref = _run(RIL_scanBytesRef, data, len, &tokens);
+    printf("bench_scan %-5s %u bytes: RIL_scanBytes %7.1f MB/s, reference %7.1f MB/s, speedup %.2fx (%u)\n",
+           SCAN_KERNEL, len, fast, ref, fast / ref, tokens & 1);
+    return 0;
+}
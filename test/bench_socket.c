@@ -0,0 +1,91 @@
+/**
+ * @file bench_socket.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Download throughput of the modem sockets on the simulator, push against buffer mode
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * A peer sends BENCH_BYTES as soon as the socket is open and the
+ * application reads them from the RX ring. Time is the virtual clock of the
+ * simulator from the open to the last byte, so the numbers are the same on
+ * every host. The busy loop does BUSY_US of other work on every pass.
+ */
+
+#include "ril_socket.h"
+#include "sim_modem.h"
+#include <stdio.h>
+
+#define BENCH_BYTES         20480
+#define BUSY_US             2000
+
+typedef struct {
+    const char*     Name;
+    uint8_t         Type;
+    uint32_t        LatencyMs;
+    uint32_t        LoopUs;         /**< Application work per pass of the loop */
+} BenchCase;
+
+static const BenchCase CASES[] = {
+    { "push",   RIL_SOCKET_TCP | RIL_SOCKET_PUSH,   20, 0 },
+    { "push",   RIL_SOCKET_TCP | RIL_SOCKET_PUSH,   50, BUSY_US },
+    { "buffer", RIL_SOCKET_TCP,                     20, 0 },
+    { "buffer", RIL_SOCKET_TCP,                     50, 0 },
+    { "buffer", RIL_SOCKET_TCP,                     50, BUSY_US },
+};
+
+/**
+ * @brief bytes per ms of one download, 0 when it failed
+ */
+static double _run(const BenchCase* bench, uint32_t* received){
+    static uint8_t buff[512];
+    SimConfig config = {
+        .Baud = 115200, .LatencyMs = bench->LatencyMs, .ConnectMs = 50, .NetworkMs = 30, .LoopUs = 5, .Echo = true,
+    };
+    sim_reset(&config);
+    sim_addPeer("bench.test", 80, SIM_PEER_SOURCE, BENCH_BYTES);
+    if (RIL_initialize(&sim_uart) != RIL_AT_SUCCESS || RIL_socket_init(1) != RIL_AT_SUCCESS){
+        return 0;
+    }
+    int32_t sock = RIL_socket_open(bench->Type, "bench.test", 80, NULL, NULL);
+    if (sock < 0){
+        return 0;
+    }
+    uint64_t start = sim_micros();
+    uint64_t end = start + 60000000;
+    *received = 0;
+    while (*received < BENCH_BYTES && sim_micros() < end){
+        RIL_process();
+        int32_t len = RIL_socket_recv((uint8_t) sock, buff, sizeof(buff));
+        *received += len > 0 ? (uint32_t) len : 0;
+        if (bench->LoopUs > 0){
+            sim_advance(bench->LoopUs);
+        }
+    }
+    uint64_t us = sim_micros() - start;
+    RIL_socket_close((uint8_t) sock);
+    while (RIL_socket_state((uint8_t) sock) != RIL_SOCKET_FREE && sim_micros() < end + 1000000){
+        RIL_process();
+    }
+    return *received == BENCH_BYTES ? BENCH_BYTES * 1000.0 / us : 0;
+}
+
+int main(void){
+    int failed = 0;
+    printf("bench_socket %u bytes at 115200 baud (%u B/s on the wire)\n", BENCH_BYTES, 115200 / 10);
+    for (unsigned i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++){
+        const BenchCase* bench = &CASES[i];
+        uint32_t received = 0;
+        uint32_t dropped = RIL_socket_stats()->Dropped;
+        double rate = _run(bench, &received);
+        printf("  %-6s latency %2u ms, %-9s %5.1f kB/s", bench->Name, (unsigned) bench->LatencyMs,
+               bench->LoopUs > 0 ? "busy loop" : "idle loop", rate);
+        if (rate == 0){
+            printf(", failed after %u bytes", (unsigned) received);
+            failed = 1;
+        }
+        printf(", dropped %u\n", (unsigned) (RIL_socket_stats()->Dropped - dropped));
+    }
+    return failed;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file InputStream.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Host stand-in of the Stream library input stream
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * A receive is armed over the contiguous free part of the ring. When the
+ * ring is full no receive is armed, reading from it arms the next one.
+ */
+
+#ifndef _INPUT_STREAM_H_
+#define _INPUT_STREAM_H_
+
+#include "StreamBuffer.h"
+
+typedef struct IStream IStream;
+typedef Stream_Result (*IStream_ReceiveFn)(IStream* stream, uint8_t* buff, Stream_LenType len);
+typedef Stream_LenType (*IStream_CheckReceiveFn)(IStream* stream);
+
+struct IStream {
+    StreamBuffer            Buffer;
+    IStream_ReceiveFn       receive;
+    IStream_CheckReceiveFn  checkReceive;
+    void*                   Args;
+    Stream_LenType          IncomingBytes;  /**< Length of the armed receive, the driver may lower it on idle line */
+    uint8_t                 InReceive;
+};
+
+void IStream_init(IStream* stream, IStream_ReceiveFn receiveFn, uint8_t* buff, Stream_LenType size);
+void IStream_setCheckReceive(IStream* stream, IStream_CheckReceiveFn fn);
+void IStream_setArgs(IStream* stream, void* args);
+void* IStream_getArgs(IStream* stream);
+Stream_Result IStream_receive(IStream* stream);
+Stream_Result IStream_handle(IStream* stream, Stream_LenType len);
+Stream_LenType IStream_incomingBytes(IStream* stream);
+Stream_LenType IStream_available(IStream* stream);
+Stream_LenType IStream_directAvailable(IStream* stream);
+uint8_t* IStream_getReadPtr(IStream* stream);
+Stream_Result IStream_moveReadPos(IStream* stream, Stream_LenType len);
+
+#endif //_INPUT_STREAM_H_
@@ -0,0 +1,38 @@
+/**
+ * @file OutputStream.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Host stand-in of the Stream library output stream
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#ifndef _OUTPUT_STREAM_H_
+#define _OUTPUT_STREAM_H_
+
+#include "StreamBuffer.h"
+
+typedef struct OStream OStream;
+typedef Stream_Result (*OStream_TransmitFn)(OStream* stream, uint8_t* buff, Stream_LenType len);
+
+struct OStream {
+    StreamBuffer            Buffer;
+    OStream_TransmitFn      transmit;
+    void*                   Args;
+    Stream_LenType          OutgoingBytes;  /**< Length of the transfer in flight */
+    uint8_t                 InTransmit;
+};
+
+void OStream_init(OStream* stream, OStream_TransmitFn transmitFn, uint8_t* buff, Stream_LenType size);
+void OStream_setArgs(OStream* stream, void* args);
+void* OStream_getArgs(OStream* stream);
+Stream_Result OStream_flush(OStream* stream);
+Stream_Result OStream_handle(OStream* stream, Stream_LenType len);
+Stream_LenType OStream_outgoingBytes(OStream* stream);
+Stream_LenType OStream_available(OStream* stream);
+Stream_LenType OStream_space(OStream* stream);
+Stream_Result OStream_writeBytes(OStream* stream, uint8_t* val, Stream_LenType len);
+
+#endif //_OUTPUT_STREAM_H_
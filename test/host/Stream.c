@@ -0,0 +1,229 @@
+/**
+ * @file Stream.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Host stand-in of the Stream library
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "InputStream.h"
+#include "OutputStream.h"
+#include <string.h>
+
+void Stream_init(StreamBuffer* stream, uint8_t* buff, Stream_LenType size){
+    stream->Data = buff;
+    stream->Size = size;
+    Stream_clear(stream);
+}
+
+void Stream_clear(StreamBuffer* stream){
+    stream->WPos = stream->RPos = 0;
+    stream->Full = 0;
+}
+
+Stream_LenType Stream_available(StreamBuffer* stream){
+    if (stream->Full){
+        return stream->Size;
+    }
+    return stream->WPos >= stream->RPos ? stream->WPos - stream->RPos : stream->Size - stream->RPos + stream->WPos;
+}
+
+Stream_LenType Stream_space(StreamBuffer* stream){
+    return stream->Size - Stream_available(stream);
+}
+
+Stream_LenType Stream_directAvailable(StreamBuffer* stream){
+    if (stream->WPos > stream->RPos){
+        return stream->WPos - stream->RPos;
+    }
+    return Stream_available(stream) > 0 ? stream->Size - stream->RPos : 0;
+}
+
+Stream_LenType Stream_directSpace(StreamBuffer* stream){
+    if (stream->RPos > stream->WPos){
+        return stream->RPos - stream->WPos;
+    }
+    return Stream_space(stream) > 0 ? stream->Size - stream->WPos : 0;
+}
+
+uint8_t* Stream_getReadPtr(StreamBuffer* stream){
+    return &stream->Data[stream->RPos];
+}
+
+uint8_t* Stream_getWritePtr(StreamBuffer* stream){
+    return &stream->Data[stream->WPos];
+}
+
+Stream_Result Stream_moveReadPos(StreamBuffer* stream, Stream_LenType len){
+    if (len > Stream_available(stream)){
+        return Stream_NoAvailable;
+    }
+    if (len > 0){
+        stream->RPos = (Stream_LenType) ((stream->RPos + len) % stream->Size);
+        stream->Full = 0;
+    }
+    return Stream_Ok;
+}
+
+Stream_Result Stream_moveWritePos(StreamBuffer* stream, Stream_LenType len){
+    if (len > Stream_space(stream)){
+        return Stream_NoSpace;
+    }
+    if (len > 0){
+        stream->WPos = (Stream_LenType) ((stream->WPos + len) % stream->Size);
+        stream->Full = stream->WPos == stream->RPos;
+    }
+    return Stream_Ok;
+}
+
+Stream_Result Stream_writeBytes(StreamBuffer* stream, uint8_t* val, Stream_LenType len){
+    if (len > Stream_space(stream)){
+        return Stream_NoSpace;
+    }
+    while (len > 0){
+        Stream_LenType part = Stream_directSpace(stream);
+        part = part < len ? part : len;
+        memcpy(Stream_getWritePtr(stream), val, part);
+        Stream_moveWritePos(stream, part);
+        val += part;
+        len -= part;
+    }
+    return Stream_Ok;
+}
+
+Stream_Result Stream_readBytes(StreamBuffer* stream, uint8_t* val, Stream_LenType len){
+    if (len > Stream_available(stream)){
+        return Stream_NoAvailable;
+    }
+    while (len > 0){
+        Stream_LenType part = Stream_directAvailable(stream);
+        part = part < len ? part : len;
+        memcpy(val, Stream_getReadPtr(stream), part);
+        Stream_moveReadPos(stream, part);
+        val += part;
+        len -= part;
+    }
+    return Stream_Ok;
+}
+
+void IStream_init(IStream* stream, IStream_ReceiveFn receiveFn, uint8_t* buff, Stream_LenType size){
+    memset(stream, 0, sizeof(*stream));
+    Stream_init(&stream->Buffer, buff, size);
+    stream->receive = receiveFn;
+}
+
+void IStream_setCheckReceive(IStream* stream, IStream_CheckReceiveFn fn){
+    stream->checkReceive = fn;
+}
+
+void IStream_setArgs(IStream* stream, void* args){
+    stream->Args = args;
+}
+
+void* IStream_getArgs(IStream* stream){
+    return stream->Args;
+}
+
+Stream_Result IStream_receive(IStream* stream){
+    if (stream->InReceive){
+        return Stream_InReceive;
+    }
+    Stream_LenType len = Stream_directSpace(&stream->Buffer);
+    if (len == 0){
+        return Stream_NoSpace;
+    }
+    stream->InReceive = 1;
+    stream->IncomingBytes = len;
+    return stream->receive(stream, Stream_getWritePtr(&stream->Buffer), len);
+}
+
+Stream_Result IStream_handle(IStream* stream, Stream_LenType len){
+    stream->InReceive = 0;
+    stream->IncomingBytes = 0;
+    Stream_Result result = Stream_moveWritePos(&stream->Buffer, len);
+    if (result == Stream_Ok){
+        result = IStream_receive(stream);
+    }
+    return result;
+}
+
+Stream_LenType IStream_incomingBytes(IStream* stream){
+    return stream->IncomingBytes;
+}
+
+Stream_LenType IStream_available(IStream* stream){
+    return Stream_available(&stream->Buffer);
+}
+
+Stream_LenType IStream_directAvailable(IStream* stream){
+    return Stream_directAvailable(&stream->Buffer);
+}
+
+uint8_t* IStream_getReadPtr(IStream* stream){
+    return Stream_getReadPtr(&stream->Buffer);
+}
+
+Stream_Result IStream_moveReadPos(IStream* stream, Stream_LenType len){
+    Stream_Result result = Stream_moveReadPos(&stream->Buffer, len);
+    // A full ring stopped receiving, the room just made restarts it
+    if (result == Stream_Ok && !stream->InReceive && stream->receive != NULL){
+        IStream_receive(stream);
+    }
+    return result;
+}
+
+void OStream_init(OStream* stream, OStream_TransmitFn transmitFn, uint8_t* buff, Stream_LenType size){
+    memset(stream, 0, sizeof(*stream));
+    Stream_init(&stream->Buffer, buff, size);
+    stream->transmit = transmitFn;
+}
+
+void OStream_setArgs(OStream* stream, void* args){
+    stream->Args = args;
+}
+
+void* OStream_getArgs(OStream* stream){
+    return stream->Args;
+}
+
+Stream_Result OStream_flush(OStream* stream){
+    if (stream->InTransmit){
+        return Stream_InTransmit;
+    }
+    Stream_LenType len = Stream_directAvailable(&stream->Buffer);
+    if (len == 0){
+        return Stream_NoAvailable;
+    }
+    stream->InTransmit = 1;
+    stream->OutgoingBytes = len;
+    return stream->transmit(stream, Stream_getReadPtr(&stream->Buffer), len);
+}
+
+Stream_Result OStream_handle(OStream* stream, Stream_LenType len){
+    stream->InTransmit = 0;
+    stream->OutgoingBytes = 0;
+    Stream_Result result = Stream_moveReadPos(&stream->Buffer, len);
+    if (result == Stream_Ok && Stream_available(&stream->Buffer) > 0){
+        OStream_flush(stream);
+    }
+    return result;
+}
+
+Stream_LenType OStream_outgoingBytes(OStream* stream){
+    return stream->OutgoingBytes;
+}
+
+Stream_LenType OStream_available(OStream* stream){
+    return Stream_available(&stream->Buffer);
+}
+
+Stream_LenType OStream_space(OStream* stream){
+    return Stream_space(&stream->Buffer);
+}
+
+Stream_Result OStream_writeBytes(OStream* stream, uint8_t* val, Stream_LenType len){
+    return Stream_writeBytes(&stream->Buffer, val, len);
+}
@@ -0,0 +1,50 @@
+/**
+ * @file StreamBuffer.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Host stand-in of the Stream library ring buffer
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Only the calls RIL makes, with the semantics of the Stream submodule,
+ * so the tests build without the submodules checked out.
+ */
+
+#ifndef _STREAM_BUFFER_H_
+#define _STREAM_BUFFER_H_
+
+#include <stdint.h>
+
+typedef uint16_t Stream_LenType;
+
+typedef enum {
+    Stream_Ok           = 0,
+    Stream_NoSpace      = 1,
+    Stream_NoAvailable  = 2,
+    Stream_InTransmit   = 3,
+    Stream_InReceive    = 4,
+} Stream_Result;
+
+typedef struct {
+    uint8_t*            Data;
+    Stream_LenType      Size;
+    Stream_LenType      WPos;
+    Stream_LenType      RPos;
+    uint8_t             Full;       /**< WPos == RPos means full, not empty */
+} StreamBuffer;
+
+void Stream_init(StreamBuffer* stream, uint8_t* buff, Stream_LenType size);
+void Stream_clear(StreamBuffer* stream);
+Stream_LenType Stream_available(StreamBuffer* stream);
+Stream_LenType Stream_space(StreamBuffer* stream);
+Stream_LenType Stream_directAvailable(StreamBuffer* stream);
+Stream_LenType Stream_directSpace(StreamBuffer* stream);
+uint8_t* Stream_getReadPtr(StreamBuffer* stream);
+uint8_t* Stream_getWritePtr(StreamBuffer* stream);
+Stream_Result Stream_moveReadPos(StreamBuffer* stream, Stream_LenType len);
+Stream_Result Stream_moveWritePos(StreamBuffer* stream, Stream_LenType len);
+Stream_Result Stream_writeBytes(StreamBuffer* stream, uint8_t* val, Stream_LenType len);
+Stream_Result Stream_readBytes(StreamBuffer* stream, uint8_t* val, Stream_LenType len);
+
+#endif //_STREAM_BUFFER_H_
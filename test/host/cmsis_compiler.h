@@ -0,0 +1,47 @@
+/**
+ * @file cmsis_compiler.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Host model of the Cortex-M4 DSP intrinsics RIL uses
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Building ril_scan.c with -D__ARM_FEATURE_DSP=1 on the host picks this
+ * header instead of the CMSIS one, so the __UADD8/__SEL lane logic runs
+ * under the same equivalence test as the other kernels. The APSR.GE flags
+ * are a global, as they are a single register on the core.
+ */
+
+#ifndef _CMSIS_COMPILER_H_
+#define _CMSIS_COMPILER_H_
+
+#include <stdint.h>
+
+static uint32_t _hostGE;
+
+/* Byte-wise add, GE[n] is the carry out of lane n */
+static inline uint32_t __UADD8(uint32_t a, uint32_t b){
+    uint32_t result = 0;
+    _hostGE = 0;
+    for (uint32_t lane = 0; lane < 4; lane++){
+        uint32_t sum = ((a >> (lane * 8)) & 0xFF) + ((b >> (lane * 8)) & 0xFF);
+        result |= (sum & 0xFF) << (lane * 8);
+        if (sum > 0xFF){
+            _hostGE |= 1U << lane;
+        }
+    }
+    return result;
+}
+
+/* Byte-wise select, lane n of a where GE[n] is set, of b otherwise */
+static inline uint32_t __SEL(uint32_t a, uint32_t b){
+    uint32_t result = 0;
+    for (uint32_t lane = 0; lane < 4; lane++){
+        uint32_t mask = 0xFFU << (lane * 8);
+        result |= ((_hostGE >> lane) & 1U) ? (a & mask) : (b & mask);
+    }
+    return result;
+}
+
+#endif //_CMSIS_COMPILER_H_
@@ -0,0 +1,6 @@
+#ifndef _DMA_H_
+#define _DMA_H_
+
+#include "usart.h"
+
+#endif //_DMA_H_
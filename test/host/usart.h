@@ -0,0 +1,24 @@
+/**
+ * @file usart.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Host stand-in of the HAL UART handle and tick
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * HAL_GetTick comes from the simulated board, test/sim/sim_modem.c.
+ */
+
+#ifndef _USART_H_
+#define _USART_H_
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t        Instance;
+} UART_HandleTypeDef;
+
+uint32_t HAL_GetTick(void);
+
+#endif //_USART_H_
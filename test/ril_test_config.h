@@ -0,0 +1,30 @@
+/**
+ * @file ril_test_config.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief RIL configuration of the host engine tests, see RIL_USER_CONFIG
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Everything on, with the sockets of the Quectel profile against the
+ * simulated modem. The RAM budget check stays on, with room for them.
+ * test_vendor builds RIL once more with RIL_VENDOR_AUTO.
+ */
+
+#ifndef _RIL_TEST_CONFIG_H_
+#define _RIL_TEST_CONFIG_H_
+
+#define RIL_FEATURE_SOCKET          1
+#define RIL_FEATURE_CONN            1
+#define RIL_FEATURE_BSD             1
+#define RIL_FEATURE_CORO            1
+#define RIL_CORO_FRAME_SIZE         1280
+#ifndef RIL_VENDOR
+    #define RIL_VENDOR              RIL_VENDOR_QUECTEL
+#endif
+#define RIL_CMD_POOL_SIZE           4
+#define RIL_SOCKET_RX_SIZE          2048
+#define RIL_RAM_BUDGET              16384
+
+#endif //_RIL_TEST_CONFIG_H_
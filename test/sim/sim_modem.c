@@ -0,0 +1,855 @@
+/**
+ * @file sim_modem.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Simulated board and Quectel modem for the host tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "sim_modem.h"
+#include "ril.h"
+#include "UARTStream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_SOCKETS         12
+#define SIM_PEERS           8
+#define SIM_MUTES           4
+#define SIM_SETTINGS        16
+#define SIM_LINE            256
+#define SIM_HELD            65536
+#define SIM_LOG             8192
+#define SIM_LOG_LEN         48
+#define SIM_MAX_SEND        1460
+#define SIM_MAX_PUSH        1500
+
+#define MS                  1000000ULL
+#define US                  1000ULL
+
+/* SimSocket.State */
+#define SOCK_FREE           0
+#define SOCK_OPENING        1
+#define SOCK_OPEN           2
+#define SOCK_CLOSED         3
+
+/* SimEvent.Kind */
+#define EV_OPEN             0
+#define EV_DATA             1
+#define EV_CLOSE            2
+
+/**
+ * Bytes the modem sends to the MCU, not before ReadyNs
+ */
+typedef struct SimChunk {
+    struct SimChunk*    Next;
+    uint64_t            ReadyNs;
+    uint32_t            Len;
+    uint32_t            Pos;
+    uint8_t             Data[];
+} SimChunk;
+
+/**
+ * Something the network does to a modem socket at AtNs
+ */
+typedef struct SimEvent {
+    struct SimEvent*    Next;
+    uint64_t            AtNs;
+    uint32_t            Len;
+    uint8_t             Id;
+    uint8_t             Kind;
+    uint8_t             Data[];
+} SimEvent;
+
+typedef struct {
+    char                Host[64];
+    uint16_t            Port;
+    SimPeerKind         Kind;
+    uint32_t            Bytes;
+} SimPeer;
+
+/**
+ * Value of an AT+<name>=<value> command, AT+<name>? answers "+<name>: <value>"
+ */
+typedef struct {
+    char                Name[16];
+    char                Value[32];
+} SimSetting;
+
+typedef struct {
+    const SimPeer*      Peer;
+    uint32_t            HeldLen;
+    uint8_t             State;
+    bool                Push;
+    bool                Urc;        /**< +QIURC: "recv" reported, until a read comes back empty */
+    uint8_t             Held[SIM_HELD];
+} SimSocket;
+
+UART_HandleTypeDef sim_uart;
+
+static SimConfig cfg;
+static SimStats stats;
+static uint64_t nowNs;
+static uint64_t byteNs;
+static bool pumping = false;
+
+/* Receive armed by the input stream */
+static IStream* rxStream;
+static UARTStream* attached;
+static uint8_t* rxBuf;
+static uint32_t rxLen;
+static uint32_t rxFill;
+static bool rxArmed = false;
+/* Transfer of the output stream on the wire */
+static uint8_t* txBuf;
+static uint32_t txLen;
+static uint64_t txDoneNs;
+static uint64_t txWireNs;
+static bool txBusy = false;
+/* Modem to MCU */
+static SimChunk* outHead;
+static uint64_t wireNs;
+static SimEvent* events;
+
+/* Modem */
+static bool echo;
+static bool verbose;
+static char line[SIM_LINE];
+static uint32_t lineLen;
+static bool lineLf;
+static uint64_t modemNs;
+static int sendId = -1;
+static uint32_t sendLeft;
+static uint32_t sendLen;
+static uint8_t sendBuf[SIM_MAX_SEND];
+static SimSocket sockets[SIM_SOCKETS];
+static SimPeer peers[SIM_PEERS];
+static uint32_t peerCount;
+static char mutes[SIM_MUTES][SIM_LOG_LEN];
+static uint32_t muteCount;
+static char rejects[SIM_MUTES][SIM_LOG_LEN];
+static uint32_t rejectCount;
+static SimSetting settings[SIM_SETTINGS];
+static uint32_t settingCount;
+static char cmdLog[SIM_LOG][SIM_LOG_LEN];
+static uint32_t logCount;
+static const char* cgmiText;
+static const char* atiText;
+static const char* revisionText;
+
+static char resp[4096];
+static uint32_t respLen;
+
+static void _pump(void);
+static void _deliver(void);
+static void _toMcu(const uint8_t* data, uint32_t len);
+static void _rxComplete(void);
+static void _fromMcu(const uint8_t* data, uint32_t len);
+static void _command(const char* cmd);
+static void _emit(uint64_t at, const void* data, uint32_t len);
+static void _event(uint64_t at, uint8_t kind, uint8_t id, const void* data, uint32_t len);
+static void _runEvent(SimEvent* ev);
+static void _put(const void* data, uint32_t len);
+static void _info(const char* text);
+static void _final(const char* text, char numeric);
+static void _send(uint64_t at);
+static void _read(uint8_t id, uint32_t want);
+static void _open(const char* args);
+static bool _compound(const char* cmd);
+static bool _setting(const char* cmd);
+static const SimPeer* _peer(const char* host, uint16_t port);
+
+void sim_reset(const SimConfig* config){
+    static const SimConfig DEFAULTS = {
+        .Baud = 115200,
+        .LatencyMs = 20,
+        .ConnectMs = 50,
+        .NetworkMs = 30,
+        .LoopUs = 5,
+        .Echo = true,
+    };
+    cfg = config != NULL ? *config : DEFAULTS;
+    byteNs = 10ULL * 1000000000ULL / cfg.Baud;
+    memset(&stats, 0, sizeof(stats));
+    while (outHead != NULL){
+        SimChunk* next = outHead->Next;
+        free(outHead);
+        outHead = next;
+    }
+    while (events != NULL){
+        SimEvent* next = events->Next;
+        free(events);
+        events = next;
+    }
+    nowNs += MS;
+    wireNs = txWireNs = nowNs;
+    rxArmed = txBusy = false;
+    echo = cfg.Echo;
+    verbose = true;
+    lineLen = 0;
+    lineLf = false;
+    sendId = -1;
+    for (uint32_t i = 0; i < SIM_SOCKETS; i++){
+        sockets[i].State = SOCK_FREE;
+        sockets[i].HeldLen = 0;
+    }
+    peerCount = muteCount = rejectCount = logCount = 0;
+    // Power-on values of the settings the engine and the tests query
+    settingCount = 2;
+    snprintf(settings[0].Name, sizeof(settings[0].Name), "CMEE");
+    snprintf(settings[0].Value, sizeof(settings[0].Value), "0");
+    snprintf(settings[1].Name, sizeof(settings[1].Name), "CSCS");
+    snprintf(settings[1].Value, sizeof(settings[1].Value), "\"IRA\"");
+    cgmiText = atiText = revisionText = NULL;
+    attached = NULL;
+}
+
+void sim_advance(uint32_t us){
+    nowNs += us * US;
+    _pump();
+}
+
+uint64_t sim_micros(void){
+    return nowNs / US;
+}
+
+void sim_addPeer(const char* host, uint16_t port, SimPeerKind kind, uint32_t bytes){
+    SimPeer* peer = &peers[peerCount++];
+    snprintf(peer->Host, sizeof(peer->Host), "%s", host);
+    peer->Port = port;
+    peer->Kind = kind;
+    peer->Bytes = bytes;
+}
+
+void sim_mute(const char* prefix){
+    if (prefix == NULL){
+        muteCount = 0;
+        return;
+    }
+    snprintf(mutes[muteCount++], SIM_LOG_LEN, "%s", prefix);
+}
+
+void sim_reject(const char* prefix){
+    if (prefix == NULL){
+        rejectCount = 0;
+        return;
+    }
+    snprintf(rejects[rejectCount++], SIM_LOG_LEN, "%s", prefix);
+}
+
+void sim_attach(UARTStream* stream){
+    attached = stream;
+}
+
+void sim_identity(const char* cgmi, const char* ati){
+    cgmiText = cgmi;
+    atiText = ati;
+}
+
+void sim_revision(const char* revision){
+    revisionText = revision;
+}
+
+void sim_urc(const char* text){
+    respLen = 0;
+    _info(text);
+    _emit(nowNs, resp, respLen);
+}
+
+void sim_peerSend(uint8_t connectId, const void* data, uint32_t len){
+    _event(nowNs + cfg.NetworkMs * MS, EV_DATA, connectId, data, len);
+}
+
+void sim_peerClose(uint8_t connectId){
+    _event(nowNs + cfg.NetworkMs * MS, EV_CLOSE, connectId, NULL, 0);
+}
+
+bool sim_socketOpen(uint8_t connectId){
+    return connectId < SIM_SOCKETS && sockets[connectId].State == SOCK_OPEN;
+}
+
+uint32_t sim_socketHeld(uint8_t connectId){
+    return connectId < SIM_SOCKETS ? sockets[connectId].HeldLen : 0;
+}
+
+uint32_t sim_count(const char* prefix){
+    uint32_t count = 0;
+    uint32_t len = (uint32_t) strlen(prefix);
+    for (uint32_t i = 0; i < logCount && i < SIM_LOG; i++){
+        if (strncmp(cmdLog[i], prefix, len) == 0){
+            count++;
+        }
+    }
+    return count;
+}
+
+const SimStats* sim_stats(void){
+    return &stats;
+}
+
+uint32_t HAL_GetTick(void){
+    // Calls from inside the simulated interrupts see the same instant
+    if (!pumping){
+        nowNs += cfg.LoopUs * US;
+        _pump();
+    }
+    return (uint32_t) (nowNs / MS);
+}
+
+Stream_Result UARTStream_receive(IStream* stream, uint8_t* buff, Stream_LenType len){
+    rxStream = stream;
+    rxBuf = buff;
+    rxLen = len;
+    rxFill = 0;
+    rxArmed = true;
+    return Stream_Ok;
+}
+
+Stream_Result UARTStream_transmit(OStream* stream, uint8_t* buff, Stream_LenType len){
+    (void) stream;
+    uint64_t start = nowNs > txWireNs ? nowNs : txWireNs;
+    txBuf = buff;
+    txLen = len;
+    txDoneNs = start + len * byteNs;
+    txBusy = true;
+    return Stream_Ok;
+}
+
+Stream_LenType UARTStream_checkReceivedBytes(IStream* stream){
+    (void) stream;
+    return (Stream_LenType) rxFill;
+}
+
+/**
+ * @brief runs the UART and the modem up to now, the RIL completion handlers
+ *  are called from here as from the UART interrupts
+ */
+static void _pump(void){
+    if (pumping){
+        return;
+    }
+    pumping = true;
+    while (events != NULL && events->AtNs <= nowNs){
+        SimEvent* ev = events;
+        events = ev->Next;
+        _runEvent(ev);
+        free(ev);
+    }
+    while (txBusy && txDoneNs <= nowNs){
+        txBusy = false;
+        txWireNs = txDoneNs;
+        modemNs = txDoneNs;
+        stats.ToModem += txLen;
+        // Parsed before the completion releases the bytes in the ring
+        _fromMcu(txBuf, txLen);
+        if (attached != NULL){
+            OStream_handle(&attached->Output, OStream_outgoingBytes(&attached->Output));
+        }
+        else {
+            RIL_txCpltHandle();
+        }
+    }
+    _deliver();
+    pumping = false;
+}
+
+static void _deliver(void){
+    while (outHead != NULL){
+        SimChunk* chunk = outHead;
+        uint64_t start = chunk->ReadyNs > wireNs ? chunk->ReadyNs : wireNs;
+        if (nowNs < start + byteNs){
+            break;
+        }
+        uint64_t fit = (nowNs - start) / byteNs;
+        uint32_t len = chunk->Len - chunk->Pos;
+        if (fit < len){
+            len = (uint32_t) fit;
+        }
+        wireNs = start + len * byteNs;
+        stats.ToMcu += len;
+        chunk->Pos += len;
+        _toMcu(&chunk->Data[chunk->Pos - len], len);
+        if (chunk->Pos < chunk->Len){
+            break;
+        }
+        outHead = chunk->Next;
+        free(chunk);
+    }
+    // Idle line: one byte time without a byte ends the receive early
+    if (rxArmed && rxFill > 0 && nowNs >= wireNs + byteNs &&
+        (outHead == NULL || outHead->ReadyNs > wireNs))
+    {
+        _rxComplete();
+    }
+}
+
+static void _toMcu(const uint8_t* data, uint32_t len){
+    while (len > 0){
+        if (!rxArmed){
+            stats.Overrun += len;
+            return;
+        }
+        uint32_t take = rxLen - rxFill < len ? rxLen - rxFill : len;
+        memcpy(&rxBuf[rxFill], data, take);
+        rxFill += take;
+        data += take;
+        len -= take;
+        if (rxFill == rxLen){
+            _rxComplete();
+        }
+    }
+}
+
+static void _rxComplete(void){
+    rxArmed = false;
+    rxStream->IncomingBytes = (Stream_LenType) rxFill;
+    if (attached != NULL){
+        IStream_handle(&attached->Input, IStream_incomingBytes(&attached->Input));
+    }
+    else {
+        RIL_rxCpltHandle();
+    }
+}
+
+static void _fromMcu(const uint8_t* data, uint32_t len){
+    for (uint32_t i = 0; i < len; i++){
+        uint8_t c = data[i];
+        // The LF of the CRLF that ended a command, even when data follows it
+        if (lineLf){
+            lineLf = false;
+            if (c == '\n'){
+                continue;
+            }
+        }
+        if (sendId >= 0){
+            sendBuf[sendLen - sendLeft] = c;
+            if (--sendLeft == 0){
+                _send(modemNs);
+            }
+            continue;
+        }
+        if (c == '\r'){
+            lineLf = true;
+            line[lineLen] = 0;
+            if (lineLen > 0){
+                _command(line);
+            }
+            lineLen = 0;
+        }
+        else if (c != '\n' && lineLen < SIM_LINE - 1){
+            line[lineLen++] = (char) c;
+        }
+    }
+}
+
+static void _command(const char* cmd){
+    uint64_t at = modemNs + cfg.LatencyMs * MS;
+    unsigned a, b;
+
+    stats.Commands++;
+    if (logCount < SIM_LOG){
+        snprintf(cmdLog[logCount], SIM_LOG_LEN, "%s", cmd);
+    }
+    logCount++;
+    if (echo){
+        respLen = 0;
+        _put(cmd, (uint32_t) strlen(cmd));
+        _put("\r", 1);
+        _emit(modemNs, resp, respLen);
+    }
+    for (uint32_t i = 0; i < muteCount; i++){
+        if (strncmp(cmd, mutes[i], strlen(mutes[i])) == 0){
+            return;
+        }
+    }
+
+    respLen = 0;
+    for (uint32_t i = 0; i < rejectCount; i++){
+        if (strncmp(cmd, rejects[i], strlen(rejects[i])) == 0){
+            _final("ERROR", '4');
+            _emit(at, resp, respLen);
+            return;
+        }
+    }
+    if (strchr(cmd, ';') != NULL){
+        if (_compound(cmd)){
+            _final("OK", '0');
+        }
+        else {
+            _final("ERROR", '4');
+        }
+    }
+    else if (strcmp(cmd, "AT") == 0 || strncmp(cmd, "AT+QIACT=", 9) == 0 ||
+        strncmp(cmd, "AT+QISDE=", 9) == 0 || strcmp(cmd, "AT&W") == 0)
+    {
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "ATE0") == 0 || strcmp(cmd, "ATE1") == 0){
+        echo = cmd[3] == '1';
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "ATV0") == 0 || strcmp(cmd, "ATV1") == 0){
+        verbose = cmd[3] == '1';
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "AT+CGMI") == 0){
+        _info(cgmiText != NULL ? cgmiText : "Quectel");
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "AT+CGMM") == 0){
+        _info("BG96");
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "AT+CGMR") == 0){
+        _info(revisionText != NULL ? revisionText : "BG96MAR02A07M1G");
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "ATI") == 0){
+        _info(atiText != NULL ? atiText : "Quectel");
+        _info("BG96");
+        _info("Revision: BG96MAR02A07M1G");
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "AT+CSQ") == 0){
+        _info("+CSQ: 20,99");
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "AT+CPIN?") == 0){
+        // No SIM card in the simulated modem
+        _final("+CME ERROR: 10", 0);
+    }
+    else if (strcmp(cmd, "AT+CREG?") == 0){
+        _info("+CREG: 0,1");
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "AT+CLAC") == 0){
+        static const char* const COMMANDS[] = {
+            "AT+CGMI", "AT+CGMR", "AT+CMUX", "AT+IPR", "AT+QIOPEN", "AT+QISEND", "AT+QIRD", "AT+QICLOSE", "AT+QFUPL",
+        };
+        for (uint32_t i = 0; i < sizeof(COMMANDS) / sizeof(COMMANDS[0]); i++){
+            _info(COMMANDS[i]);
+        }
+        _final("OK", '0');
+    }
+    else if (strcmp(cmd, "AT+IPR=?") == 0){
+        _info("+IPR: (0,9600,115200),(9600,115200,460800,921600)");
+        _final("OK", '0');
+    }
+    else if (strncmp(cmd, "AT+QIOPEN=", 10) == 0){
+        _open(cmd + 10);
+    }
+    else if (sscanf(cmd, "AT+QISEND=%u,%u", &a, &b) == 2){
+        if (a >= SIM_SOCKETS || sockets[a].State != SOCK_OPEN || b == 0 || b > SIM_MAX_SEND){
+            _final("ERROR", '4');
+        }
+        else {
+            sendId = (int) a;
+            sendLen = sendLeft = b;
+            _put("> ", 2);
+        }
+    }
+    else if (sscanf(cmd, "AT+QIRD=%u,%u", &a, &b) == 2){
+        stats.Reads++;
+        if (a >= SIM_SOCKETS || sockets[a].State == SOCK_FREE || sockets[a].State == SOCK_OPENING){
+            _final("ERROR", '4');
+        }
+        else {
+            _read((uint8_t) a, b);
+        }
+    }
+    else if (sscanf(cmd, "AT+QICLOSE=%u", &a) == 1){
+        if (a < SIM_SOCKETS){
+            sockets[a].State = SOCK_FREE;
+            sockets[a].HeldLen = 0;
+        }
+        _final("OK", '0');
+    }
+    else if (!_setting(cmd)){
+        _final("ERROR", '4');
+    }
+    else {
+        _final("OK", '0');
+    }
+    _emit(at, resp, respLen);
+}
+
+/**
+ * @brief AT+A?;+B=1, settings only, the parts after the first without their "AT"
+ */
+static bool _compound(const char* cmd){
+    char part[SIM_LINE] = "AT";
+    const char* pos = cmd + 2;
+    while (*pos != 0){
+        const char* end = strchr(pos, ';');
+        uint32_t len = end != NULL ? (uint32_t) (end - pos) : (uint32_t) strlen(pos);
+        if (len + 3 > sizeof(part)){
+            return false;
+        }
+        memcpy(&part[2], pos, len);
+        part[2 + len] = 0;
+        // A failed part ends the line, the answers before it stay
+        if (!_setting(part)){
+            return false;
+        }
+        pos += len + (end != NULL);
+    }
+    return true;
+}
+
+/**
+ * @brief AT+<name>=<value> keeps the value, AT+<name>? answers it
+ */
+static bool _setting(const char* cmd){
+    char name[sizeof(settings[0].Name)];
+    uint32_t len = 0;
+    if (strncmp(cmd, "AT+", 3) != 0){
+        return false;
+    }
+    cmd += 3;
+    while (cmd[len] != 0 && cmd[len] != '=' && cmd[len] != '?' && len < sizeof(name) - 1){
+        name[len] = cmd[len];
+        len++;
+    }
+    name[len] = 0;
+    SimSetting* setting = NULL;
+    for (uint32_t i = 0; i < settingCount && setting == NULL; i++){
+        if (strcmp(settings[i].Name, name) == 0){
+            setting = &settings[i];
+        }
+    }
+    if (strcmp(&cmd[len], "?") == 0){
+        char text[64];
+        if (setting == NULL){
+            return false;
+        }
+        snprintf(text, sizeof(text), "+%s: %s", setting->Name, setting->Value);
+        _info(text);
+        return true;
+    }
+    if (cmd[len] != '=' || cmd[len + 1] == 0 || cmd[len + 1] == '?'){
+        return false;
+    }
+    if (setting == NULL){
+        if (settingCount == SIM_SETTINGS){
+            return false;
+        }
+        setting = &settings[settingCount++];
+        snprintf(setting->Name, sizeof(setting->Name), "%s", name);
+    }
+    snprintf(setting->Value, sizeof(setting->Value), "%s", &cmd[len + 1]);
+    return true;
+}
+
+/**
+ * @brief AT+QIOPEN=<context>,<id>,"TCP","<host>",<port>,0,<mode>
+ */
+static void _open(const char* args){
+    unsigned context, id, port, local, mode;
+    char type[8];
+    char host[64];
+    stats.Opens++;
+    if (sscanf(args, "%u,%u,\"%7[^\"]\",\"%63[^\"]\",%u,%u,%u", &context, &id, type, host, &port, &local, &mode) != 7 ||
+        id >= SIM_SOCKETS)
+    {
+        _final("ERROR", '4');
+        return;
+    }
+    if (sockets[id].State != SOCK_FREE){
+        // Socket identity has been used
+        _final("+CME ERROR: 563", 0);
+        return;
+    }
+    SimSocket* sock = &sockets[id];
+    sock->State = SOCK_OPENING;
+    sock->Push = mode == 1;
+    sock->Urc = false;
+    sock->HeldLen = 0;
+    sock->Peer = _peer(host, (uint16_t) port);
+    _final("OK", '0');
+    if (sock->Peer == NULL || sock->Peer->Kind != SIM_PEER_BLACKHOLE){
+        _event(modemNs + (cfg.LatencyMs + cfg.ConnectMs) * MS, EV_OPEN, (uint8_t) id, NULL, 0);
+    }
+}
+
+/**
+ * @brief data of AT+QISEND is complete
+ */
+static void _send(uint64_t at){
+    SimSocket* sock = &sockets[sendId];
+    respLen = 0;
+    _info("SEND OK");
+    _emit(at + cfg.LatencyMs * MS, resp, respLen);
+    if (sock->Peer != NULL && sock->Peer->Kind == SIM_PEER_ECHO){
+        _event(at + 2 * cfg.NetworkMs * MS, EV_DATA, (uint8_t) sendId, sendBuf, sendLen);
+    }
+    sendId = -1;
+}
+
+static void _read(uint8_t id, uint32_t want){
+    SimSocket* sock = &sockets[id];
+    char header[32];
+    uint32_t len = sock->HeldLen < want ? sock->HeldLen : want;
+    snprintf(header, sizeof(header), "+QIRD: %u", (unsigned) len);
+    _info(header);
+    _put(sock->Held, len);
+    if (len > 0){
+        _put("\r\n", 2);
+    }
+    memmove(sock->Held, &sock->Held[len], sock->HeldLen - len);
+    sock->HeldLen -= len;
+    // New data is reported again once a read found the buffer empty
+    if (len == 0){
+        sock->Urc = false;
+    }
+    _final("OK", '0');
+}
+
+static void _runEvent(SimEvent* ev){
+    SimSocket* sock = &sockets[ev->Id];
+    char text[48];
+    respLen = 0;
+    switch (ev->Kind){
+        case EV_OPEN:
+            if (sock->State != SOCK_OPENING){
+                return;
+            }
+            if (sock->Peer == NULL || sock->Peer->Kind == SIM_PEER_REFUSE){
+                sock->State = SOCK_FREE;
+                snprintf(text, sizeof(text), "+QIOPEN: %u,%u", ev->Id, sock->Peer == NULL ? 565u : 566u);
+                _info(text);
+                break;
+            }
+            sock->State = SOCK_OPEN;
+            snprintf(text, sizeof(text), "+QIOPEN: %u,0", ev->Id);
+            _info(text);
+            if (sock->Peer->Kind == SIM_PEER_SOURCE || sock->Peer->Kind == SIM_PEER_CLOSE){
+                uint8_t segment[SIM_MAX_SEND];
+                uint64_t at = ev->AtNs + cfg.NetworkMs * MS;
+                for (uint32_t sent = 0; sent < sock->Peer->Bytes; sent += SIM_MAX_SEND, at += MS){
+                    uint32_t len = sock->Peer->Bytes - sent < SIM_MAX_SEND ? sock->Peer->Bytes - sent : SIM_MAX_SEND;
+                    for (uint32_t i = 0; i < len; i++){
+                        segment[i] = (uint8_t) (sent + i);
+                    }
+                    _event(at, EV_DATA, ev->Id, segment, len);
+                }
+                if (sock->Peer->Kind == SIM_PEER_CLOSE){
+                    _event(at, EV_CLOSE, ev->Id, NULL, 0);
+                }
+            }
+            break;
+        case EV_DATA:
+            if (sock->State != SOCK_OPEN){
+                return;
+            }
+            if (sock->Push){
+                for (uint32_t pos = 0; pos < ev->Len; pos += SIM_MAX_PUSH){
+                    uint32_t len = ev->Len - pos < SIM_MAX_PUSH ? ev->Len - pos : SIM_MAX_PUSH;
+                    snprintf(text, sizeof(text), "+QIURC: \"recv\",%u,%u", ev->Id, (unsigned) len);
+                    _info(text);
+                    _put(&ev->Data[pos], len);
+                }
+                break;
+            }
+            if (sock->HeldLen + ev->Len <= SIM_HELD){
+                memcpy(&sock->Held[sock->HeldLen], ev->Data, ev->Len);
+                sock->HeldLen += ev->Len;
+            }
+            if (!sock->Urc){
+                sock->Urc = true;
+                snprintf(text, sizeof(text), "+QIURC: \"recv\",%u", ev->Id);
+                _info(text);
+            }
+            break;
+        case EV_CLOSE:
+            if (sock->State != SOCK_OPEN){
+                return;
+            }
+            sock->State = SOCK_CLOSED;
+            snprintf(text, sizeof(text), "+QIURC: \"closed\",%u", ev->Id);
+            _info(text);
+            break;
+        default:
+            return;
+    }
+    _emit(ev->AtNs, resp, respLen);
+}
+
+/**
+ * @brief queues bytes for the MCU, in order of their ready time. A chunk that
+ *  is already on the wire is never overtaken.
+ */
+static void _emit(uint64_t at, const void* data, uint32_t len){
+    if (len == 0){
+        return;
+    }
+    SimChunk* chunk = (SimChunk*) malloc(sizeof(SimChunk) + len);
+    chunk->ReadyNs = at;
+    chunk->Len = len;
+    chunk->Pos = 0;
+    memcpy(chunk->Data, data, len);
+    SimChunk** pos = &outHead;
+    while (*pos != NULL && ((*pos)->ReadyNs <= at || (*pos)->Pos > 0)){
+        pos = &(*pos)->Next;
+    }
+    chunk->Next = *pos;
+    *pos = chunk;
+}
+
+static void _event(uint64_t at, uint8_t kind, uint8_t id, const void* data, uint32_t len){
+    SimEvent* ev = (SimEvent*) malloc(sizeof(SimEvent) + len);
+    ev->AtNs = at;
+    ev->Kind = kind;
+    ev->Id = id;
+    ev->Len = len;
+    if (len > 0){
+        memcpy(ev->Data, data, len);
+    }
+    SimEvent** pos = &events;
+    while (*pos != NULL && (*pos)->AtNs <= at){
+        pos = &(*pos)->Next;
+    }
+    ev->Next = *pos;
+    *pos = ev;
+}
+
+static void _put(const void* data, uint32_t len){
+    if (respLen + len <= sizeof(resp)){
+        memcpy(&resp[respLen], data, len);
+        respLen += len;
+    }
+}
+
+/**
+ * @brief response line, framed by the result format
+ */
+static void _info(const char* text){
+    if (verbose){
+        _put("\r\n", 2);
+    }
+    _put(text, (uint32_t) strlen(text));
+    _put("\r\n", 2);
+}
+
+/**
+ * @brief final result code, numeric is its ATV0 digit, 0 when it has none
+ */
+static void _final(const char* text, char numeric){
+    if (!verbose && numeric != 0){
+        _put(&numeric, 1);
+        _put("\r", 1);
+        return;
+    }
+    _info(text);
+}
+
+static const SimPeer* _peer(const char* host, uint16_t port){
+    for (uint32_t i = 0; i < peerCount; i++){
+        if (strcmp(peers[i].Host, host) == 0 && peers[i].Port == port){
+            return &peers[i];
+        }
+    }
+    return NULL;
+}
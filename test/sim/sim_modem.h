@@ -0,0 +1,138 @@
+/**
+ * @file sim_modem.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Simulated board and Quectel modem for the host tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * The board side provides HAL_GetTick and the UARTStream calls: the UART
+ * moves bytes both ways at the configured baud rate, a receive ends when
+ * its block is full or the line goes idle, and bytes that arrive while no
+ * receive is armed are lost, as on the real UART.
+ *
+ * Time is virtual. Every HAL_GetTick call costs LoopUs, sim_advance stands
+ * for application work outside RIL. The modem and the network run on the
+ * same clock, so results do not depend on the speed of the host.
+ *
+ * The modem answers the basic AT set and the Quectel TCP/IP commands
+ * (AT+QIACT, AT+QIOPEN, AT+QISEND, AT+QIRD, AT+QICLOSE) in buffer and
+ * direct push access mode, against the peers registered with sim_addPeer.
+ * Any other AT+<name>=<value> is kept as a setting that AT+<name>? reads
+ * back, also on one line with others, AT+A?;+B=1.
+ */
+
+#ifndef _SIM_MODEM_H_
+#define _SIM_MODEM_H_
+
+#include "usart.h"
+#include "UARTStream.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t        Baud;           /**< UART rate both ways, 10 bits per byte */
+    uint32_t        LatencyMs;      /**< From the end of a command to its response */
+    uint32_t        ConnectMs;      /**< From AT+QIOPEN to +QIOPEN */
+    uint32_t        NetworkMs;      /**< One way delay to the peers */
+    uint32_t        LoopUs;         /**< Virtual time of one HAL_GetTick call */
+    bool            Echo;           /**< ATE1 at power on */
+} SimConfig;
+
+typedef enum {
+    SIM_PEER_ECHO       = 0,    /**< Sends back what it receives */
+    SIM_PEER_SOURCE     = 1,    /**< Sends Bytes after the connect, then stays open */
+    SIM_PEER_CLOSE      = 2,    /**< Sends Bytes after the connect, then closes */
+    SIM_PEER_SILENT     = 3,    /**< Accepts and never sends */
+    SIM_PEER_REFUSE     = 4,    /**< +QIOPEN: <id>,566 */
+    SIM_PEER_BLACKHOLE  = 5,    /**< No +QIOPEN at all */
+} SimPeerKind;
+
+typedef struct {
+    uint32_t        Commands;       /**< Command lines the modem parsed */
+    uint32_t        Overrun;        /**< Bytes that arrived with no receive armed */
+    uint32_t        ToModem;        /**< Bytes the MCU sent */
+    uint32_t        ToMcu;          /**< Bytes the modem sent */
+    uint32_t        Opens;          /**< AT+QIOPEN commands */
+    uint32_t        Reads;          /**< AT+QIRD commands */
+} SimStats;
+
+/* The UART handle to pass to RIL_initialize */
+extern UART_HandleTypeDef sim_uart;
+
+/*******************************************************************************
+* @brief Completes the UART transfers on stream instead of through
+*   RIL_rxCpltHandle/RIL_txCpltHandle, for an engine with its own UARTStream
+*   such as BasicRil. NULL goes back to ril.c, so does sim_reset.
+******************************************************************************/
+void sim_attach(UARTStream* stream);
+
+/*******************************************************************************
+* @brief Powers the modem on with config, NULL for 115200 baud, 20 ms
+*   latency and echo on. Peers and muted commands are cleared.
+******************************************************************************/
+void sim_reset(const SimConfig* config);
+
+/*******************************************************************************
+* @brief Lets time pass outside RIL, the UART and the modem keep running
+******************************************************************************/
+void sim_advance(uint32_t us);
+
+uint64_t sim_micros(void);
+
+/*******************************************************************************
+* @brief Registers a server, Bytes is the length SOURCE and CLOSE peers send
+******************************************************************************/
+void sim_addPeer(const char* host, uint16_t port, SimPeerKind kind, uint32_t bytes);
+
+/*******************************************************************************
+* @brief Commands starting with prefix get no answer, NULL clears the list
+******************************************************************************/
+void sim_mute(const char* prefix);
+
+/*******************************************************************************
+* @brief Commands starting with prefix get ERROR, NULL clears the list
+******************************************************************************/
+void sim_reject(const char* prefix);
+
+/*******************************************************************************
+* @brief Answer of AT+CGMI and first line of ATI, NULL for "Quectel", back to
+*   Quectel on sim_reset. The modem still speaks the Quectel command set.
+******************************************************************************/
+void sim_identity(const char* cgmi, const char* ati);
+
+/*******************************************************************************
+* @brief Answer of AT+CGMR, NULL for "BG96MAR02A07M1G", also back on sim_reset
+******************************************************************************/
+void sim_revision(const char* revision);
+
+/*******************************************************************************
+* @brief Sends a URC line now, CRLF is added around it
+******************************************************************************/
+void sim_urc(const char* line);
+
+/*******************************************************************************
+* @brief Data from the peer of a connected modem socket, after NetworkMs
+******************************************************************************/
+void sim_peerSend(uint8_t connectId, const void* data, uint32_t len);
+
+/*******************************************************************************
+* @brief The peer of a modem socket closes after NetworkMs
+******************************************************************************/
+void sim_peerClose(uint8_t connectId);
+
+/*******************************************************************************
+* @brief Whether the modem socket is connected, bytes it still holds for AT+QIRD
+******************************************************************************/
+bool sim_socketOpen(uint8_t connectId);
+uint32_t sim_socketHeld(uint8_t connectId);
+
+/*******************************************************************************
+* @brief Number of parsed commands that start with prefix
+******************************************************************************/
+uint32_t sim_count(const char* prefix);
+
+const SimStats* sim_stats(void);
+
+#endif //_SIM_MODEM_H_
@@ -0,0 +1,41 @@
+/**
+ * @file test.h
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Minimal assertions of the host tests
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * A failed check prints its location and the test keeps running, main
+ * returns TEST_RESULT() so make stops on the first failing binary.
+ */
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <stdio.h>
+
+static unsigned testFailures = 0;
+static unsigned testChecks = 0;
+
+#define TEST_CHECK(COND)    do { \
+        testChecks++; \
+        if (!(COND)){ \
+            testFailures++; \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #COND); \
+        } \
+    } while (0)
+
+#define TEST_EQ(A, B)       do { \
+        long long _a = (long long) (A), _b = (long long) (B); \
+        testChecks++; \
+        if (_a != _b){ \
+            testFailures++; \
+            printf("%s:%d: %s == %s failed: %lld != %lld\n", __FILE__, __LINE__, #A, #B, _a, _b); \
+        } \
+    } while (0)
+
+#define TEST_RESULT(NAME)   (printf("%s: %u checks, %u failed\n", NAME, testChecks, testFailures), testFailures != 0)
+
+#endif //_TEST_H_
@@ -0,0 +1,134 @@
+/**
+ * @file test_basic.cpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief BasicRil of ril_basic.hpp on a UARTStream of its own, against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_basic.hpp"
+#include "ril_transport.hpp"
+#include <cstdio>
+#include <string_view>
+
+extern "C" {
+#include "sim_modem.h"
+#include "test.h"
+}
+
+using namespace std::string_view_literals;
+using Modem = ril::BasicRil<ril::StreamTransport, ril::HalClock>;
+
+static uint8_t rxBuff[RIL_RX_STREAM_SIZE];
+static uint8_t txBuff[RIL_TX_STREAM_SIZE];
+static UARTStream uart;
+
+/**
+ * @brief the stream setup of ril.c, the simulator completes its transfers
+ */
+static void _start(){
+    sim_reset(nullptr);
+    uart.HUART = &sim_uart;
+    IStream_init(&uart.Input, UARTStream_receive, rxBuff, sizeof(rxBuff));
+    IStream_setCheckReceive(&uart.Input, UARTStream_checkReceivedBytes);
+    IStream_setArgs(&uart.Input, &uart);
+    OStream_init(&uart.Output, UARTStream_transmit, txBuff, sizeof(txBuff));
+    OStream_setArgs(&uart.Output, &uart);
+    sim_attach(&uart);
+    IStream_receive(&uart.Input);
+}
+
+static void _testSend(Modem& modem){
+    char csq[32] = "";
+    uint32_t lines = 0;
+    auto onLine = [&](std::string_view line) {
+        std::snprintf(csq, sizeof(csq), "%.*s", static_cast<int>(line.size()), line.data());
+        lines++;
+        return RIL_AT_RSP_CONTINUE;
+    };
+    TEST_EQ(modem.send("AT+CSQ", onLine, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(lines, 1);
+    TEST_CHECK(std::string_view(csq) == "+CSQ: 20,99"sv);
+
+    // Three intermediate lines, the echo is not one of them
+    lines = 0;
+    TEST_EQ(modem.send("ATI", onLine, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(lines, 3);
+    TEST_CHECK(std::string_view(csq) == "Revision: BG96MAR02A07M1G"sv);
+
+    // The line callback fails the command, the final result is still read
+    TEST_EQ(modem.send("AT+CSQ", [](std::string_view) { return RIL_AT_RSP_FAILED; }, 1000), RIL_AT_FAILED);
+    TEST_EQ(modem.send("AT", 1000), RIL_AT_SUCCESS);
+}
+
+static void _testErrors(Modem& modem){
+    TEST_EQ(modem.send("AT+CPIN?", 1000), RIL_AT_FAILED);
+    TEST_EQ(modem.lastError().type, RIL_ERROR_AT);
+    TEST_EQ(modem.lastError().atError, 10);
+
+    TEST_EQ(modem.send("AT+NOPE", 1000), RIL_AT_FAILED);
+    TEST_EQ(modem.lastError().atError, (uint32_t) RIL_AT_FAILED);
+
+    char longCmd[RIL_CMD_LEN];
+    std::memset(longCmd, 'A', sizeof(longCmd));
+    TEST_EQ(modem.send(std::string_view(longCmd, sizeof(longCmd) - 2), 1000), RIL_AT_INVALID_PARAM);
+    TEST_EQ(modem.send(std::string_view(longCmd, sizeof(longCmd) - 3), 1000), RIL_AT_FAILED);
+}
+
+static void _testTimeout(Modem& modem){
+    sim_mute("AT+CSQ");
+    uint64_t start = sim_micros();
+    TEST_EQ(modem.send("AT+CSQ", 200), RIL_AT_TIMEOUT);
+    uint64_t waited = sim_micros() - start;
+    TEST_CHECK(waited >= 199000 && waited < 210000);
+    sim_mute(nullptr);
+
+    // Nothing of the timed out command is left for the next one
+    uint32_t lines = 0;
+    TEST_EQ(modem.send("AT+CREG?", [&lines](std::string_view line) {
+        lines += line == "+CREG: 0,1"sv;
+        return RIL_AT_RSP_CONTINUE;
+    }, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(lines, 1);
+}
+
+static void _testUrc(Modem& modem){
+    uint32_t urcs = 0;
+    RIL_PrefixId id = RIL_PREFIX_NONE;
+    modem.setUrcHandler([&](std::string_view, RIL_PrefixId prefix) {
+        urcs++;
+        id = prefix;
+    });
+    sim_urc("+QIURC: \"closed\",1");
+    sim_advance(5000);
+    modem.poll();
+    TEST_EQ(urcs, 1);
+    TEST_EQ(id, RIL_PREFIX_QIURC);
+
+    // Inside a command, it goes to the handler and not to the line callback
+    uint32_t lines = 0;
+    sim_urc("RING");
+    TEST_EQ(modem.send("AT", [&lines](std::string_view) { lines++; return RIL_AT_RSP_CONTINUE; }, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(lines, 0);
+    TEST_EQ(urcs, 2);
+    TEST_EQ(id, RIL_PREFIX_RING);
+    modem.setUrcHandler(nullptr);
+}
+
+int main(){
+    static ril::StreamTransport transport(uart);
+    static Modem modem(transport);
+
+    _start();
+    TEST_EQ(modem.init(), RIL_AT_SUCCESS);
+    // BasicConfig matches the echo, init leaves it on
+    TEST_EQ(sim_count("ATE0"), 0);
+    _testSend(modem);
+    _testErrors(modem);
+    _testTimeout(modem);
+    _testUrc(modem);
+    return TEST_RESULT("test_basic");
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_batch.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Deferred commands of ril_batch.c against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_batch.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+typedef struct {
+    RIL_ATSndError      Result;
+    bool                Done;
+} Reply;
+
+static void _onDone(RIL_ATSndError result, void* userData){
+    Reply* reply = (Reply*) userData;
+    reply->Result = result;
+    reply->Done = true;
+}
+
+static void _run(uint32_t ms){
+    uint64_t end = sim_micros() + ms * 1000ULL;
+    while (sim_micros() < end){
+        RIL_process();
+    }
+}
+
+/**
+ * @brief modem socket 0 connected to an echo peer, then quiet until the awake window is over
+ */
+static void _start(void){
+    sim_reset(NULL);
+    sim_addPeer("echo.test", 7, SIM_PEER_ECHO, 0);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_SendATCmd("AT+QIOPEN=1,0,\"TCP\",\"echo.test\",7,0,0", 37, NULL, NULL, 1000), RIL_AT_SUCCESS);
+    _run(200);
+    TEST_CHECK(sim_socketOpen(0));
+    _run(RIL_BATCH_AWAKE_MS + 100);
+    RIL_batch_resetStats();
+}
+
+/**
+ * A deferred data send waits with a deferred query and both go out on the
+ * wake a URC causes
+ */
+static void _testPiggyback(void){
+    static const char DATA[] = "hello";
+    RIL_Payload payload = { .Data = DATA, .Len = 5, .Prompt = '>' };
+    Reply query = { 0 };
+    Reply send = { 0 };
+    _start();
+
+    TEST_EQ(RIL_batch_defer("AT+CSQ", 6, NULL, _onDone, &query, 1000, 5000), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_batch_deferPayload("AT+QISEND=0,5", 13, &payload, NULL, _onDone, &send, 1000, 5000), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_batch_pending(), 2);
+    _run(500);
+    TEST_EQ(sim_count("AT+CSQ"), 0);
+    TEST_EQ(sim_count("AT+QISEND"), 0);
+
+    sim_urc("+CREG: 1");
+    _run(300);
+    TEST_CHECK(query.Done && send.Done);
+    TEST_EQ(query.Result, RIL_AT_SUCCESS);
+    TEST_EQ(send.Result, RIL_AT_SUCCESS);
+    TEST_EQ(sim_count("AT+QISEND"), 1);
+    // The peer got the data and sent it back
+    TEST_EQ(sim_socketHeld(0), 5);
+    TEST_EQ(RIL_batch_stats()->Sent, 2);
+    TEST_EQ(RIL_batch_stats()->Wakes, 0);
+    TEST_EQ(RIL_batch_stats()->Piggybacked, 1);
+    TEST_EQ(RIL_batch_pending(), 0);
+}
+
+/**
+ * Nothing wakes the modem, the data goes out at its latency bound
+ */
+static void _testDeadline(void){
+    static const char DATA[] = "late";
+    RIL_Payload payload = { .Data = DATA, .Len = 4, .Prompt = '>' };
+    Reply send = { 0 };
+    _start();
+
+    uint64_t start = sim_micros();
+    TEST_EQ(RIL_batch_deferPayload("AT+QISEND=0,4", 13, &payload, NULL, _onDone, &send, 1000, 200), RIL_AT_SUCCESS);
+    while (sim_count("AT+QISEND") == 0 && sim_micros() - start < 1000000){
+        RIL_process();
+    }
+    TEST_CHECK(sim_micros() - start >= 199000 && sim_micros() - start < 220000);
+    _run(200);
+    TEST_CHECK(send.Done);
+    TEST_EQ(send.Result, RIL_AT_SUCCESS);
+    TEST_EQ(sim_socketHeld(0), 4);
+    TEST_EQ(RIL_batch_stats()->Wakes, 1);
+
+    TEST_EQ(RIL_batch_deferPayload("AT+QISEND=0,4", 13, NULL, NULL, NULL, NULL, 1000, 200), RIL_AT_INVALID_PARAM);
+}
+
+int main(void){
+    _testPiggyback();
+    _testDeadline();
+    return TEST_RESULT("test_batch");
+}
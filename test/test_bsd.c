@@ -0,0 +1,241 @@
+/**
+ * @file test_bsd.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief BSD socket calls of ril_bsd.c against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_bsd.h"
+#include "ril_socket.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+static void _start(void){
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_init(1), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_attach(), RIL_AT_SUCCESS);
+}
+
+/**
+ * @brief 10.0.0.1:port in network byte order on any host, the simulated
+ *  peers are registered under the dotted address
+ */
+static struct RIL_sockaddr_in _addr(uint16_t port){
+    static const uint8_t IP[4] = { 10, 0, 0, 1 };
+    struct RIL_sockaddr_in addr = { .sin_family = RIL_AF_INET };
+    uint8_t* bytes = (uint8_t*) &addr.sin_port;
+    bytes[0] = (uint8_t) (port >> 8);
+    bytes[1] = (uint8_t) port;
+    memcpy(&addr.sin_addr.s_addr, IP, sizeof(IP));
+    return addr;
+}
+
+static int _connect(int fd, uint16_t port){
+    struct RIL_sockaddr_in addr = _addr(port);
+    return RIL_bsd_connect(fd, (const struct RIL_sockaddr*) &addr, sizeof(addr));
+}
+
+static void _timeout(int fd, int name, long ms){
+    struct RIL_timeval tv = { .tv_sec = ms / 1000, .tv_usec = (ms % 1000) * 1000 };
+    TEST_EQ(RIL_bsd_setsockopt(fd, RIL_SOL_SOCKET, name, &tv, sizeof(tv)), 0);
+}
+
+/**
+ * @brief closes the descriptor and runs the engine until the modem socket is free again
+ */
+static void _close(int fd){
+    TEST_EQ(RIL_bsd_close(fd), 0);
+    uint64_t end = sim_micros() + 1000000;
+    bool busy = true;
+    while (busy && sim_micros() < end){
+        RIL_process();
+        busy = false;
+        for (uint8_t sock = 0; sock < RIL_SOCKET_COUNT; sock++){
+            busy |= RIL_socket_state(sock) != RIL_SOCKET_FREE;
+        }
+    }
+    TEST_CHECK(!busy);
+}
+
+static void _testEcho(void){
+    char buff[16] = "";
+    _start();
+    sim_addPeer("10.0.0.1", 7, SIM_PEER_ECHO, 0);
+
+    int fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    TEST_CHECK(fd >= 0);
+    TEST_EQ(_connect(fd, 7), 0);
+    TEST_EQ(sim_stats()->Opens, 1);
+    TEST_EQ(_connect(fd, 7), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EISCONN);
+
+    TEST_EQ(RIL_bsd_send(fd, "hello", 5, 0), 5);
+    // Blocks until the echo is back from the peer
+    TEST_EQ(RIL_bsd_recv(fd, buff, sizeof(buff), 0), 5);
+    TEST_CHECK(memcmp(buff, "hello", 5) == 0);
+    _close(fd);
+
+    TEST_EQ(RIL_bsd_send(fd, "x", 1, 0), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EBADF);
+    TEST_EQ(sim_stats()->Overrun, 0);
+}
+
+static void _testTimeouts(void){
+    char buff[16];
+    _start();
+    sim_addPeer("10.0.0.1", 9, SIM_PEER_SILENT, 0);
+    sim_addPeer("10.0.0.1", 10, SIM_PEER_BLACKHOLE, 0);
+
+    // Connected, but the peer never sends
+    int fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    TEST_EQ(_connect(fd, 9), 0);
+    _timeout(fd, RIL_SO_RCVTIMEO, 200);
+    uint64_t start = sim_micros();
+    TEST_EQ(RIL_bsd_recv(fd, buff, sizeof(buff), 0), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EAGAIN);
+    TEST_CHECK(sim_micros() - start >= 199000 && sim_micros() - start < 220000);
+    _close(fd);
+
+    // No +QIOPEN ever comes, the descriptor gives up and can connect again
+    fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    _timeout(fd, RIL_SO_SNDTIMEO, 300);
+    start = sim_micros();
+    TEST_EQ(_connect(fd, 10), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_ETIMEDOUT);
+    TEST_CHECK(sim_micros() - start >= 299000 && sim_micros() - start < 320000);
+    TEST_EQ(_connect(fd, 9), 0);
+    _close(fd);
+}
+
+static void _testNonBlocking(void){
+    char buff[16];
+    _start();
+    sim_addPeer("10.0.0.1", 7, SIM_PEER_ECHO, 0);
+
+    int fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    TEST_EQ(RIL_bsd_fcntl(fd, RIL_F_SETFL, RIL_O_NONBLOCK), 0);
+    TEST_EQ(RIL_bsd_fcntl(fd, RIL_F_GETFL, 0), RIL_O_NONBLOCK);
+    TEST_EQ(_connect(fd, 7), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EINPROGRESS);
+    TEST_EQ(_connect(fd, 7), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EALREADY);
+
+    // Writable once +QIOPEN reported the connection
+    struct RIL_pollfd pfd = { .fd = fd, .events = RIL_POLLOUT };
+    TEST_EQ(RIL_bsd_poll(&pfd, 1, 0), 0);
+    TEST_EQ(RIL_bsd_poll(&pfd, 1, 1000), 1);
+    TEST_EQ(pfd.revents, RIL_POLLOUT);
+    int error = -1;
+    uint32_t len = sizeof(error);
+    TEST_EQ(RIL_bsd_getsockopt(fd, RIL_SOL_SOCKET, RIL_SO_ERROR, &error, &len), 0);
+    TEST_EQ(error, 0);
+
+    TEST_EQ(RIL_bsd_recv(fd, buff, sizeof(buff), 0), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EAGAIN);
+    TEST_EQ(RIL_bsd_send(fd, "ping", 4, 0), 4);
+    pfd.events = RIL_POLLIN;
+    TEST_EQ(RIL_bsd_poll(&pfd, 1, 1000), 1);
+    TEST_EQ(pfd.revents, RIL_POLLIN);
+    TEST_EQ(RIL_bsd_recv(fd, buff, sizeof(buff), 0), 4);
+    TEST_CHECK(memcmp(buff, "ping", 4) == 0);
+
+    // Blocking descriptor, the call itself may not wait
+    TEST_EQ(RIL_bsd_fcntl(fd, RIL_F_SETFL, 0), 0);
+    TEST_EQ(RIL_bsd_recv(fd, buff, sizeof(buff), RIL_MSG_DONTWAIT), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EAGAIN);
+    _close(fd);
+}
+
+static void _testEndOfStream(void){
+    uint8_t buff[64];
+    uint32_t total = 0;
+    int32_t got;
+    _start();
+    sim_addPeer("10.0.0.1", 80, SIM_PEER_CLOSE, 300);
+
+    int fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    TEST_EQ(_connect(fd, 80), 0);
+    // The peer sends its bytes and closes, the data still comes before the end
+    while ((got = RIL_bsd_recv(fd, buff, sizeof(buff), 0)) > 0){
+        for (int32_t i = 0; i < got; i++){
+            TEST_EQ(buff[i], (uint8_t) (total + i));
+        }
+        total += (uint32_t) got;
+    }
+    TEST_EQ(got, 0);
+    TEST_EQ(total, 300);
+    TEST_EQ(RIL_bsd_recv(fd, buff, sizeof(buff), 0), 0);
+
+    struct RIL_pollfd pfd = { .fd = fd, .events = RIL_POLLIN };
+    TEST_EQ(RIL_bsd_poll(&pfd, 1, 0), 1);
+    TEST_EQ(pfd.revents, RIL_POLLIN | RIL_POLLHUP);
+    TEST_EQ(RIL_bsd_send(fd, "x", 1, 0), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EPIPE);
+    _close(fd);
+}
+
+static void _testRefused(void){
+    _start();
+    sim_addPeer("10.0.0.1", 23, SIM_PEER_REFUSE, 0);
+
+    int fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    TEST_EQ(_connect(fd, 23), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_ECONNREFUSED);
+    _close(fd);
+
+    // Non-blocking the refusal shows up in poll and SO_ERROR
+    fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    TEST_EQ(RIL_bsd_fcntl(fd, RIL_F_SETFL, RIL_O_NONBLOCK), 0);
+    TEST_EQ(_connect(fd, 23), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EINPROGRESS);
+    struct RIL_pollfd pfd = { .fd = fd, .events = RIL_POLLOUT };
+    TEST_EQ(RIL_bsd_poll(&pfd, 1, 1000), 1);
+    TEST_CHECK(pfd.revents & RIL_POLLERR);
+    int error = 0;
+    uint32_t len = sizeof(error);
+    TEST_EQ(RIL_bsd_getsockopt(fd, RIL_SOL_SOCKET, RIL_SO_ERROR, &error, &len), 0);
+    TEST_EQ(error, RIL_ECONNREFUSED);
+    _close(fd);
+
+    // An address nobody listens on fails the same way
+    fd = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0);
+    TEST_EQ(_connect(fd, 24), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_ECONNREFUSED);
+    _close(fd);
+}
+
+static void _testDescriptors(void){
+    int fds[RIL_SOCKET_COUNT];
+    for (int i = 0; i < RIL_SOCKET_COUNT; i++){
+        fds[i] = RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_DGRAM, 0);
+        TEST_CHECK(fds[i] >= 0);
+    }
+    TEST_EQ(RIL_bsd_socket(RIL_AF_INET, RIL_SOCK_STREAM, 0), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EMFILE);
+    TEST_EQ(RIL_bsd_socket(10, RIL_SOCK_STREAM, 0), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_EAFNOSUPPORT);
+    TEST_EQ(RIL_bsd_recv(fds[0], NULL, 1, 0), -1);
+    TEST_EQ(RIL_bsd_errno, RIL_ENOTCONN);
+    for (int i = 0; i < RIL_SOCKET_COUNT; i++){
+        TEST_EQ(RIL_bsd_close(fds[i]), 0);
+    }
+    struct RIL_pollfd pfd = { .fd = fds[0], .events = RIL_POLLIN };
+    TEST_EQ(RIL_bsd_poll(&pfd, 1, 0), 1);
+    TEST_EQ(pfd.revents, RIL_POLLNVAL);
+}
+
+int main(void){
+    _testEcho();
+    _testTimeouts();
+    _testNonBlocking();
+    _testEndOfStream();
+    _testRefused();
+    _testDescriptors();
+    return TEST_RESULT("test_bsd");
+}
@@ -0,0 +1,184 @@
+/**
+ * @file test_caps.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Capability discovery of ril_caps.c with RIL_store_file, and the socket
+ *   layer gated by its flags, against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#define _DEFAULT_SOURCE
+#include "ril_caps.h"
+#include "ril_socket.h"
+#include "ril_store.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* AT+CLAC of the simulated modem: CMUX, IPR, QIOPEN, QISEND, QIRD, QFUPL */
+#define CLAC_FLAGS      (RIL_CAP_CLAC | RIL_CAP_CMUX | RIL_CAP_BAUD | RIL_CAP_PUSH_RECV | RIL_CAP_BINARY_SEND | \
+                         RIL_CAP_BUFFERED_RECV | RIL_CAP_FILE_UPLOAD)
+
+static char dir[] = "/tmp/ril_caps_XXXXXX";
+
+static void _testDiscover(void){
+    TEST_CHECK(!RIL_caps_valid());
+    TEST_EQ(RIL_caps_discover(false), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_caps_valid());
+    TEST_CHECK(!RIL_caps_fromStore());
+    TEST_EQ(RIL_caps()->Flags, CLAC_FLAGS | RIL_CAP_COMPOUND);
+    TEST_EQ(RIL_caps()->MaxBaud, 921600);
+    TEST_EQ(RIL_caps()->Vendor, RIL_VENDOR_QUECTEL);
+    TEST_CHECK(strcmp(RIL_caps()->Firmware, "BG96MAR02A07M1G") == 0);
+    TEST_CHECK(!RIL_caps_has(RIL_CAP_PSM));
+    TEST_CHECK(RIL_caps_has(RIL_CAP_CMUX | RIL_CAP_COMPOUND));
+    TEST_EQ(sim_count("AT+CLAC"), 1);
+}
+
+/**
+ * The same firmware costs AT+CGMR only, another one is discovered again
+ */
+static void _testStore(void){
+    uint32_t commands = sim_stats()->Commands;
+    TEST_EQ(RIL_caps_discover(false), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_caps_fromStore());
+    TEST_EQ(sim_stats()->Commands - commands, 1);
+    TEST_EQ(RIL_caps()->Flags, CLAC_FLAGS | RIL_CAP_COMPOUND);
+    TEST_EQ(RIL_caps()->MaxBaud, 921600);
+
+    // Kept across a power cycle of both sides
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_caps_discover(false), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_caps_fromStore());
+    TEST_EQ(sim_count("AT+CLAC"), 0);
+
+    sim_revision("BG96MAR02A08M1G");
+    TEST_EQ(RIL_caps_discover(false), RIL_AT_SUCCESS);
+    TEST_CHECK(!RIL_caps_fromStore());
+    TEST_EQ(sim_count("AT+CLAC"), 1);
+    TEST_CHECK(strcmp(RIL_caps()->Firmware, "BG96MAR02A08M1G") == 0);
+    TEST_EQ(RIL_caps_discover(false), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_caps_fromStore());
+
+    // A damaged record is not taken
+    char path[64];
+    snprintf(path, sizeof(path), "%s/ril_%u.bin", dir, (unsigned) RIL_STORE_CAPS);
+    FILE* file = fopen(path, "r+b");
+    TEST_CHECK(file != NULL);
+    if (file != NULL){
+        fseek(file, offsetof(RIL_Caps, MaxBaud), SEEK_SET);
+        fputc(0x55, file);
+        fclose(file);
+    }
+    TEST_EQ(RIL_caps_discover(false), RIL_AT_SUCCESS);
+    TEST_CHECK(!RIL_caps_fromStore());
+    TEST_EQ(RIL_caps()->MaxBaud, 921600);
+
+    TEST_EQ(RIL_caps_discover(true), RIL_AT_SUCCESS);
+    TEST_CHECK(!RIL_caps_fromStore());
+    TEST_EQ(sim_count("AT+CLAC"), 3);
+}
+
+/**
+ * What the modem rejects leaves its flags clear
+ */
+static void _testFallback(void){
+    sim_reject("AT+CLAC");
+    TEST_EQ(RIL_caps_discover(true), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_caps()->Vendor, RIL_VENDOR_QUECTEL);
+    TEST_EQ(RIL_caps()->Flags, RIL_CAP_BINARY_SEND | RIL_CAP_BUFFERED_RECV | RIL_CAP_PUSH_RECV | RIL_CAP_FILE_UPLOAD |
+                               RIL_CAP_CMUX | RIL_CAP_BAUD | RIL_CAP_COMPOUND);
+
+    // No vendor in ATI, no defaults
+    sim_identity(NULL, "Acme");
+    TEST_EQ(RIL_caps_discover(true), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_caps()->Vendor, RIL_VENDOR_AUTO);
+    TEST_EQ(RIL_caps()->Flags, RIL_CAP_BAUD | RIL_CAP_COMPOUND);
+    sim_identity(NULL, NULL);
+
+    sim_reject("AT+IPR=?");
+    sim_reject("AT+CMEE?;");
+    TEST_EQ(RIL_caps_discover(true), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_caps()->MaxBaud, 0);
+    TEST_CHECK(!RIL_caps_has(RIL_CAP_BAUD));
+    TEST_CHECK(!RIL_caps_has(RIL_CAP_COMPOUND));
+    sim_reject(NULL);
+}
+
+/**
+ * @brief takes over a record with these flags, as RIL_resume does
+ */
+static void _restore(uint32_t flags){
+    RIL_Caps record;
+    memset(&record, 0, sizeof(record));
+    record.Flags = flags;
+    record.Vendor = RIL_VENDOR_QUECTEL;
+    record.Check = RIL_hash(RIL_HASH_INIT, &record.Flags, sizeof(record) - offsetof(RIL_Caps, Flags));
+    TEST_CHECK(RIL_caps_restore(&record));
+}
+
+static bool _openSent(const char* mode){
+    char cmd[64];
+    int32_t sock = RIL_socket_open(RIL_SOCKET_TCP | RIL_SOCKET_PUSH, "echo.test", 7, NULL, NULL);
+    TEST_CHECK(sock >= 0);
+    if (sock < 0){
+        return false;
+    }
+    snprintf(cmd, sizeof(cmd), "AT+QIOPEN=1,%d,\"TCP\",\"echo.test\",7,0,%s", (int) sock, mode);
+    uint32_t before = sim_count(cmd);
+    uint64_t end = sim_micros() + 1000000;
+    while (RIL_socket_state((uint8_t) sock) == RIL_SOCKET_OPENING && sim_micros() < end){
+        RIL_process();
+    }
+    bool sent = sim_count(cmd) == before + 1;
+    RIL_socket_close((uint8_t) sock);
+    while (RIL_socket_state((uint8_t) sock) != RIL_SOCKET_FREE && sim_micros() < end + 1000000){
+        RIL_process();
+    }
+    return sent;
+}
+
+static void _testSocket(void){
+    sim_reset(NULL);
+    sim_addPeer("echo.test", 7, SIM_PEER_ECHO, 0);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_init(1), RIL_AT_SUCCESS);
+
+    _restore(RIL_CAP_BINARY_SEND | RIL_CAP_BUFFERED_RECV | RIL_CAP_PUSH_RECV);
+    TEST_CHECK(_openSent("1"));
+    // Push asked for, the modem can not, buffer mode
+    _restore(RIL_CAP_BINARY_SEND | RIL_CAP_BUFFERED_RECV);
+    TEST_CHECK(_openSent("0"));
+
+    _restore(RIL_CAP_BUFFERED_RECV | RIL_CAP_PUSH_RECV);
+    TEST_EQ(RIL_socket_open(RIL_SOCKET_TCP | RIL_SOCKET_PUSH, "echo.test", 7, NULL, NULL), RIL_AT_FAILED);
+    _restore(RIL_CAP_BINARY_SEND | RIL_CAP_PUSH_RECV);
+    TEST_EQ(RIL_socket_open(RIL_SOCKET_TCP, "echo.test", 7, NULL, NULL), RIL_AT_FAILED);
+    TEST_CHECK(_openSent("1"));
+}
+
+int main(void){
+    TEST_CHECK(mkdtemp(dir) != NULL);
+    RIL_Store store = RIL_store_file(dir);
+    RIL_store_set(&store);
+
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    _testDiscover();
+    _testStore();
+    _testFallback();
+    _testSocket();
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s/ril_%u.bin", dir, (unsigned) RIL_STORE_CAPS);
+    remove(path);
+    remove(dir);
+    return TEST_RESULT("test_caps");
+}
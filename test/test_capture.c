@@ -0,0 +1,102 @@
+/**
+ * @file test_capture.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Response capture of ril_capture.c against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_capture.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+static bool _lineIs(const RIL_Capture* capture, uint16_t index, const char* text){
+    uint32_t len = 0;
+    const char* line = RIL_capture_line(capture, index, &len);
+    return line != NULL && len == strlen(text) && strcmp(line, text) == 0;
+}
+
+/**
+ * ATI answers "Quectel", "BG96" and "Revision: BG96MAR02A07M1G"
+ */
+static void _testOverflow(void){
+    char arena[20];
+    RIL_LineSpan lines[4];
+    RIL_Capture capture;
+    RIL_capture_init(&capture, arena, sizeof(arena), lines, 4);
+
+    // The third line does not fit the arena, the first two are intact
+    TEST_EQ(RIL_SendATCmdCapture("ATI", 3, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.LineCount, 2);
+    TEST_EQ(capture.Truncated, 1);
+    TEST_EQ(capture.ArenaUsed, 8 + 5);
+    TEST_CHECK(_lineIs(&capture, 0, "Quectel"));
+    TEST_CHECK(_lineIs(&capture, 1, "BG96"));
+    TEST_CHECK(RIL_capture_line(&capture, 2, NULL) == NULL);
+
+    // The line and its terminator fit exactly, one byte less does not
+    char exact[12];
+    RIL_capture_init(&capture, exact, sizeof(exact), lines, 4);
+    TEST_EQ(RIL_SendATCmdCapture("AT+CSQ", 6, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.Truncated, 0);
+    TEST_CHECK(_lineIs(&capture, 0, "+CSQ: 20,99"));
+    RIL_capture_init(&capture, exact, sizeof(exact) - 1, lines, 4);
+    TEST_EQ(RIL_SendATCmdCapture("AT+CSQ", 6, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.Truncated, 1);
+    TEST_EQ(capture.LineCount, 0);
+
+    // Out of spans with room left in the arena
+    char big[128];
+    RIL_capture_init(&capture, big, sizeof(big), lines, 2);
+    TEST_EQ(RIL_SendATCmdCapture("ATI", 3, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.LineCount, 2);
+    TEST_EQ(capture.Truncated, 1);
+}
+
+/**
+ * One capture for several commands, each starts from an empty one
+ */
+static void _testReuse(void){
+    char arena[64];
+    RIL_LineSpan lines[4];
+    RIL_Capture capture;
+    RIL_capture_init(&capture, arena, sizeof(arena), lines, 4);
+
+    TEST_EQ(RIL_SendATCmdCapture("ATI", 3, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.LineCount, 3);
+    TEST_CHECK(_lineIs(&capture, 2, "Revision: BG96MAR02A07M1G"));
+
+    TEST_EQ(RIL_SendATCmdCapture("AT+CPIN?", 8, &capture, 1000), RIL_AT_FAILED);
+    TEST_EQ(capture.Result, RIL_AT_FAILED);
+    TEST_EQ(capture.ErrCode, 10);
+    TEST_EQ(capture.LineCount, 0);
+    TEST_EQ(capture.ArenaUsed, 0);
+
+    TEST_EQ(RIL_SendATCmdCapture("AT+CSQ", 6, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.Result, RIL_AT_SUCCESS);
+    TEST_EQ(capture.ErrCode, 0);
+    TEST_EQ(capture.LineCount, 1);
+    TEST_EQ(capture.Truncated, 0);
+    TEST_CHECK(_lineIs(&capture, 0, "+CSQ: 20,99"));
+    TEST_CHECK(RIL_capture_line(&capture, 1, NULL) == NULL);
+
+    // A truncated response does not leave the flag on the next one
+    RIL_capture_init(&capture, arena, 10, lines, 4);
+    TEST_EQ(RIL_SendATCmdCapture("ATI", 3, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.Truncated, 1);
+    TEST_EQ(RIL_SendATCmdCapture("AT", 2, &capture, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(capture.Truncated, 0);
+    TEST_EQ(capture.LineCount, 0);
+}
+
+int main(void){
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    _testOverflow();
+    _testReuse();
+    return TEST_RESULT("test_capture");
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_cmd.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Generated commands of ril_cmd.c and ril_cmd_gen.c against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_cmd.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+/**
+ * AT+CSQ is cached for 2000 ms
+ */
+static void _testCache(void){
+    RIL_CSQ_Response csq = {0};
+    uint32_t sent = sim_count("AT+CSQ");
+
+    TEST_EQ(RIL_CSQ_send(&csq), RIL_AT_SUCCESS);
+    TEST_EQ(csq.Rssi, 20);
+    TEST_EQ(csq.Ber, 99);
+    TEST_EQ(RIL_cmd_parseStatus(), RIL_CMD_PARSE_OK);
+    TEST_EQ(sim_count("AT+CSQ"), sent + 1);
+
+    // Answered from the cache, nothing goes to the modem
+    memset(&csq, 0, sizeof(csq));
+    sim_advance(1000000);
+    TEST_EQ(RIL_CSQ_send(&csq), RIL_AT_SUCCESS);
+    TEST_EQ(csq.Rssi, 20);
+    TEST_EQ(csq.Ber, 99);
+    TEST_EQ(sim_count("AT+CSQ"), sent + 1);
+
+    // Too old
+    sim_advance(1100000);
+    TEST_EQ(RIL_CSQ_send(&csq), RIL_AT_SUCCESS);
+    TEST_EQ(sim_count("AT+CSQ"), sent + 2);
+
+    // Dropped
+    RIL_cmd_invalidate(RIL_CMD_CSQ);
+    TEST_EQ(RIL_CSQ_send(NULL), RIL_AT_SUCCESS);
+    TEST_EQ(sim_count("AT+CSQ"), sent + 3);
+    RIL_cmd_invalidate(RIL_CMD_COUNT);
+    TEST_EQ(RIL_CSQ_send(&csq), RIL_AT_SUCCESS);
+    TEST_EQ(sim_count("AT+CSQ"), sent + 4);
+}
+
+static void _testStatus(void){
+    // Optional fields absent
+    RIL_CREG_Response creg;
+    memset(&creg, 0xFF, sizeof(creg));
+    TEST_EQ(RIL_CREG_send(&creg), RIL_AT_SUCCESS);
+    TEST_EQ(creg.N, 0);
+    TEST_EQ(creg.Stat, 1);
+    TEST_EQ(creg.Present, 0);
+
+    // The first intermediate line
+    RIL_CGMI_Response cgmi;
+    TEST_EQ(RIL_CGMI_send(&cgmi), RIL_AT_SUCCESS);
+    TEST_CHECK(strcmp(cgmi.Manufacturer, "Quectel") == 0);
+
+    // OK without the +CSQ line
+    RIL_CSQ_Response csq;
+    RIL_cmd_invalidate(RIL_CMD_CSQ);
+    TEST_EQ(RIL_cmd_exec(RIL_CMD_CSQ, "AT", 2, &csq), RIL_AT_FAILED);
+    TEST_EQ(RIL_cmd_parseStatus(), RIL_CMD_PARSE_NO_LINE);
+
+    // The modem fails the command, nothing was parsed
+    RIL_CPIN_Response cpin;
+    TEST_EQ(RIL_CPIN_send(&cpin), RIL_AT_FAILED);
+    TEST_EQ(RIL_cmd_parseStatus(), RIL_CMD_PARSE_NO_LINE);
+
+    // The index of the first bad field
+    TEST_EQ(RIL_CSQ_parse("+CSQ: 20,99", 11, &csq), RIL_CMD_PARSE_OK);
+    TEST_EQ(RIL_CSQ_parse("+CSQ: x,99", 10, &csq), 0);
+    TEST_EQ(RIL_CSQ_parse("+CSQ: 20,", 9, &csq), 1);
+    TEST_EQ(RIL_CSQ_parse("+CREG: 0,1", 10, &csq), RIL_CMD_PARSE_NO_LINE);
+    TEST_EQ(RIL_cmd_exec(RIL_CMD_COUNT, "AT", 2, NULL), RIL_AT_INVALID_PARAM);
+}
+
+/**
+ * AT has two retries on timeout, AT+CPIN? none
+ */
+static void _testRetry(void){
+    uint32_t sent = sim_count("AT");
+    uint64_t start = sim_micros();
+    sim_mute("AT");
+    TEST_EQ(RIL_AT_send(), RIL_AT_TIMEOUT);
+    sim_mute(NULL);
+    TEST_EQ(sim_count("AT") - sent, 3);
+    // Each attempt waits its 300 ms, counted in whole ticks
+    TEST_CHECK(sim_micros() - start >= 3 * 299000ULL);
+
+    TEST_EQ(RIL_AT_send(), RIL_AT_SUCCESS);
+    TEST_EQ(sim_count("AT") - sent, 4);
+
+    // An error is an answer
+    sent = sim_count("AT+CPIN?");
+    TEST_EQ(RIL_CPIN_send(NULL), RIL_AT_FAILED);
+    TEST_EQ(sim_count("AT+CPIN?") - sent, 1);
+}
+
+int main(void){
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    _testCache();
+    _testStatus();
+    _testRetry();
+    return TEST_RESULT("test_cmd");
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_conn.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Socket pool of ril_conn.c against the simulated modem: reuse per key,
+ *   eviction, dead and expired idle sockets
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_conn.h"
+#include "sim_modem.h"
+#include "test.h"
+
+static const RIL_ConnKey PLAIN = { "a.test", 80, RIL_SOCKET_TCP, 0 };
+static const RIL_ConnKey TLS = { "a.test", 80, RIL_SOCKET_TCP, 1 };
+static const RIL_ConnKey OTHER = { "b.test", 80, RIL_SOCKET_TCP, 0 };
+
+/**
+ * @brief acquires a socket of key and runs the engine until it is open
+ */
+static int32_t _acquire(const RIL_ConnKey* key, bool* reused){
+    int32_t sock = RIL_conn_acquire(key, NULL, NULL, reused);
+    TEST_CHECK(sock >= 0);
+    uint64_t end = sim_micros() + 1000000;
+    while (sock >= 0 && RIL_socket_state((uint8_t) sock) == RIL_SOCKET_OPENING && sim_micros() < end){
+        RIL_process();
+    }
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+    return sock;
+}
+
+static void _untilFree(uint8_t sock){
+    uint64_t end = sim_micros() + 1000000;
+    while (RIL_socket_state(sock) != RIL_SOCKET_FREE && sim_micros() < end){
+        RIL_process();
+    }
+    TEST_EQ(RIL_socket_state(sock), RIL_SOCKET_FREE);
+}
+
+static void _testReuse(void){
+    bool reused = true;
+    int32_t sock = _acquire(&PLAIN, &reused);
+    TEST_CHECK(!reused);
+    TEST_EQ(sim_stats()->Opens, 1);
+    RIL_conn_release((uint8_t) sock, true);
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+
+    // Open and writable at once, no second AT+QIOPEN
+    TEST_EQ(RIL_conn_acquire(&PLAIN, NULL, NULL, &reused), sock);
+    TEST_CHECK(reused);
+    TEST_EQ(sim_stats()->Opens, 1);
+    TEST_EQ(RIL_conn_stats()->Opened, 1);
+    TEST_EQ(RIL_conn_stats()->Reused, 1);
+    RIL_conn_release((uint8_t) sock, true);
+}
+
+/**
+ * The idle plain socket does not serve a TLS session, and takes the only
+ * slot another key needs
+ */
+static void _testTlsAndEvict(void){
+    bool reused = true;
+    int32_t plain = RIL_conn_acquire(&PLAIN, NULL, NULL, NULL);
+    RIL_conn_release((uint8_t) plain, true);
+
+    int32_t tls = _acquire(&TLS, &reused);
+    TEST_CHECK(!reused);
+    TEST_CHECK(tls != plain);
+    TEST_EQ(sim_stats()->Opens, 2);
+
+    // Every slot taken, the idle one is closed to make room
+    TEST_EQ(RIL_conn_acquire(&OTHER, NULL, NULL, &reused), RIL_AT_BUSY);
+    TEST_EQ(RIL_conn_stats()->Evicted, 1);
+    _untilFree((uint8_t) plain);
+    int32_t other = _acquire(&OTHER, &reused);
+    TEST_EQ(other, plain);
+    TEST_CHECK(!reused);
+    TEST_EQ(sim_stats()->Opens, 3);
+
+    // None idle, nothing to evict
+    TEST_EQ(RIL_conn_acquire(&PLAIN, NULL, NULL, &reused), RIL_AT_BUSY);
+    TEST_EQ(RIL_conn_stats()->Evicted, 1);
+
+    RIL_conn_release((uint8_t) tls, false);
+    _untilFree((uint8_t) tls);
+    RIL_conn_release((uint8_t) other, true);
+}
+
+/**
+ * +QIURC: "closed" on the idle socket
+ */
+static void _testDead(void){
+    bool reused = true;
+    int32_t sock = RIL_conn_acquire(&OTHER, NULL, NULL, &reused);
+    TEST_CHECK(reused);
+    RIL_conn_release((uint8_t) sock, true);
+
+    sim_peerClose((uint8_t) sock);
+    uint64_t end = sim_micros() + 1000000;
+    while (RIL_conn_stats()->Dead == 0 && sim_micros() < end){
+        RIL_process();
+    }
+    TEST_EQ(RIL_conn_stats()->Dead, 1);
+    _untilFree((uint8_t) sock);
+
+    sock = _acquire(&OTHER, &reused);
+    TEST_CHECK(!reused);
+    RIL_conn_release((uint8_t) sock, true);
+}
+
+static void _testExpiry(void){
+    uint32_t opened = RIL_conn_stats()->Opened;
+    bool reused = true;
+    int32_t sock = RIL_conn_acquire(&OTHER, NULL, NULL, &reused);
+    TEST_CHECK(reused);
+    RIL_conn_release((uint8_t) sock, true);
+
+    sim_advance((RIL_CONN_IDLE_MS - 10) * 1000);
+    RIL_process();
+    TEST_EQ(RIL_conn_stats()->Expired, 0);
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+
+    sim_advance(10 * 1000);
+    RIL_process();
+    TEST_EQ(RIL_conn_stats()->Expired, 1);
+    _untilFree((uint8_t) sock);
+
+    sock = _acquire(&OTHER, &reused);
+    TEST_CHECK(!reused);
+    TEST_EQ(RIL_conn_stats()->Opened, opened + 1);
+    RIL_conn_release((uint8_t) sock, false);
+    _untilFree((uint8_t) sock);
+}
+
+int main(void){
+    sim_reset(NULL);
+    sim_addPeer("a.test", 80, SIM_PEER_SILENT, 0);
+    sim_addPeer("b.test", 80, SIM_PEER_SILENT, 0);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_init(1), RIL_AT_SUCCESS);
+
+    _testReuse();
+    _testTlsAndEvict();
+    _testDead();
+    _testExpiry();
+    return TEST_RESULT("test_conn");
+}
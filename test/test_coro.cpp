@@ -0,0 +1,179 @@
+/**
+ * @file test_coro.cpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Coroutines of ril_coro.hpp against the simulated modem, C++20
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_coro.hpp"
+#include <string_view>
+
+extern "C" {
+#include "sim_modem.h"
+#include "test.h"
+}
+
+using namespace std::string_view_literals;
+using ril::Result;
+
+/**
+ * @brief spawns task and polls the executor until it is over, at most one second of virtual time
+ */
+static void _run(ril::Task<>&& task){
+    TEST_CHECK(ril::Executor::spawn(std::move(task)));
+    uint64_t end = sim_micros() + 1000000;
+    while (!ril::Executor::idle() && sim_micros() < end){
+        ril::Executor::poll();
+    }
+    TEST_CHECK(ril::Executor::idle());
+}
+
+static ril::Task<> _send(bool* done){
+    ril::Response r = co_await ril::send("AT+CSQ");
+    TEST_CHECK(r.ok());
+    TEST_EQ(r.lineCount(), 1);
+    TEST_CHECK(r.line(0) == "+CSQ: 20,99"sv);
+    TEST_CHECK(r.line(1).empty());
+
+    r = co_await ril::send("ATI");
+    TEST_CHECK(r.ok() && !r.truncated());
+    TEST_EQ(r.lineCount(), 3);
+    TEST_CHECK(r.line(0) == "Quectel"sv);
+    TEST_CHECK(r.line(2) == "Revision: BG96MAR02A07M1G"sv);
+
+    r = co_await ril::send("AT+NOPE");
+    TEST_EQ(r.result(), RIL_AT_FAILED);
+    TEST_EQ(r.lineCount(), 0);
+    *done = true;
+}
+
+/**
+ * A copy has its own storage and outlives the response it was taken from
+ */
+static ril::Task<> _copy(bool* done){
+    ril::Response copy;
+    {
+        ril::Response ati = co_await ril::send("ATI");
+        copy = ati;
+        ati = co_await ril::send("AT+CSQ");
+        TEST_CHECK(ati.line(0) == "+CSQ: 20,99"sv);
+    }
+    TEST_CHECK(copy.ok());
+    TEST_EQ(copy.lineCount(), 3);
+    TEST_CHECK(copy.line(1) == "BG96"sv);
+    ril::Response again(copy);
+    TEST_CHECK(again.line(2) == "Revision: BG96MAR02A07M1G"sv);
+    *done = true;
+}
+
+static ril::Task<int> _signal(){
+    ril::Response csq = co_await ril::send("AT+CSQ");
+    int rssi = -1;
+    if (csq.ok() && csq.line(0).substr(0, 6) == "+CSQ: "sv){
+        rssi = 0;
+        for (char c : csq.line(0).substr(6)){
+            if (c < '0' || c > '9'){
+                break;
+            }
+            rssi = rssi * 10 + (c - '0');
+        }
+    }
+    co_return rssi;
+}
+
+static ril::Task<> _nested(int* rssi){
+    *rssi = co_await _signal();
+}
+
+static ril::Task<> _sleep(uint64_t* slept, RIL_ATSndError* result){
+    uint64_t start = sim_micros();
+    *result = co_await ril::sleep(100);
+    *slept = sim_micros() - start;
+}
+
+/**
+ * With every timer taken the coroutine does not sleep, and says so
+ */
+static ril::Task<> _noTimer(uint64_t* slept, RIL_ATSndError* result){
+    for (uint32_t i = 0; i < RIL_CORO_FRAMES; i++){
+        TEST_CHECK(ril::Executor::sleep(std::noop_coroutine(), HAL_GetTick() + 1));
+    }
+    TEST_CHECK(!ril::Executor::sleep(std::noop_coroutine(), HAL_GetTick() + 1));
+    uint64_t start = sim_micros();
+    *result = co_await ril::sleep(100);
+    *slept = sim_micros() - start;
+}
+
+static ril::Task<Result> _leafResult(){
+    co_return RIL_AT_SUCCESS;
+}
+
+static ril::Task<int> _leafInt(){
+    co_return 7;
+}
+
+/**
+ * The root and this task take every frame, the leaves can not start
+ */
+static ril::Task<int> _middle(Result* result, bool* valid){
+    static_assert(RIL_CORO_FRAMES == 2, "the nesting below is one task deeper than the pool");
+    *result = co_await _leafResult();
+    ril::Task<int> leaf = _leafInt();
+    *valid = leaf.valid();
+    co_return co_await leaf;
+}
+
+static ril::Task<> _tooDeep(Result* result, bool* valid, int* value){
+    *value = co_await _middle(result, valid);
+}
+
+int main(){
+    bool done = false;
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+
+    _run(_send(&done));
+    TEST_CHECK(done);
+
+    done = false;
+    _run(_copy(&done));
+    TEST_CHECK(done);
+
+    int rssi = -1;
+    _run(_nested(&rssi));
+    TEST_EQ(rssi, 20);
+
+    uint64_t slept = 0;
+    RIL_ATSndError result = RIL_AT_FAILED;
+    _run(_sleep(&slept, &result));
+    TEST_EQ(result, RIL_AT_SUCCESS);
+    TEST_CHECK(slept >= 100000);
+
+    result = RIL_AT_SUCCESS;
+    _run(_noTimer(&slept, &result));
+    TEST_EQ(result, RIL_AT_BUSY);
+    TEST_CHECK(slept < 100000);
+
+    TEST_EQ(ril::frameStats().Failures, 0);
+    TEST_CHECK(ril::frameLargest() <= RIL_CORO_FRAME_SIZE);
+
+    // RIL_CORO_FRAMES + 1 nested tasks, the innermost ones fail and say so
+    Result leafResult = RIL_AT_SUCCESS;
+    bool leafValid = true;
+    int value = -1;
+    _run(_tooDeep(&leafResult, &leafValid, &value));
+    TEST_EQ(leafResult, RIL_AT_BUSY);
+    TEST_CHECK(!leafValid);
+    TEST_EQ(value, 0);
+    TEST_EQ(ril::frameStats().Failures, 2);
+
+    // The frames are back for the next task
+    rssi = -1;
+    _run(_nested(&rssi));
+    TEST_EQ(rssi, 20);
+    return TEST_RESULT("test_coro");
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_decode.cpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief ril::ResponseOf of ril_decode.hpp, C++20
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril.hpp"
+#include "ril_decode.hpp"
+#include <string_view>
+
+extern "C" {
+#include "sim_modem.h"
+#include "test.h"
+}
+
+using namespace std::string_view_literals;
+using ril::DecodeError;
+
+using Csq = ril::ResponseOf<"+CSQ:", int, int>;
+using Cops = ril::ResponseOf<"+COPS:", int, ril::opt<int>, ril::str, ril::opt<int>>;
+using Small = ril::ResponseOf<"+X:", uint8_t, int8_t>;
+using Named = ril::ResponseOf<"+Y:", ril::text<6>, ril::str>;
+
+static void _testFields(){
+    auto csq = Csq::parse("+CSQ: 20,99");
+    TEST_CHECK(csq);
+    TEST_EQ(std::get<0>(csq.value), 20);
+    TEST_EQ(std::get<1>(csq.value), 99);
+
+    // Other prefix
+    TEST_EQ((int) Csq::parse("+CREG: 0,1").error, (int) DecodeError::Prefix);
+    TEST_EQ((int) Csq::parse("+CSQ").error, (int) DecodeError::Prefix);
+}
+
+/**
+ * The field that failed is reported by its index
+ */
+static void _testMissing(){
+    auto rsp = Csq::parse("+CSQ: 20");
+    TEST_EQ((int) rsp.error, (int) DecodeError::Missing);
+    TEST_EQ(rsp.field, 1);
+    rsp = Csq::parse("+CSQ: ,99");
+    TEST_EQ((int) rsp.error, (int) DecodeError::Missing);
+    TEST_EQ(rsp.field, 0);
+    rsp = Csq::parse("+CSQ: 20,");
+    TEST_EQ((int) rsp.error, (int) DecodeError::Missing);
+    TEST_EQ(rsp.field, 1);
+    // A default Decoded has not seen a line
+    Csq::Decoded none;
+    TEST_CHECK(!none);
+}
+
+static void _testNumbers(){
+    auto small = Small::parse("+X: 255,-128");
+    TEST_CHECK(small);
+    TEST_EQ(std::get<0>(small.value), 255);
+    TEST_EQ(std::get<1>(small.value), -128);
+
+    small = Small::parse("+X: 256,0");
+    TEST_EQ((int) small.error, (int) DecodeError::Number);
+    TEST_EQ(small.field, 0);
+    small = Small::parse("+X: 1,-129");
+    TEST_EQ((int) small.error, (int) DecodeError::Number);
+    TEST_EQ(small.field, 1);
+    small = Small::parse("+X: 1,128");
+    TEST_EQ((int) small.error, (int) DecodeError::Number);
+    // No sign on unsigned fields, no trailing text
+    TEST_EQ((int) Small::parse("+X: -1,0").error, (int) DecodeError::Number);
+    TEST_EQ((int) Small::parse("+X: 1a,0").error, (int) DecodeError::Number);
+    TEST_EQ((int) Small::parse("+X: 99999999999999999999999,0").error, (int) DecodeError::Number);
+}
+
+static void _testStrings(){
+    auto cops = Cops::parse("+COPS: 0,0,\"Operator, Inc\",7");
+    TEST_CHECK(cops);
+    TEST_CHECK(std::get<2>(cops.value) == "Operator, Inc"sv);
+    TEST_EQ(*std::get<3>(cops.value), 7);
+
+    // Bare and empty strings are values
+    auto named = Named::parse("+Y: \"abcdefgh\",bare");
+    TEST_CHECK(named);
+    TEST_CHECK(std::get<0>(named.value).view() == "abcde"sv);
+    TEST_CHECK(std::get<1>(named.value) == "bare"sv);
+    named = Named::parse("+Y: \"\",");
+    TEST_CHECK(named);
+    TEST_EQ(std::get<0>(named.value).Len, 0);
+    TEST_CHECK(std::get<1>(named.value).empty());
+
+    named = Named::parse("+Y: \"open,x");
+    TEST_EQ((int) named.error, (int) DecodeError::Quote);
+    TEST_EQ(named.field, 0);
+    named = Named::parse("+Y: \"a\"b,x");
+    TEST_EQ((int) named.error, (int) DecodeError::Quote);
+}
+
+static void _testOptional(){
+    // Empty in the middle, absent at the end
+    auto cops = Cops::parse("+COPS: 0,,\"Op\"");
+    TEST_CHECK(cops);
+    TEST_CHECK(!std::get<1>(cops.value).has_value());
+    TEST_CHECK(!std::get<3>(cops.value).has_value());
+
+    cops = Cops::parse("+COPS: 1,2,\"Op\",");
+    TEST_CHECK(cops);
+    TEST_EQ(*std::get<1>(cops.value), 2);
+    TEST_CHECK(!std::get<3>(cops.value).has_value());
+
+    // Present but not a number
+    cops = Cops::parse("+COPS: 1,x,\"Op\"");
+    TEST_EQ((int) cops.error, (int) DecodeError::Number);
+    TEST_EQ(cops.field, 1);
+    // Required fields after an optional one are still required
+    cops = Cops::parse("+COPS: 1");
+    TEST_EQ((int) cops.error, (int) DecodeError::Missing);
+    TEST_EQ(cops.field, 2);
+}
+
+/**
+ * into() as the line callback of a command on the simulated modem
+ */
+static void _testInto(){
+    sim_reset(nullptr);
+    TEST_EQ(ril::Ril::init(&sim_uart), RIL_AT_SUCCESS);
+    Csq::Decoded csq;
+    TEST_EQ(ril::Ril::send("AT+CSQ", Csq::into(csq), 1000), RIL_AT_SUCCESS);
+    TEST_CHECK(csq);
+    TEST_EQ(std::get<0>(csq.value), 20);
+
+    // +CSQ: 20,99 has no third field, the command fails on that line
+    using Wrong = ril::ResponseOf<"+CSQ:", int, int, int>;
+    Wrong::Decoded wrong;
+    TEST_EQ(ril::Ril::send("AT+CSQ", Wrong::into(wrong), 1000), RIL_AT_FAILED);
+    TEST_EQ((int) wrong.error, (int) DecodeError::Missing);
+    TEST_EQ(wrong.field, 2);
+}
+
+int main(){
+    _testFields();
+    _testMissing();
+    _testNumbers();
+    _testStrings();
+    _testOptional();
+    _testInto();
+    return TEST_RESULT("test_decode");
+}
@@ -0,0 +1,167 @@
+/**
+ * @file test_engine.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Command engine of ril.c against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+typedef struct {
+    char                Line[64];
+    uint32_t            Lines;
+    RIL_ATSndError      Result;
+    bool                Done;
+} Reply;
+
+static uint32_t _onLine(char* line, uint32_t len, void* userData){
+    Reply* reply = (Reply*) userData;
+    snprintf(reply->Line, sizeof(reply->Line), "%.*s", (int) len, line);
+    reply->Lines++;
+    return RIL_AT_RSP_SUCCESS;
+}
+
+static void _onDone(RIL_ATSndError result, void* userData){
+    Reply* reply = (Reply*) userData;
+    reply->Result = result;
+    reply->Done = true;
+}
+
+static void _start(void){
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+}
+
+static void _testBlocking(void){
+    Reply reply = { 0 };
+    _start();
+    TEST_EQ(RIL_SendATCmd("AT+CSQ", 6, _onLine, &reply, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(reply.Lines, 1);
+    TEST_CHECK(strcmp(reply.Line, "+CSQ: 20,99") == 0);
+    TEST_EQ(RIL_SendATCmd("AT+NOPE", 7, NULL, NULL, 1000), RIL_AT_FAILED);
+
+    // No answer at all ends with the timeout, and the engine takes the next command
+    sim_mute("AT+CGMR");
+    uint64_t start = sim_micros();
+    TEST_EQ(RIL_SendATCmd("AT+CGMR", 7, NULL, NULL, 300), RIL_AT_TIMEOUT);
+    TEST_CHECK(sim_micros() - start >= 299000 && sim_micros() - start < 320000);
+    TEST_EQ(RIL_SendATCmd("AT", 2, NULL, NULL, 1000), RIL_AT_SUCCESS);
+}
+
+/**
+ * A payload keeps the TX ring full after its command completed, the next
+ * command has to wait for room instead of failing
+ */
+static void _testHeldForSpace(void){
+    static uint8_t filler[1000];
+    Reply first = { 0 };
+    Reply second = { 0 };
+    RIL_Payload payload = { .Data = filler, .Len = sizeof(filler) };
+    _start();
+    // Empty lines to the modem, about 87 ms on the wire
+    memset(filler, '\r', sizeof(filler));
+    uint32_t nearOverrun = RIL_getBufferStats(RIL_BUFFER_TX)->NearOverrun;
+
+    TEST_EQ(RIL_SendATCmdPayload("AT", 2, &payload, NULL, _onDone, &first, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_SendATCmdAsync("AT+CSQ", 6, _onLine, _onDone, &second, 1000), RIL_AT_SUCCESS);
+    while (!second.Done){
+        RIL_process();
+    }
+    TEST_CHECK(first.Done);
+    TEST_EQ(first.Result, RIL_AT_SUCCESS);
+    TEST_EQ(second.Result, RIL_AT_SUCCESS);
+    TEST_CHECK(strcmp(second.Line, "+CSQ: 20,99") == 0);
+    TEST_EQ(sim_count("AT+CSQ"), 1);
+    // The wait shows up as a TX ring that was too small
+    TEST_CHECK(RIL_getBufferStats(RIL_BUFFER_TX)->NearOverrun > nearOverrun);
+    TEST_EQ(sim_stats()->Overrun, 0);
+}
+
+/**
+ * ATV0: single digit final results, +CME ERROR stays text
+ */
+static void _testNumeric(void){
+    Reply reply = { 0 };
+    RIL_setResultFormat(RIL_RESULT_NUMERIC);
+    _start();
+    TEST_EQ(sim_count("ATV0"), 1);
+
+    TEST_EQ(RIL_SendATCmd("AT", 2, NULL, NULL, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_SendATCmd("AT+CSQ", 6, _onLine, &reply, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(reply.Lines, 1);
+    TEST_CHECK(strcmp(reply.Line, "+CSQ: 20,99") == 0);
+
+    // "4\r"
+    TEST_EQ(RIL_SendATCmd("AT+NOPE", 7, NULL, NULL, 1000), RIL_AT_FAILED);
+    TEST_EQ(Ql_RIL_AT_GetErrCode().atError, (uint32_t) RIL_AT_FAILED);
+    TEST_EQ(RIL_SendATCmd("AT+CPIN?", 8, NULL, NULL, 1000), RIL_AT_FAILED);
+    TEST_EQ(Ql_RIL_AT_GetErrCode().type, RIL_ERROR_AT);
+    TEST_EQ(Ql_RIL_AT_GetErrCode().atError, 10);
+
+    // Nothing waited for a verbose result
+    uint64_t start = sim_micros();
+    TEST_EQ(RIL_SendATCmd("AT", 2, NULL, NULL, 1000), RIL_AT_SUCCESS);
+    TEST_CHECK(sim_micros() - start < 100000);
+    RIL_setResultFormat(RIL_RESULT_VERBOSE);
+}
+
+/**
+ * The echo is dropped, a line that only starts like the command is not
+ */
+static void _testEcho(void){
+    Reply reply = { 0 };
+    _start();
+    TEST_EQ(RIL_SendATCmd("AT+CSQ", 6, _onLine, &reply, 1000), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_echoEnabled());
+    TEST_EQ(reply.Lines, 1);
+    TEST_CHECK(strcmp(reply.Line, "+CSQ: 20,99") == 0);
+
+    // Without echo the first line is the response itself, even when it looks like the command
+    TEST_EQ(RIL_SendATCmd("ATE0", 4, NULL, NULL, 1000), RIL_AT_SUCCESS);
+    memset(&reply, 0, sizeof(reply));
+    TEST_EQ(RIL_SendATCmdAsync("AT+CSQ", 6, _onLine, _onDone, &reply, 1000), RIL_AT_SUCCESS);
+    uint64_t end = sim_micros() + 1000000;
+    while (sim_count("AT+CSQ") < 2 && sim_micros() < end){
+        RIL_process();
+    }
+    sim_urc("AT+CSQ=1");
+    while (!reply.Done && sim_micros() < end){
+        RIL_process();
+    }
+    TEST_EQ(reply.Result, RIL_AT_SUCCESS);
+    TEST_CHECK(!RIL_echoEnabled());
+    TEST_EQ(reply.Lines, 2);
+}
+
+/**
+ * RIL_ECHO_OFF checks that the modem took ATE0
+ */
+static void _testEchoOff(void){
+    RIL_setEchoMode(RIL_ECHO_OFF);
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_CHECK(!RIL_echoEnabled());
+
+    // A modem that ignores ATE0 still echoes AT+CMEE=1
+    sim_reset(NULL);
+    sim_mute("ATE0");
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_FAILED);
+    TEST_CHECK(RIL_echoEnabled());
+    RIL_setEchoMode(RIL_ECHO_KEEP);
+}
+
+int main(void){
+    _testBlocking();
+    _testHeldForSpace();
+    _testNumeric();
+    _testEcho();
+    _testEchoOff();
+    return TEST_RESULT("test_engine");
+}
@@ -0,0 +1,47 @@
+/**
+ * @file test_format.cpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief ril::format of ril_format.hpp, C++20
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_format.hpp"
+#include <string_view>
+
+extern "C" {
+#include "test.h"
+}
+
+using namespace std::string_view_literals;
+
+static void _testFits(){
+    auto cmd = ril::format<"AT+QIOPEN=1,%u,\"TCP\",\"%s\",%u,0,1">(2u, "example.com", 8080u);
+    TEST_CHECK(cmd.view() == "AT+QIOPEN=1,2,\"TCP\",\"example.com\",8080,0,1"sv);
+    TEST_CHECK(ril::format<"AT+X=%d,%d">(-42, INT32_MIN).view() == "AT+X=-42,-2147483648"sv);
+    TEST_CHECK(ril::format<"AT+X=%x,%c,100%%">(0xBEEFu, 'q').view() == "AT+X=BEEF,q,100%"sv);
+    TEST_CHECK(ril::format<"AT+X=%u">(UINT64_MAX).view() == "AT+X=18446744073709551615"sv);
+}
+
+/**
+ * A value that fits is written even when the widest value of its type would not
+ */
+static void _testCapacity(){
+    auto small = ril::format<"AT+CSQ=%u", 12>(5u);
+    TEST_CHECK(small.view() == "AT+CSQ=5"sv);
+    // Exactly full
+    TEST_CHECK((ril::format<"AT+CSQ=%u", 12>(12345u).view() == "AT+CSQ=12345"sv));
+    TEST_CHECK(!(ril::format<"AT+CSQ=%u", 12>(123456u)));
+    TEST_CHECK(!(ril::format<"AT+X=%d", 7>(-12)));
+    TEST_CHECK((ril::format<"AT+X=%d", 8>(-12).view() == "AT+X=-12"sv));
+    TEST_CHECK(!(ril::format<"AT+X=%s", 8>("abcd")));
+}
+
+int main(){
+    _testFits();
+    _testCapacity();
+    return TEST_RESULT("test_format");
+}
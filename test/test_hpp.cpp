@@ -0,0 +1,104 @@
+/**
+ * @file test_hpp.cpp
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief ril.hpp against the simulated modem, built as C++17 and as C++20
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+extern "C" {
+#include "sim_modem.h"
+#include "test.h"
+}
+
+#ifndef TEST_NAME
+    #define TEST_NAME       "test_hpp"
+#endif
+
+using ril::Ril;
+
+// An integer timeout must not be taken for a line callback
+static_assert(!std::is_invocable_v<int&, std::string_view>);
+
+static bool _run(const bool& done, uint32_t ms){
+    uint64_t end = sim_micros() + ms * 1000ULL;
+    while (!done && sim_micros() < end) {
+        Ril::process();
+    }
+    return done;
+}
+
+static void _testSend(){
+    sim_reset(nullptr);
+    TEST_EQ(Ril::init(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(Ril::send("AT", 500), RIL_AT_SUCCESS);
+
+    char csq[32] = "";
+    auto onLine = [&csq](std::string_view line) {
+        std::snprintf(csq, sizeof(csq), "%.*s", static_cast<int>(line.size()), line.data());
+        return RIL_AT_RSP_SUCCESS;
+    };
+    TEST_EQ(Ril::send("AT+CSQ", onLine, 500), RIL_AT_SUCCESS);
+    TEST_CHECK(std::strcmp(csq, "+CSQ: 20,99") == 0);
+    TEST_EQ(Ril::send("AT+CSQ", [](std::string_view) { return RIL_AT_RSP_FAILED; }), RIL_AT_FAILED);
+}
+
+/**
+ * Raw data both ways through the spans: AT+QISEND to an echo peer and AT+QIRD of what came back
+ */
+static void _testPayload(){
+    static const std::byte HELLO[] = { std::byte{'h'}, std::byte{'e'}, std::byte{'l'}, std::byte{'l'}, std::byte{'o'} };
+    sim_reset(nullptr);
+    sim_addPeer("echo.test", 7, SIM_PEER_ECHO, 0);
+    TEST_EQ(Ril::init(&sim_uart), RIL_AT_SUCCESS);
+
+    bool opened = false;
+    int handle = Ril::addUrcHandler([&opened](std::string_view line, RIL_PrefixId) {
+        opened |= line == "+QIOPEN: 0,0";
+    });
+    TEST_CHECK(handle >= 0);
+    TEST_EQ(Ril::send("AT+QIOPEN=1,0,\"TCP\",\"echo.test\",7,0,0", 1000), RIL_AT_SUCCESS);
+    TEST_CHECK(_run(opened, 1000));
+
+    bool sent = false;
+    ril::Result result = RIL_AT_BUSY;
+    TEST_EQ(Ril::sendPayload("AT+QISEND=0,5", ril::ByteSpan(HELLO), '>', nullptr,
+                             [&](ril::Result r) { result = r; sent = true; }, 1000), RIL_AT_SUCCESS);
+    TEST_CHECK(_run(sent, 1000));
+    TEST_EQ(result, RIL_AT_SUCCESS);
+    // Back from the peer after the round trip
+    sim_advance(100000);
+    TEST_EQ(sim_socketHeld(0), 5);
+
+    char data[16] = "";
+    std::size_t got = 0;
+    auto onRead = [&](std::string_view line) {
+        unsigned len = 0;
+        if (std::sscanf(std::string(line).c_str(), "+QIRD: %u", &len) == 1 && len > 0) {
+            Ril::readPayload(len, [&](ril::ByteSpan span) {
+                for (std::byte b : span) {
+                    data[got++] = static_cast<char>(b);
+                }
+            });
+        }
+        return RIL_AT_RSP_SUCCESS;
+    };
+    TEST_EQ(Ril::send("AT+QIRD=0,100", onRead, 1000), RIL_AT_SUCCESS);
+    TEST_EQ(got, 5);
+    TEST_CHECK(std::memcmp(data, "hello", 5) == 0);
+    Ril::removeUrcHandler(handle);
+}
+
+int main(){
+    _testSend();
+    _testPayload();
+    return TEST_RESULT(TEST_NAME);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file test_power.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief DTR sleep and RI wakeup of ril_power.c on RIL_power_simulated, against
+ *   the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_power.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <stdbool.h>
+
+#define WAKE_MS         50
+#define IDLE_MS         200
+
+static RIL_PowerSim dtr;
+
+static void _onDone(RIL_ATSndError result, void* userData){
+    *(RIL_ATSndError*) userData = result;
+}
+
+/**
+ * @brief runs the engine until the modem sleeps
+ * @return milliseconds it took
+ */
+static uint32_t _untilAsleep(void){
+    uint64_t start = sim_micros();
+    while (RIL_power_state() != RIL_POWER_ASLEEP && sim_micros() - start < 10 * IDLE_MS * 1000ULL){
+        RIL_process();
+    }
+    return (uint32_t) ((sim_micros() - start) / 1000);
+}
+
+static void _testIdle(void){
+    TEST_EQ(RIL_power_state(), RIL_POWER_AWAKE);
+    TEST_CHECK(dtr.Dtr);
+
+    uint32_t idle = _untilAsleep();
+    TEST_EQ(RIL_power_state(), RIL_POWER_ASLEEP);
+    TEST_CHECK(!dtr.Dtr);
+    TEST_CHECK(idle >= IDLE_MS - 1 && idle <= IDLE_MS + 1);
+    TEST_EQ(RIL_power_stats()->Sleeps, 1);
+    TEST_CHECK(RIL_power_stats()->AwakeMs >= IDLE_MS - 1 && RIL_power_stats()->AwakeMs <= IDLE_MS + 1);
+}
+
+/**
+ * DTR goes up when the queued command is due, the command follows WAKE_MS later
+ */
+static void _testWake(void){
+    RIL_ATSndError done = RIL_AT_TIMEOUT + 1;
+    uint32_t commands = sim_stats()->Commands;
+    uint32_t edges = dtr.Edges;
+    uint64_t start = sim_micros();
+
+    TEST_EQ(RIL_SendATCmdAsync("AT+CGMR", 7, NULL, _onDone, &done, 1000), RIL_AT_SUCCESS);
+    TEST_CHECK(!dtr.Dtr);
+    RIL_process();
+    TEST_CHECK(dtr.Dtr);
+    TEST_EQ(dtr.Edges, edges + 1);
+    TEST_EQ(RIL_power_state(), RIL_POWER_WAKING);
+    TEST_EQ(RIL_power_stats()->Wakes, 1);
+
+    // Held until the modem is ready
+    while (sim_micros() - start < (WAKE_MS - 1) * 1000ULL){
+        RIL_process();
+    }
+    TEST_EQ(sim_stats()->Commands, commands);
+    TEST_EQ(RIL_power_state(), RIL_POWER_WAKING);
+
+    while (done == RIL_AT_TIMEOUT + 1 && sim_micros() - start < 1000000){
+        RIL_process();
+    }
+    TEST_EQ(done, RIL_AT_SUCCESS);
+    TEST_EQ(sim_stats()->Commands, commands + 1);
+    TEST_EQ(RIL_power_state(), RIL_POWER_AWAKE);
+
+    // Counted from the end of the command
+    uint32_t idle = _untilAsleep();
+    TEST_CHECK(idle >= IDLE_MS - 1 && idle <= IDLE_MS + 1);
+    TEST_CHECK(!dtr.Dtr);
+    TEST_EQ(RIL_power_stats()->Sleeps, 2);
+}
+
+/**
+ * RI means the modem is up already, no wake-to-ready delay
+ */
+static void _testRing(void){
+    RIL_power_ringIndicator();
+    sim_urc("RING");
+    RIL_process();
+    TEST_EQ(RIL_power_state(), RIL_POWER_AWAKE);
+    TEST_CHECK(dtr.Dtr);
+    TEST_EQ(RIL_power_stats()->RingWakes, 1);
+    TEST_EQ(RIL_power_stats()->Wakes, 1);
+
+    uint64_t start = sim_micros();
+    TEST_EQ(RIL_SendATCmd("AT+CGMR", 7, NULL, NULL, 1000), RIL_AT_SUCCESS);
+    TEST_CHECK(sim_micros() - start < WAKE_MS * 1000ULL);
+    _untilAsleep();
+    TEST_EQ(RIL_power_stats()->Sleeps, 3);
+}
+
+/**
+ * AwakeMs takes in the period that is still going on
+ */
+static void _testAwakeMs(void){
+    uint32_t asleep = RIL_power_stats()->AwakeMs;
+    sim_advance(100000);
+    RIL_process();
+    TEST_EQ(RIL_power_stats()->AwakeMs, asleep);
+
+    RIL_power_ringIndicator();
+    RIL_process();
+    sim_advance(100000);
+    uint32_t awake = RIL_power_stats()->AwakeMs - asleep;
+    TEST_CHECK(awake >= 100 && awake <= 101);
+    sim_advance(50000);
+    awake = RIL_power_stats()->AwakeMs - asleep;
+    TEST_CHECK(awake >= 150 && awake <= 151);
+}
+
+int main(void){
+    static RIL_PowerHooks hooks;
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    hooks = RIL_power_simulated(&dtr);
+    RIL_power_init(&hooks, WAKE_MS, IDLE_MS);
+
+    _testIdle();
+    _testWake();
+    _testRing();
+    _testAwakeMs();
+
+    // Off again, DTR stays asserted
+    RIL_power_init(NULL, 0, 0);
+    TEST_CHECK(dtr.Dtr);
+    TEST_EQ(RIL_power_state(), RIL_POWER_OFF);
+    return TEST_RESULT("test_power");
+}
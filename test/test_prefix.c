@@ -0,0 +1,100 @@
+/**
+ * @file test_prefix.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Line classification of ril_prefix.c and ril_line.c against the generated table
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_line.h"
+#include "ril_error.h"
+#include "test.h"
+#include <stdio.h>
+#include <string.h>
+
+static const RIL_Prefix* _classify(const char* line){
+    return RIL_classifyLine(line, (uint32_t) strlen(line));
+}
+
+static bool _isResponseOf(RIL_PrefixId id, const char* atCmd){
+    for (uint32_t i = 0; i < RIL_PREFIX_COUNT; i++){
+        if (RIL_PREFIX_TABLE[i].Id == id){
+            return RIL_lineIsResponseOf(&RIL_PREFIX_TABLE[i], atCmd, (uint32_t) strlen(atCmd));
+        }
+    }
+    return false;
+}
+
+/**
+ * Every entry finds itself, alone and with the text that follows it on a line
+ */
+static void _testTable(void){
+    char line[64];
+    for (uint32_t i = 0; i < RIL_PREFIX_COUNT; i++){
+        const RIL_Prefix* entry = &RIL_PREFIX_TABLE[i];
+        TEST_CHECK(RIL_classifyLine(entry->Str, entry->Len) == entry);
+
+        bool colon = entry->Str[entry->Len - 1] == ':';
+        snprintf(line, sizeof(line), "%s%s", entry->Str, colon ? " 1,\"a b\"" : " 115200");
+        TEST_CHECK(_classify(line) == entry);
+        // One byte short is another key
+        TEST_CHECK(RIL_classifyLine(entry->Str, entry->Len - 1u) != entry);
+    }
+}
+
+static void _testLines(void){
+    const RIL_Prefix* prefix = _classify("CONNECT 115200");
+    TEST_CHECK(prefix != NULL && prefix->Id == RIL_PREFIX_CONNECT && prefix->Kind == RIL_LINE_FINAL_OK);
+    prefix = _classify("SEND OK");
+    TEST_CHECK(prefix != NULL && prefix->Id == RIL_PREFIX_SEND_OK);
+    prefix = _classify("NO CARRIER");
+    TEST_CHECK(prefix != NULL && prefix->Id == RIL_PREFIX_NO_CARRIER && prefix->Kind == RIL_LINE_FINAL_ERROR);
+    prefix = _classify("+CME ERROR: 10");
+    TEST_CHECK(prefix != NULL && prefix->Id == RIL_PREFIX_CME_ERROR);
+    TEST_EQ(RIL_lineErrCode(prefix, "+CME ERROR: 10"), 10);
+    prefix = _classify("ERROR");
+    TEST_EQ(RIL_lineErrCode(prefix, "ERROR"), (uint32_t) RIL_AT_FAILED);
+
+    // Same start, other keys
+    prefix = _classify("+CMTI: \"SM\",3");
+    TEST_CHECK(prefix != NULL && prefix->Id == RIL_PREFIX_CMTI);
+    prefix = _classify("+CMT: \"+31\",,\"26/10/17\"");
+    TEST_CHECK(prefix != NULL && prefix->Id == RIL_PREFIX_CMT);
+
+    // Intermediate lines nobody listed
+    TEST_CHECK(_classify("Quectel") == NULL);
+    TEST_CHECK(_classify("BG96MAR02A07M1G") == NULL);
+    TEST_CHECK(_classify("+CSQ: 20,99") == NULL);
+    TEST_CHECK(_classify("OKAY") == NULL);
+    TEST_CHECK(_classify("Revision: BG96") == NULL);
+
+#if RIL_FEATURE_NUMERIC_RESULT
+    TEST_EQ(RIL_lineClassify("0", 1, true)->Id, RIL_PREFIX_OK);
+    TEST_EQ(RIL_lineClassify("4", 1, true)->Id, RIL_PREFIX_ERROR);
+    TEST_CHECK(RIL_lineClassify("0", 1, false) == NULL);
+    TEST_CHECK(RIL_lineClassify("5", 1, true) == NULL);
+#endif
+}
+
+static void _testResponseOf(void){
+    TEST_CHECK(_isResponseOf(RIL_PREFIX_CREG, "AT+CREG?"));
+    TEST_CHECK(_isResponseOf(RIL_PREFIX_CREG, "AT+CREG=2"));
+    TEST_CHECK(_isResponseOf(RIL_PREFIX_CREG, "AT+CREG"));
+    TEST_CHECK(_isResponseOf(RIL_PREFIX_CREG, "AT+CREG?;+CEREG?"));
+    TEST_CHECK(!_isResponseOf(RIL_PREFIX_CMT, "AT+CMTI"));
+    TEST_CHECK(!_isResponseOf(RIL_PREFIX_CMT, "AT+CMTI?"));
+    TEST_CHECK(_isResponseOf(RIL_PREFIX_CMTI, "AT+CMTI?"));
+    TEST_CHECK(!_isResponseOf(RIL_PREFIX_CREG, "AT+CGREG?"));
+    TEST_CHECK(!_isResponseOf(RIL_PREFIX_CREG, "AT+CRE"));
+    TEST_CHECK(!_isResponseOf(RIL_PREFIX_RING, "ATRING"));
+}
+
+int main(void){
+    _testTable();
+    _testLines();
+    _testResponseOf();
+    return TEST_RESULT("test_prefix");
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_scan.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Equivalence of RIL_scanBytes and RIL_scanBytesRef
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Built once per kernel (SWAR, DSP model, SSE2, AVX2), see the Makefile.
+ * Every start alignment, every length up to a few vector widths and every
+ * match position is compared with the byte-at-a-time reference, with
+ * delimiters planted right behind the end so an overread shows up.
+ */
+
+#include "ril_scan.h"
+#include "test.h"
+#include <string.h>
+
+#ifndef SCAN_KERNEL
+    #define SCAN_KERNEL     "scan"
+#endif
+
+#define ALIGN_MAX           32
+#define LEN_MAX             130
+#define GUARD               64
+
+typedef struct {
+    uint8_t     A;
+    uint8_t     B;
+} Delims;
+
+static const Delims DELIMS[] = {
+    { '\r', '\n' },
+    { '"', ',' },
+    { '>', '>' },       // single byte search
+    { 0x00, 0xFF },     // lane extremes of the SWAR carry
+    { 0x80, 0x7F },
+};
+
+static uint8_t buff[ALIGN_MAX + LEN_MAX + GUARD] __attribute__((aligned(64)));
+static uint32_t seed = 1;
+
+static uint8_t _random(void){
+    seed = seed * 1103515245u + 12345u;
+    return (uint8_t) (seed >> 16);
+}
+
+/**
+ * @brief filler that is neither delimiter, biased to the neighbours that
+ *  break a wrong borrow in the SWAR test
+ */
+static uint8_t _filler(const Delims* d){
+    uint8_t c;
+    do {
+        switch (_random() & 3){
+            case 0:  c = (uint8_t) (d->A + 1); break;
+            case 1:  c = (uint8_t) (d->B - 1); break;
+            case 2:  c = (uint8_t) (d->A ^ 0x80); break;
+            default: c = _random(); break;
+        }
+    } while (c == d->A || c == d->B);
+    return c;
+}
+
+static void _check(const uint8_t* data, uint32_t len, const Delims* d){
+    int32_t expect = RIL_scanBytesRef(data, len, d->A, d->B);
+    int32_t got = RIL_scanBytes(data, len, d->A, d->B);
+    if (got != expect){
+        printf("%s: len %u align %u delims %02x/%02x: got %d expected %d\n", SCAN_KERNEL, len,
+               (unsigned) ((uintptr_t) data & (ALIGN_MAX - 1)), d->A, d->B, got, expect);
+    }
+    TEST_EQ(got, expect);
+}
+
+#ifdef SCAN_NEEDS_AVX2
+    #define SCAN_SUPPORTED()    __builtin_cpu_supports("avx2")
+#else
+    #define SCAN_SUPPORTED()    1
+#endif
+
+int main(void){
+    if (!SCAN_SUPPORTED()){
+        printf("test_scan " SCAN_KERNEL ": skipped, the CPU lacks it\n");
+        return 0;
+    }
+    for (uint32_t k = 0; k < sizeof(DELIMS) / sizeof(DELIMS[0]); k++){
+        const Delims* d = &DELIMS[k];
+        for (uint32_t align = 0; align < ALIGN_MAX; align++){
+            uint8_t* data = &buff[align];
+            for (uint32_t len = 0; len <= LEN_MAX; len++){
+                for (uint32_t i = 0; i < len + GUARD; i++){
+                    data[i] = _filler(d);
+                }
+                // Delimiters right behind the end must not be found
+                data[len] = d->A;
+                data[len + 1] = d->B;
+                _check(data, len, d);
+
+                // Every position of a single match, with either delimiter
+                for (uint32_t pos = 0; pos < len; pos++){
+                    uint8_t keep = data[pos];
+                    data[pos] = (pos & 1) ? d->B : d->A;
+                    _check(data, len, d);
+                    // A second match further on must not win over the first
+                    if (pos + 5 < len){
+                        uint8_t keep2 = data[pos + 5];
+                        data[pos + 5] = (pos & 1) ? d->A : d->B;
+                        _check(data, len, d);
+                        data[pos + 5] = keep2;
+                    }
+                    data[pos] = keep;
+                }
+            }
+        }
+    }
+    return TEST_RESULT("test_scan " SCAN_KERNEL);
+}
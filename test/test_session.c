@@ -0,0 +1,164 @@
+/**
+ * @file test_session.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief RIL_suspend and RIL_resume against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril.h"
+#include "ril_cmd.h"
+#include "ril_socket.h"
+#include "ril_store.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+/* Header of the blob: check, version, total length */
+#define BLOB_VERSION        4
+#define BLOB_HEADER         8
+
+static uint8_t blob[RIL_SESSION_SIZE];
+
+/**
+ * @brief a session with a cached response and an open buffer mode socket to an echo peer
+ */
+static int32_t _session(void){
+    RIL_CGMR_Response rev;
+    sim_reset(NULL);
+    sim_addPeer("echo.test", 7, SIM_PEER_ECHO, 0);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_init(1), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_CGMR_send(&rev), RIL_AT_SUCCESS);
+
+    int32_t sock = RIL_socket_open(RIL_SOCKET_TCP, "echo.test", 7, NULL, NULL);
+    TEST_CHECK(sock >= 0);
+    uint64_t end = sim_micros() + 1000000;
+    while (RIL_socket_state((uint8_t) sock) == RIL_SOCKET_OPENING && sim_micros() < end){
+        RIL_process();
+    }
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+    return sock;
+}
+
+static void _testRoundTrip(void){
+    char buff[16] = "";
+    int32_t sock = _session();
+    uint32_t len = RIL_suspend(blob, sizeof(blob));
+    TEST_CHECK(len > BLOB_HEADER);
+
+    // Data for the socket comes while the MCU sleeps, its URC is lost with the RX stream
+    sim_peerSend((uint8_t) sock, "sleep", 5);
+    sim_advance(200000);
+    TEST_EQ(sim_socketHeld((uint8_t) sock), 5);
+
+    uint32_t commands = sim_stats()->Commands;
+    TEST_EQ(RIL_resume(&sim_uart, blob, len, 200), RIL_AT_SUCCESS);
+    TEST_EQ(sim_stats()->Commands, commands + 1);
+    TEST_EQ(RIL_socket_init(1), RIL_AT_SUCCESS);
+
+    // The socket is back with its peer, and reads what arrived during sleep
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+    const RIL_VendorSocket* peer = RIL_socket_peer((uint8_t) sock);
+    TEST_CHECK(peer != NULL && strcmp(peer->Host, "echo.test") == 0 && peer->Port == 7);
+    uint64_t end = sim_micros() + 1000000;
+    int32_t got = 0;
+    while (got == 0 && sim_micros() < end){
+        RIL_process();
+        got = RIL_socket_recv((uint8_t) sock, buff, sizeof(buff));
+    }
+    TEST_EQ(got, 5);
+    TEST_CHECK(memcmp(buff, "sleep", 5) == 0);
+
+    // The cached revision is answered without a command
+    RIL_CGMR_Response rev;
+    commands = sim_stats()->Commands;
+    TEST_EQ(RIL_CGMR_send(&rev), RIL_AT_SUCCESS);
+    TEST_CHECK(strcmp(rev.Revision, "BG96MAR02A07M1G") == 0);
+    TEST_EQ(sim_stats()->Commands, commands);
+
+    // A socket with data in its rings can not be suspended
+    TEST_EQ(RIL_socket_send((uint8_t) sock, "x", 1), 1);
+    TEST_EQ(RIL_suspend(blob, sizeof(blob)), 0);
+    RIL_socket_close((uint8_t) sock);
+    while (RIL_socket_state((uint8_t) sock) != RIL_SOCKET_FREE && sim_micros() < end){
+        RIL_process();
+    }
+}
+
+static void _testDamaged(void){
+    uint8_t copy[RIL_SESSION_SIZE];
+    int32_t sock = _session();
+    uint32_t len = RIL_suspend(blob, sizeof(blob));
+    TEST_CHECK(len > BLOB_HEADER);
+    if (len <= BLOB_HEADER){
+        return;
+    }
+
+    // Every flipped bit is caught by the check
+    for (uint32_t i = 0; i < len; i++){
+        memcpy(copy, blob, len);
+        copy[i] ^= 0x10;
+        TEST_EQ(RIL_resume(&sim_uart, copy, len, 0), RIL_AT_INVALID_PARAM);
+    }
+    // Cut short
+    TEST_EQ(RIL_resume(&sim_uart, blob, len - 1, 0), RIL_AT_INVALID_PARAM);
+    TEST_EQ(RIL_resume(&sim_uart, blob, BLOB_HEADER - 1, 0), RIL_AT_INVALID_PARAM);
+    TEST_EQ(RIL_resume(&sim_uart, NULL, len, 0), RIL_AT_INVALID_PARAM);
+
+    // Another version with a valid check, as a blob of another build would be
+    memcpy(copy, blob, len);
+    copy[BLOB_VERSION]++;
+    uint32_t check = RIL_hash(RIL_HASH_INIT, &copy[BLOB_VERSION], len - BLOB_VERSION);
+    memcpy(copy, &check, sizeof(check));
+    TEST_EQ(RIL_resume(&sim_uart, copy, len, 0), RIL_AT_INVALID_PARAM);
+
+    // The intact blob still works after all of that
+    TEST_EQ(RIL_resume(&sim_uart, blob, len, 0), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+    RIL_socket_close((uint8_t) sock);
+    uint64_t end = sim_micros() + 1000000;
+    while (RIL_socket_state((uint8_t) sock) != RIL_SOCKET_FREE && sim_micros() < end){
+        RIL_process();
+    }
+}
+
+static void _testTooSmall(void){
+    int32_t sock = _session();
+    uint32_t full = RIL_suspend(blob, sizeof(blob));
+    TEST_CHECK(full > BLOB_HEADER);
+
+    // The cache is optional and shrinks, the sockets are not
+    uint32_t noCache = 0;
+    for (uint32_t size = full; size > 0; size--){
+        uint32_t len = RIL_suspend(blob, size);
+        TEST_CHECK(len <= size);
+        if (len == 0){
+            noCache = size + 1;
+            break;
+        }
+    }
+    TEST_CHECK(noCache > BLOB_HEADER && noCache < full);
+    TEST_EQ(RIL_suspend(blob, BLOB_HEADER - 1), 0);
+
+    // The smallest blob still brings the socket back
+    uint32_t len = RIL_suspend(blob, noCache);
+    TEST_CHECK(len > BLOB_HEADER && len < full);
+    TEST_EQ(RIL_resume(&sim_uart, blob, len, 0), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+    RIL_socket_close((uint8_t) sock);
+    uint64_t end = sim_micros() + 1000000;
+    while (RIL_socket_state((uint8_t) sock) != RIL_SOCKET_FREE && sim_micros() < end){
+        RIL_process();
+    }
+}
+
+int main(void){
+    _testRoundTrip();
+    _testDamaged();
+    _testTooSmall();
+    return TEST_RESULT("test_session");
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_settings.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Settings table of ril_settings.c over boots kept by RIL_store_file,
+ *   against the settings of the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#define _DEFAULT_SOURCE
+#include "ril_settings.h"
+#include "ril_caps.h"
+#include "ril_store.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const RIL_Setting SETTINGS[] = {
+    { "AT+CMEE=2",          "AT+CMEE?",     "+CMEE: 2" },
+    { "AT+CSCS=\"GSM\"",    "AT+CSCS?",     "+CSCS: \"GSM\"" },
+    { "AT+QCFG=1",          NULL,           NULL },
+};
+
+/* The same table with the character set changed */
+static const RIL_Setting CHANGED[] = {
+    { "AT+CMEE=2",          "AT+CMEE?",     "+CMEE: 2" },
+    { "AT+CSCS=\"UCS2\"",   "AT+CSCS?",     "+CSCS: \"UCS2\"" },
+    { "AT+QCFG=1",          NULL,           NULL },
+};
+
+static char dir[] = "/tmp/ril_settings_XXXXXX";
+
+static void _testFirstBoot(void){
+    RIL_SettingsReport report;
+    TEST_EQ(RIL_settings_apply(SETTINGS, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Applied, 3);
+    TEST_EQ(report.Queries, 0);
+    TEST_EQ(report.Saved, 1);
+    TEST_EQ(sim_count("AT+CMEE=2"), 1);
+    TEST_EQ(sim_count("AT+CSCS=\"GSM\""), 1);
+    TEST_EQ(sim_count("AT+QCFG=1"), 1);
+    TEST_EQ(sim_count("AT&W"), 1);
+}
+
+/**
+ * The modem kept what AT&W saved, the queries are all that is sent
+ */
+static void _testSecondBoot(void){
+    RIL_SettingsReport report;
+    uint32_t commands = sim_stats()->Commands;
+    TEST_EQ(RIL_settings_apply(SETTINGS, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Applied, 0);
+    TEST_EQ(report.Verified, 2);
+    TEST_EQ(report.Queries, 2);
+    TEST_EQ(report.Saved, 0);
+    TEST_EQ(sim_stats()->Commands - commands, 2);
+    TEST_EQ(sim_count("AT+CMEE?"), 1);
+    TEST_EQ(sim_count("AT+CSCS?"), 1);
+    TEST_EQ(sim_count("AT&W"), 1);
+}
+
+static void _testChanged(void){
+    RIL_SettingsReport report;
+    TEST_EQ(RIL_settings_apply(CHANGED, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Applied, 1);
+    TEST_EQ(report.Queries, 1);
+    TEST_EQ(report.Saved, 1);
+    TEST_EQ(sim_count("AT+CSCS=\"UCS2\""), 1);
+    TEST_EQ(sim_count("AT+CMEE=2"), 1);
+    TEST_EQ(sim_count("AT+QCFG=1"), 1);
+
+    // Stored, the next boot only verifies
+    TEST_EQ(RIL_settings_apply(CHANGED, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Applied, 0);
+    TEST_EQ(report.Verified, 2);
+}
+
+/**
+ * A query that answers something else than Expect applies its entry again
+ */
+static void _testLost(void){
+    RIL_SettingsReport report;
+    TEST_EQ(RIL_SendATCmd("AT+CMEE=0", 9, NULL, NULL, 0), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_settings_apply(CHANGED, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Verified, 1);
+    TEST_EQ(report.Applied, 1);
+    TEST_EQ(report.Saved, 1);
+    TEST_EQ(sim_count("AT+CMEE=2"), 2);
+    TEST_EQ(sim_count("AT+CSCS=\"UCS2\""), 1);
+
+    TEST_EQ(RIL_settings_apply(CHANGED, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Applied, 0);
+    TEST_EQ(report.Verified, 2);
+}
+
+/**
+ * One compound query once RIL_caps_discover found RIL_CAP_COMPOUND
+ */
+static void _testCompound(void){
+    RIL_SettingsReport report;
+    TEST_EQ(sim_count("AT+CMEE?;+CSCS?"), 0);
+    TEST_EQ(RIL_caps_discover(false), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_caps_has(RIL_CAP_COMPOUND));
+    // The discovery probes with the same line
+    uint32_t compound = sim_count("AT+CMEE?;+CSCS?");
+    uint32_t commands = sim_stats()->Commands;
+    TEST_EQ(RIL_settings_apply(CHANGED, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Queries, 1);
+    TEST_EQ(report.Verified, 2);
+    TEST_EQ(report.Applied, 0);
+    TEST_EQ(sim_stats()->Commands - commands, 1);
+    TEST_EQ(sim_count("AT+CMEE?;+CSCS?"), compound + 1);
+
+    // Not on a modem that rejects compound lines
+    sim_reject("AT+CMEE?;");
+    TEST_EQ(RIL_caps_discover(true), RIL_AT_SUCCESS);
+    TEST_CHECK(!RIL_caps_has(RIL_CAP_COMPOUND));
+    compound = sim_count("AT+CMEE?;+CSCS?");
+    TEST_EQ(RIL_settings_apply(CHANGED, 3, &report), RIL_AT_SUCCESS);
+    TEST_EQ(report.Queries, 2);
+    TEST_EQ(report.Verified, 2);
+    TEST_EQ(report.Applied, 0);
+    TEST_EQ(sim_count("AT+CMEE?;+CSCS?"), compound);
+    sim_reject(NULL);
+}
+
+int main(void){
+    TEST_CHECK(mkdtemp(dir) != NULL);
+    RIL_Store store = RIL_store_file(dir);
+    RIL_store_set(&store);
+
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    _testFirstBoot();
+    _testSecondBoot();
+    _testChanged();
+    _testLost();
+    _testCompound();
+
+    char path[64];
+    snprintf(path, sizeof(path), "%s/ril_%u.bin", dir, (unsigned) RIL_STORE_CONFIG);
+    remove(path);
+    snprintf(path, sizeof(path), "%s/ril_%u.bin", dir, (unsigned) RIL_STORE_CAPS);
+    remove(path);
+    remove(dir);
+    return TEST_RESULT("test_settings");
+}
@@ -0,0 +1,98 @@
+/**
+ * @file test_socket.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Modem sockets of ril_socket.c against the simulated modem
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_socket.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+typedef struct {
+    RIL_ATSndError      Result;
+    bool                Done;
+} Reply;
+
+static void _onDone(RIL_ATSndError result, void* userData){
+    Reply* reply = (Reply*) userData;
+    reply->Result = result;
+    reply->Done = true;
+}
+
+static void _start(void){
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_EQ(RIL_socket_init(1), RIL_AT_SUCCESS);
+}
+
+/**
+ * @brief opens a socket to the peer and runs the engine until it is connected
+ */
+static int32_t _open(uint8_t type, const char* host, uint16_t port){
+    int32_t sock = RIL_socket_open(type, host, port, NULL, NULL);
+    TEST_CHECK(sock >= 0);
+    uint64_t end = sim_micros() + 1000000;
+    while (sock >= 0 && RIL_socket_state((uint8_t) sock) == RIL_SOCKET_OPENING && sim_micros() < end){
+        RIL_process();
+    }
+    TEST_EQ(RIL_socket_state((uint8_t) sock), RIL_SOCKET_OPEN);
+    return sock;
+}
+
+static void _close(uint8_t sock){
+    TEST_EQ(RIL_socket_close(sock), RIL_AT_SUCCESS);
+    uint64_t end = sim_micros() + 1000000;
+    while (RIL_socket_state(sock) != RIL_SOCKET_FREE && sim_micros() < end){
+        RIL_process();
+    }
+    TEST_EQ(RIL_socket_state(sock), RIL_SOCKET_FREE);
+}
+
+/**
+ * A command that times out while pushed data is on the wire must not take
+ * the rest of the data with it, the parser would see it as lines
+ */
+static void _testPushAcrossTimeout(void){
+    static uint8_t data[1460];
+    static uint8_t got[sizeof(data)];
+    uint32_t total = 0;
+    Reply reply = { 0 };
+    _start();
+    sim_addPeer("push.test", 7, SIM_PEER_SILENT, 0);
+    int32_t sock = _open(RIL_SOCKET_TCP | RIL_SOCKET_PUSH, "push.test", 7);
+
+    for (uint32_t i = 0; i < sizeof(data); i++){
+        data[i] = (uint8_t) (i * 7);
+    }
+    // The data starts after 30 ms and takes about 127 ms at 115200 baud, the command ends halfway
+    sim_mute("AT+CGMR");
+    sim_peerSend((uint8_t) sock, data, sizeof(data));
+    TEST_EQ(RIL_SendATCmdAsync("AT+CGMR", 7, NULL, _onDone, &reply, 80), RIL_AT_SUCCESS);
+    uint64_t end = sim_micros() + 1000000;
+    while (total < sizeof(data) && sim_micros() < end){
+        RIL_process();
+        int32_t len = RIL_socket_recv((uint8_t) sock, &got[total], sizeof(got) - total);
+        total += len > 0 ? (uint32_t) len : 0;
+    }
+    TEST_CHECK(reply.Done);
+    TEST_EQ(reply.Result, RIL_AT_TIMEOUT);
+    TEST_EQ(total, sizeof(data));
+    TEST_CHECK(memcmp(got, data, sizeof(data)) == 0);
+    TEST_EQ(RIL_socket_stats()->Dropped, 0);
+
+    // The engine still parses responses after the data
+    sim_mute(NULL);
+    TEST_EQ(RIL_SendATCmd("AT", 2, NULL, NULL, 1000), RIL_AT_SUCCESS);
+    _close((uint8_t) sock);
+}
+
+int main(void){
+    _testPushAcrossTimeout();
+    return TEST_RESULT("test_socket");
+}
@@ -0,0 +1,60 @@
+/**
+ * @file test_stats.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Buffer statistics between and at events
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_stats.h"
+#include "test.h"
+
+int main(void){
+    RIL_BufferStats stats;
+
+    // A ring that fills at one event and drains at the next is timed in between by the ticks
+    RIL_bufferStats_init(&stats, 256);
+    RIL_bufferStats_sample(&stats, 250, 1000);
+    for (uint32_t now = 1001; now <= 1500; now++){
+        RIL_bufferStats_tick(&stats, 250, now);
+    }
+    TEST_EQ(stats.TimeAbove75, 500);
+    TEST_EQ(stats.Samples, 1);
+    TEST_EQ(stats.NearOverrun, 1);
+    RIL_bufferStats_sample(&stats, 10, 1600);
+    TEST_EQ(stats.TimeAbove75, 600);
+    TEST_EQ(stats.Above75, 0);
+
+    // A tick sees a drain no event reported
+    RIL_bufferStats_sample(&stats, 200, 2000);
+    RIL_bufferStats_tick(&stats, 100, 2040);
+    RIL_bufferStats_tick(&stats, 100, 3000);
+    TEST_EQ(stats.TimeAbove75, 640);
+
+    // Ticks move the peak, clipped usage only comes from samples
+    RIL_bufferStats_tick(&stats, 255, 3001);
+    TEST_EQ(stats.HighWater, 255);
+    RIL_bufferStats_tick(&stats, 300, 3002);
+    TEST_EQ(stats.HighWater, 255);
+    TEST_EQ(stats.Samples, 3);
+
+    // Near overrun doubles the recommendation
+    TEST_EQ(RIL_bufferStats_recommend(&stats), 512);
+    RIL_bufferStats_init(&stats, 256);
+    RIL_bufferStats_sample(&stats, 100, 0);
+    TEST_EQ(RIL_bufferStats_recommend(&stats), 128);
+
+    // The overrun sentinel of ril.c is counted, the peak stays at the capacity
+    RIL_bufferStats_init(&stats, 256);
+    RIL_bufferStats_sample(&stats, 100, 0);
+    RIL_bufferStats_sample(&stats, 256 + 1, 10);
+    TEST_EQ(stats.HighWater, 256);
+    TEST_EQ(stats.NearOverrun, 1);
+    TEST_EQ(stats.Samples, 2);
+    TEST_EQ(RIL_bufferStats_recommend(&stats), 512);
+
+    return TEST_RESULT("test_stats");
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_vendor.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Profile probing of ril_vendor.c and the URC and read header decoders of
+ *   each profile, built with RIL_VENDOR_AUTO
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ */
+
+#include "ril_vendor.h"
+#include "sim_modem.h"
+#include "test.h"
+#include <string.h>
+
+typedef bool (*ParseUrc)(const char* line, uint32_t len, RIL_PrefixId id, RIL_VendorEvent* event);
+
+/**
+ * Decodes line as the engine does, classified by its prefix first
+ */
+static bool _urc(ParseUrc parse, const char* line, RIL_VendorEvent* event){
+    uint32_t len = (uint32_t) strlen(line);
+    const RIL_Prefix* prefix = RIL_classifyLine(line, len);
+    memset(event, 0, sizeof(*event));
+    return prefix != NULL && parse(line, len, prefix->Id, event);
+}
+
+static void _testProbe(void){
+    sim_reset(NULL);
+    TEST_EQ(RIL_initialize(&sim_uart), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_vendor() == NULL);
+
+    // AT+CGMI names the manufacturer
+    TEST_EQ(RIL_vendor_probe(), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_vendor() == &RIL_VENDOR_QUECTEL_PROFILE);
+    TEST_EQ(sim_count("AT+CGMI"), 1);
+    TEST_EQ(sim_count("ATI"), 0);
+
+    // A model code only, ATI has the manufacturer
+    sim_identity("SIM7600E-H", "SIMCOM INCORPORATED");
+    TEST_EQ(RIL_vendor_probe(), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_vendor() == &RIL_VENDOR_SIMCOM_PROFILE);
+    TEST_EQ(sim_count("AT+CGMI"), 2);
+    TEST_EQ(sim_count("ATI"), 1);
+
+    sim_identity("u-blox", NULL);
+    TEST_EQ(RIL_vendor_probe(), RIL_AT_SUCCESS);
+    TEST_CHECK(RIL_vendor() == &RIL_VENDOR_UBLOX_PROFILE);
+    TEST_EQ(sim_count("ATI"), 1);
+
+    // Nobody known, the last profile stays
+    sim_identity("Acme", "Acme Modems");
+    TEST_EQ(RIL_vendor_probe(), RIL_AT_FAILED);
+    TEST_CHECK(RIL_vendor() == &RIL_VENDOR_UBLOX_PROFILE);
+    TEST_EQ(sim_count("ATI"), 2);
+
+    // The modem does not answer
+    sim_identity(NULL, NULL);
+    sim_mute("AT+CGMI");
+    sim_mute("ATI");
+    RIL_vendor_set(NULL);
+    TEST_EQ(RIL_vendor_probe(), RIL_AT_TIMEOUT);
+    TEST_CHECK(RIL_vendor() == NULL);
+    sim_mute(NULL);
+
+    TEST_CHECK(RIL_vendor_match("quectel", 7) == &RIL_VENDOR_QUECTEL_PROFILE);
+    TEST_CHECK(RIL_vendor_match("Quecte", 6) == NULL);
+    TEST_CHECK(RIL_vendor_byId(RIL_VENDOR_SIMCOM) == &RIL_VENDOR_SIMCOM_PROFILE);
+    TEST_CHECK(RIL_vendor_byId(RIL_VENDOR_AUTO) == NULL);
+}
+
+static void _testQuectel(void){
+    RIL_VendorEvent event;
+    TEST_CHECK(_urc(RIL_quectel_parseUrc, "+QIURC: \"recv\",0,5", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_RECV);
+    TEST_EQ(event.Socket, 0);
+    TEST_EQ(event.Value, 5);
+    // Buffer access mode does not tell the length
+    TEST_CHECK(_urc(RIL_quectel_parseUrc, "+QIURC: \"recv\",3", &event));
+    TEST_EQ(event.Socket, 3);
+    TEST_EQ(event.Value, -1);
+    TEST_CHECK(_urc(RIL_quectel_parseUrc, "+QIURC: \"closed\",2", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_CLOSED);
+    TEST_EQ(event.Socket, 2);
+    TEST_CHECK(_urc(RIL_quectel_parseUrc, "+QIURC: \"pdpdeact\",1", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_DETACHED);
+    TEST_EQ(event.Socket, RIL_VENDOR_NO_SOCKET);
+    TEST_EQ(event.Value, 1);
+    TEST_CHECK(_urc(RIL_quectel_parseUrc, "+QIOPEN: 1,565", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_OPENED);
+    TEST_EQ(event.Socket, 1);
+    TEST_EQ(event.Value, 565);
+    TEST_CHECK(!_urc(RIL_quectel_parseUrc, "+QIURC: \"incoming full\",0", &event));
+    TEST_CHECK(!_urc(RIL_quectel_parseUrc, "+QIURC: \"recv\"", &event));
+    TEST_CHECK(!_urc(RIL_quectel_parseUrc, "+CREG: 0,1", &event));
+
+    TEST_EQ(RIL_quectel_parseRead("+QIRD: 5", 8), 5);
+    TEST_EQ(RIL_quectel_parseRead("+QIRD: 0", 8), 0);
+    TEST_EQ(RIL_quectel_parseRead("+QIRD: 5,x", 10), -1);
+    TEST_EQ(RIL_quectel_parseRead("+QIRD:", 6), -1);
+}
+
+static void _testSimcom(void){
+    RIL_VendorEvent event;
+    TEST_CHECK(_urc(RIL_simcom_parseUrc, "+CIPRXGET: 1,2", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_RECV);
+    TEST_EQ(event.Socket, 2);
+    TEST_EQ(event.Value, -1);
+    // A read response is not a URC
+    TEST_CHECK(!_urc(RIL_simcom_parseUrc, "+CIPRXGET: 2,2,5,0", &event));
+    TEST_CHECK(_urc(RIL_simcom_parseUrc, "+CIPOPEN: 0,4", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_OPENED);
+    TEST_EQ(event.Value, 4);
+    TEST_CHECK(_urc(RIL_simcom_parseUrc, "+IPCLOSE: 1,2", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_CLOSED);
+    TEST_EQ(event.Socket, 1);
+    TEST_EQ(event.Value, 2);
+    TEST_CHECK(_urc(RIL_simcom_parseUrc, "+CIPEVENT: NETWORK CLOSED UNEXPECTEDLY", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_DETACHED);
+    TEST_EQ(event.Socket, RIL_VENDOR_NO_SOCKET);
+
+    TEST_EQ(RIL_simcom_parseRead("+CIPRXGET: 2,0,5,12", 19), 5);
+    TEST_EQ(RIL_simcom_parseRead("+CIPRXGET: 1,0", 14), -1);
+}
+
+static void _testUblox(void){
+    RIL_VendorEvent event;
+    TEST_CHECK(_urc(RIL_ublox_parseUrc, "+UUSORD: 0,3", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_RECV);
+    TEST_EQ(event.Socket, 0);
+    TEST_EQ(event.Value, 3);
+    TEST_CHECK(_urc(RIL_ublox_parseUrc, "+UUSOCL: 4", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_CLOSED);
+    TEST_EQ(event.Socket, 4);
+    TEST_CHECK(_urc(RIL_ublox_parseUrc, "+UUPSDD: 0", &event));
+    TEST_EQ(event.Type, RIL_VENDOR_EVENT_DETACHED);
+    TEST_EQ(event.Socket, RIL_VENDOR_NO_SOCKET);
+    TEST_CHECK(!_urc(RIL_ublox_parseUrc, "+UUSORD: 0", &event));
+
+    // The data follows inside the quotes of the same line
+    TEST_EQ(RIL_ublox_parseRead("+USORD: 0,3,\"abc\"", 17), 3);
+    TEST_EQ(RIL_ublox_parseRead("+USORD: 0", 9), -1);
+    TEST_EQ(RIL_ublox_parseRead("+USORF: 0,3", 11), -1);
+}
+
+int main(void){
+    _testProbe();
+    _testQuectel();
+    _testSimcom();
+    _testUblox();
+    return TEST_RESULT("test_vendor");
+}
@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""
+Generates the AT command bindings used through inc/ril_cmd.h.
+
+Reads tools/ril_commands.json and writes:
+    inc/ril_cmd_gen.h   RIL_CmdId, response structs, builder/parser/send prototypes
+    src/ril_cmd_gen.c   builders, parsers, send bindings, caches and RIL_CMD_TABLE
+
+For every command NAME:
+    RIL_NAME_MAX_LEN        longest command text the builder can produce
+    RIL_NAME_build(...)     writes the command text, constant parts are copied
+                            with their length known at generation time
+    RIL_NAME_parse(...)     decodes a response line, one step per field
+    RIL_NAME_send(...)      builds, sends with the timeout/retry policy of the
+                            table and decodes the response, see RIL_cmd_exec
+"""
+
+import json
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SPEC = os.path.join(ROOT, "tools", "ril_commands.json")
+OUT_H = os.path.join(ROOT, "inc", "ril_cmd_gen.h")
+OUT_C = os.path.join(ROOT, "src", "ril_cmd_gen.c")
+
+NAME_RE = re.compile(r"^[A-Z][A-Z0-9_]*$")
+CONV_RE = re.compile(r"%(.)")
+TYPES = ("int", "uint", "str")
+C_ARG = {"int": "int32_t", "uint": "uint32_t", "str": "const char*"}
+C_FIELD = {"int": "int32_t", "uint": "uint32_t"}
+CONV_TYPE = {"d": "int", "u": "uint", "s": "str"}
+# Decimal digits of the widest value, with the sign
+WIDTH = {"int": 11, "uint": 10}
+
+
+def fail(cmd, msg):
+    sys.exit("%s: %s: %s" % (SPEC, cmd.get("name", "?"), msg))
+
+
+def member(name):
+    return name[0].upper() + name[1:]
+
+
+def c_string(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def split_syntax(cmd):
+    """Returns the syntax as a list of literal strings and argument indexes"""
+    pieces, literal, arg = [], "", 0
+    pos = 0
+    syntax = cmd["syntax"]
+    for m in CONV_RE.finditer(syntax):
+        literal += syntax[pos:m.start()]
+        pos = m.end()
+        conv = m.group(1)
+        if conv == "%":
+            literal += "%"
+            continue
+        if conv not in CONV_TYPE:
+            fail(cmd, "unknown conversion %%%s" % conv)
+        args = cmd.get("args", [])
+        if arg >= len(args) or args[arg]["type"] != CONV_TYPE[conv]:
+            fail(cmd, "argument %d does not match %%%s" % (arg, conv))
+        if literal:
+            pieces.append(literal)
+            literal = ""
+        pieces.append(arg)
+        arg += 1
+    literal += syntax[pos:]
+    if literal:
+        pieces.append(literal)
+    if arg != len(cmd.get("args", [])):
+        fail(cmd, "%d conversions for %d args" % (arg, len(cmd.get("args", []))))
+    return pieces
+
+
+def check(spec):
+    names = set()
+    for cmd in spec["commands"]:
+        if not NAME_RE.match(cmd.get("name", "")):
+            fail(cmd, "name must be upper case C identifier")
+        if cmd["name"] in names:
+            fail(cmd, "duplicate name")
+        names.add(cmd["name"])
+        if cmd.get("timeout") not in spec["timeouts"]:
+            fail(cmd, "unknown timeout class %r" % cmd.get("timeout"))
+        for item in cmd.get("args", []) + cmd.get("fields", []):
+            if item.get("type") not in TYPES:
+                fail(cmd, "bad type of %s" % item.get("name"))
+            if item["type"] == "str" and not item.get("max"):
+                fail(cmd, "%s needs max" % item["name"])
+        if ("prefix" in cmd) != bool(cmd.get("fields")):
+            fail(cmd, "prefix and fields go together")
+        if len(cmd.get("fields", [])) > 8:
+            fail(cmd, "at most 8 fields")
+        if cmd.get("cache") and (cmd.get("args") or not cmd.get("fields")):
+            fail(cmd, "only queries without args and with fields can be cached")
+        if not 0 <= cmd.get("retry", 0) <= 255:
+            fail(cmd, "retry is 0..255")
+        cmd["pieces"] = split_syntax(cmd)
+
+
+def max_len(cmd):
+    total = 0
+    for piece in cmd["pieces"]:
+        if isinstance(piece, str):
+            total += len(piece)
+        else:
+            arg = cmd["args"][piece]
+            total += arg["max"] if arg["type"] == "str" else WIDTH[arg["type"]]
+    return total
+
+
+def params(cmd):
+    return ", ".join("%s %s" % (C_ARG[a["type"]], a["name"]) for a in cmd.get("args", []))
+
+
+def build_signature(cmd):
+    extra = params(cmd)
+    return "uint32_t RIL_%s_build(char* buff, uint32_t size%s)" % (cmd["name"], ", " + extra if extra else "")
+
+
+def send_signature(cmd):
+    items = [params(cmd)] if cmd.get("args") else []
+    if cmd.get("fields"):
+        items.append("RIL_%s_Response* rsp" % cmd["name"])
+    return "RIL_ATSndError RIL_%s_send(%s)" % (cmd["name"], ", ".join(items) or "void")
+
+
+HEADER = """/**
+ * @file {name}
+ * @brief Generated by tools/ril_cmdgen.py from tools/ril_commands.json, do not edit.
+ */
+"""
+
+
+def emit_header(spec, f):
+    f.write(HEADER.format(name="ril_cmd_gen.h"))
+    f.write("\n#ifndef _RIL_CMD_GEN_H_\n#define _RIL_CMD_GEN_H_\n\n")
+    f.write('#include "ril.h"\n\n')
+    f.write("typedef enum {\n")
+    for cmd in spec["commands"]:
+        f.write("    RIL_CMD_%s,\n" % cmd["name"])
+    f.write("    RIL_CMD_COUNT,\n} RIL_CmdId;\n")
+
+    for cmd in spec["commands"]:
+        name = cmd["name"]
+        f.write("\n/* %s */\n" % cmd["syntax"])
+        f.write("#define RIL_%s_MAX_LEN%s%d\n" % (name, " " * max(1, 20 - len(name)), max_len(cmd)))
+        fields = cmd.get("fields", [])
+        if fields:
+            f.write("typedef struct {\n")
+            for field in fields:
+                if field["type"] == "str":
+                    f.write("    char        %s[%d];\n" % (member(field["name"]), field["max"] + 1))
+                else:
+                    f.write("    %-11s %s;\n" % (C_FIELD[field["type"]], member(field["name"])))
+            if any(field.get("optional") for field in fields):
+                f.write("    uint8_t     Present;    /**< Bit i set when optional field i was there */\n")
+            f.write("} RIL_%s_Response;\n" % name)
+        f.write("%s;\n" % build_signature(cmd))
+        if fields:
+            f.write("int32_t RIL_%s_parse(const char* line, uint32_t len, RIL_%s_Response* rsp);\n" % (name, name))
+        f.write("%s;\n" % send_signature(cmd))
+
+    # Counted by RIL_RAM_COMMANDS of ril_config.h, from sizeof so padding is as on the target
+    cached = ["sizeof(RIL_%s_Response)" % cmd["name"] for cmd in spec["commands"] if cmd.get("cache")]
+    f.write("\n/* Response caches in ril_cmd_gen.c */\n")
+    f.write("#define RIL_CMD_CACHE_SIZE              (%s)\n" % (" + \\\n                                         ".join(cached) or "0"))
+    f.write("\n#endif //_RIL_CMD_GEN_H_\n")
+
+
+def emit_build(cmd, f):
+    f.write("\n%s{\n" % build_signature(cmd))
+    f.write("    char* pos = buff;\n")
+    f.write("    if (size < RIL_%s_MAX_LEN){\n        return 0;\n    }\n" % cmd["name"])
+    for piece in cmd["pieces"]:
+        if isinstance(piece, str):
+            f.write("    memcpy(pos, %s, %d);\n    pos += %d;\n" % (c_string(piece), len(piece), len(piece)))
+            continue
+        arg = cmd["args"][piece]
+        if arg["type"] == "str":
+            f.write("    if ((pos = RIL_cmd_putStr(pos, %s, %d)) == NULL){\n        return 0;\n    }\n"
+                    % (arg["name"], arg["max"]))
+        else:
+            f.write("    pos = RIL_cmd_put%s(pos, %s);\n" % ("Int" if arg["type"] == "int" else "Uint", arg["name"]))
+    f.write("    return (uint32_t) (pos - buff);\n}\n")
+
+
+def parse_call(field):
+    target = "rsp->" + member(field["name"])
+    if field["type"] == "str":
+        return "RIL_cmd_parseStr(&pos, end, %s, sizeof(%s))" % (target, target)
+    return "RIL_cmd_parse%s(&pos, end, &%s)" % ("Int" if field["type"] == "int" else "Uint", target)
+
+
+def emit_parse(cmd, f):
+    name = cmd["name"]
+    fields = cmd["fields"]
+    f.write("\nstatic int32_t _%s_fields(const char* pos, const char* end, void* out){\n" % name)
+    f.write("    RIL_%s_Response* rsp = (RIL_%s_Response*) out;\n" % (name, name))
+    if any(field.get("optional") for field in fields):
+        f.write("    rsp->Present = 0;\n")
+    for i, field in enumerate(fields):
+        if field.get("optional"):
+            cond = "!RIL_cmd_fieldEmpty(pos, end)"
+            if i > 0:
+                cond = "RIL_cmd_nextField(&pos, end) && " + cond
+            f.write("    if (%s){\n" % cond)
+            f.write("        if (!%s){\n            return %d;\n        }\n" % (parse_call(field), i))
+            f.write("        rsp->Present |= 1U << %d;\n    }\n" % i)
+        else:
+            cond = "!" + parse_call(field)
+            if i > 0:
+                cond = "!RIL_cmd_nextField(&pos, end) || " + cond
+            f.write("    if (%s){\n        return %d;\n    }\n" % (cond, i))
+    f.write("    return RIL_CMD_PARSE_OK;\n}\n")
+
+    prefix = cmd["prefix"]
+    f.write("\nint32_t RIL_%s_parse(const char* line, uint32_t len, RIL_%s_Response* rsp){\n" % (name, name))
+    if prefix:
+        f.write("    if (len < %d || memcmp(line, %s, %d) != 0){\n        return RIL_CMD_PARSE_NO_LINE;\n    }\n"
+                % (len(prefix), c_string(prefix), len(prefix)))
+    f.write("    return _%s_fields(line + %d, line + len, rsp);\n}\n" % (name, len(prefix)))
+
+
+def emit_send(cmd, f):
+    name = cmd["name"]
+    f.write("\n%s{\n" % send_signature(cmd))
+    args = "".join(", " + a["name"] for a in cmd.get("args", []))
+    rsp = "rsp" if cmd.get("fields") else "NULL"
+    if cmd.get("args"):
+        f.write("    char cmd[RIL_%s_MAX_LEN];\n" % name)
+        f.write("    uint32_t len = RIL_%s_build(cmd, sizeof(cmd)%s);\n" % (name, args))
+        f.write("    if (len == 0){\n        return RIL_AT_INVALID_PARAM;\n    }\n")
+        f.write("    return RIL_cmd_exec(RIL_CMD_%s, cmd, len, %s);\n}\n" % (name, rsp))
+    else:
+        syntax = "".join(cmd["pieces"])
+        f.write("    return RIL_cmd_exec(RIL_CMD_%s, %s, %d, %s);\n}\n" % (name, c_string(syntax), len(syntax), rsp))
+
+
+def emit_source(spec, f):
+    f.write(HEADER.format(name="ril_cmd_gen.c"))
+    f.write('\n#include "ril_cmd.h"\n\n#if RIL_FEATURE_COMMANDS\n\n#include <string.h>\n')
+    for cmd in spec["commands"]:
+        if cmd.get("cache"):
+            f.write("\nstatic RIL_%s_Response %sCache;" % (cmd["name"], cmd["name"].lower()))
+    f.write("\n")
+    for cmd in spec["commands"]:
+        emit_build(cmd, f)
+        if cmd.get("fields"):
+            emit_parse(cmd, f)
+        emit_send(cmd, f)
+
+    f.write("\nconst RIL_CmdInfo RIL_CMD_TABLE[RIL_CMD_COUNT] = {\n")
+    for cmd in spec["commands"]:
+        name = cmd["name"]
+        fields = bool(cmd.get("fields"))
+        prefix = cmd.get("prefix")
+        flags = "RIL_CMD_RETRY_ON_ERROR" if cmd.get("retryOnError") else "0"
+        f.write("    [RIL_CMD_%s] = {\n" % name)
+        f.write("        .Prefix = %s,\n" % (c_string(prefix) if prefix is not None else "NULL"))
+        f.write("        .Parse = %s,\n" % ("_%s_fields" % name if fields else "NULL"))
+        f.write("        .Cache = %s,\n" % ("&%sCache" % name.lower() if cmd.get("cache") else "NULL"))
+        f.write("        .TimeOut = %d,\n" % spec["timeouts"][cmd["timeout"]])
+        f.write("        .CacheAge = %d,\n" % cmd.get("cache", 0))
+        f.write("        .RspSize = %s,\n" % ("sizeof(RIL_%s_Response)" % name if fields else "0"))
+        f.write("        .PrefixLen = %d,\n" % len(prefix or ""))
+        f.write("        .Retry = %d,\n" % cmd.get("retry", 0))
+        f.write("        .Flags = %s,\n    },\n" % flags)
+    f.write("};\n\n#endif\n")
+
+
+def main():
+    with open(SPEC) as f:
+        spec = json.load(f)
+    check(spec)
+    with open(OUT_H, "w", newline="\n") as f:
+        emit_header(spec, f)
+    with open(OUT_C, "w", newline="\n") as f:
+        emit_source(spec, f)
+    print("%d commands" % len(spec["commands"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+Prints the flash/RAM footprint of every RIL feature from the built objects.
+
+Each feature lives in its own translation unit, so the object sizes are the
+per-feature cost. Usage:
+
+    python3 tools/ril_footprint.py [--size arm-none-eabi-size] [--budget BYTES] build/*.o
+
+Objects that do not belong to RIL are ignored, features whose object is not
+in the list are reported as disabled. With --budget the exit status is 1 when
+the RAM total is above BYTES, so a build can stop on it.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+# Translation unit -> feature, in the order they are reported
+FEATURES = [
+    ("ril",              "core engine"),
+    ("ril_scan",         "line/delimiter scan kernel"),
+    ("ril_prefix",       "prefix classifier"),
+    ("ril_prefix_table", "prefix tables"),
+    ("ril_line",         "response line parser"),
+    ("ril_pool",         "object pools"),
+    ("ril_stats",        "buffer statistics"),
+    ("ril_capture",      "response capture"),
+    ("ril_cmd",          "command bindings runtime"),
+    ("ril_cmd_gen",      "generated command bindings"),
+    ("ril_vendor",       "vendor profile selection"),
+    ("ril_vendor_quectel", "Quectel profile"),
+    ("ril_vendor_simcom", "SIMCom profile"),
+    ("ril_vendor_ublox", "u-blox profile"),
+    ("ril_store",        "persistent storage hook"),
+    ("ril_caps",         "capability discovery"),
+    ("ril_settings",     "settings fingerprint"),
+    ("ril_batch",        "wake-window batching"),
+    ("ril_power",        "DTR sleep control"),
+    ("ril_socket",       "modem TCP/UDP sockets"),
+    ("ril_bsd",          "BSD socket calls"),
+    ("ril_conn",         "socket connection pool"),
+]
+
+
+def sizes(size_tool, objects):
+    out = subprocess.run([size_tool] + objects, check=True, capture_output=True, text=True).stdout
+    result = {}
+    for line in out.splitlines()[1:]:
+        cols = line.split()
+        if len(cols) < 6:
+            continue
+        text, data, bss = int(cols[0]), int(cols[1]), int(cols[2])
+        unit = os.path.splitext(os.path.basename(cols[5]))[0]
+        result[unit] = (text + data, data + bss)
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--size", default=os.environ.get("SIZE", "arm-none-eabi-size"))
+    parser.add_argument("--budget", type=int, help="RAM budget in bytes, RIL_RAM_BUDGET")
+    parser.add_argument("objects", nargs="+")
+    args = parser.parse_args()
+
+    found = sizes(args.size, args.objects)
+    flashTotal = ramTotal = 0
+    print("%-20s %-28s %8s %8s" % ("unit", "feature", "flash", "ram"))
+    for unit, feature in FEATURES:
+        if unit not in found:
+            print("%-20s %-28s %8s %8s" % (unit, feature, "-", "-"))
+            continue
+        flash, ram = found[unit]
+        flashTotal += flash
+        ramTotal += ram
+        print("%-20s %-28s %8d %8d" % (unit, feature, flash, ram))
+    print("%-20s %-28s %8d %8d" % ("total", "", flashTotal, ramTotal))
+    if args.budget is not None:
+        print("%-20s %-28s %8s %8d" % ("budget", "", "", args.budget))
+        if ramTotal > args.budget:
+            print("RAM total is %d bytes over the budget" % (ramTotal - args.budget), file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
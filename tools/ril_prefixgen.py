@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+Generates the minimal perfect hash tables used by RIL_classifyLine.
+
+Reads tools/ril_prefixes.txt and writes:
+    inc/ril_prefix_id.h     RIL_PrefixId enum and hash parameters
+    src/ril_prefix_table.c  const (flash resident) lookup tables
+
+Hash scheme (must match src/ril_prefix.c):
+    h      = FNV-1a 32 over the key, offset basis xor'ed with RIL_PREFIX_SEED
+    bucket = h % RIL_PREFIX_BUCKETS
+    slot   = ((h >> 16) + displacement[bucket]) % RIL_PREFIX_COUNT
+Every key lands in its own slot, so a lookup costs one hash and one memcmp.
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SPEC = os.path.join(ROOT, "tools", "ril_prefixes.txt")
+OUT_H = os.path.join(ROOT, "inc", "ril_prefix_id.h")
+OUT_C = os.path.join(ROOT, "src", "ril_prefix_table.c")
+
+KINDS = ("FINAL_OK", "FINAL_ERROR", "INFO", "URC")
+LINE_RE = re.compile(r'^(\w+)\s+(\w+)\s+"((?:[^"\\]|\\.)*)"\s*$')
+
+
+def fnv1a(data, seed):
+    h = (0x811C9DC5 ^ seed) & 0xFFFFFFFF
+    for c in data:
+        h ^= c
+        h = (h * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def parse(path):
+    entries = []
+    with open(path) as f:
+        for num, raw in enumerate(f, 1):
+            line = raw.strip()
+            if not line or line.startswith("#"):
+                continue
+            m = LINE_RE.match(line)
+            if not m or m.group(2) not in KINDS:
+                sys.exit("%s:%d: malformed entry" % (path, num))
+            key = m.group(3).encode()
+            if b":" in key[:-1]:
+                sys.exit("%s:%d: ':' is only allowed as the last character" % (path, num))
+            entries.append((m.group(1), m.group(2), key))
+    if len(set(e[2] for e in entries)) != len(entries):
+        sys.exit("%s: duplicate prefix" % path)
+    if not 0 < len(entries) < 255:
+        sys.exit("%s: 1..254 prefixes supported" % path)
+    return entries
+
+
+def place(keys, seed, buckets):
+    n = len(keys)
+    hashes = [fnv1a(k, seed) for k in keys]
+    groups = [[] for _ in range(buckets)]
+    for i, h in enumerate(hashes):
+        groups[h % buckets].append(i)
+    slots = [None] * n
+    disp = [0] * buckets
+    for b in sorted(range(buckets), key=lambda b: -len(groups[b])):
+        if not groups[b]:
+            continue
+        for d in range(256):
+            want = [((hashes[i] >> 16) + d) % n for i in groups[b]]
+            if len(set(want)) == len(want) and all(slots[s] is None for s in want):
+                for i, s in zip(groups[b], want):
+                    slots[s] = i
+                disp[b] = d
+                break
+        else:
+            return None
+    return slots, disp
+
+
+def build(keys):
+    buckets = max(1, (len(keys) + 1) // 2)
+    for seed in range(1 << 16):
+        res = place(keys, seed, buckets)
+        if res:
+            return (seed, buckets) + res
+    sys.exit("no perfect hash found")
+
+
+def c_string(key):
+    return '"' + key.decode().replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+HEADER = """/**
+ * @file {name}
+ * @brief Generated by tools/ril_prefixgen.py from tools/ril_prefixes.txt, do not edit.
+ */
+"""
+
+
+def emit(entries, seed, buckets, slots, disp):
+    with open(OUT_H, "w", newline="\n") as f:
+        f.write(HEADER.format(name="ril_prefix_id.h"))
+        f.write("\n#ifndef _RIL_PREFIX_ID_H_\n#define _RIL_PREFIX_ID_H_\n\n")
+        f.write("#define RIL_PREFIX_SEED     0x%04XUL\n" % seed)
+        f.write("#define RIL_PREFIX_BUCKETS  %d\n" % buckets)
+        # Words a key without ':' can have after its first, RIL_classifyLine tries that many spaces
+        spaces = max([k.count(b" ") for _, _, k in entries if not k.endswith(b":")] + [0])
+        f.write("#define RIL_PREFIX_SPACES   %d\n\n" % spaces)
+        f.write("typedef enum {\n")
+        for name, _, _ in entries:
+            f.write("    RIL_PREFIX_%s,\n" % name)
+        f.write("    RIL_PREFIX_COUNT,\n")
+        f.write("    RIL_PREFIX_NONE = RIL_PREFIX_COUNT,\n")
+        f.write("} RIL_PrefixId;\n\n#endif //_RIL_PREFIX_ID_H_\n")
+
+    with open(OUT_C, "w", newline="\n") as f:
+        f.write(HEADER.format(name="ril_prefix_table.c"))
+        f.write('\n#include "ril_prefix.h"\n\n')
+        f.write("const uint8_t RIL_PREFIX_DISPLACEMENT[RIL_PREFIX_BUCKETS] = {\n   ")
+        for i, d in enumerate(disp):
+            f.write(" %d," % d)
+            if i % 16 == 15 and i + 1 != len(disp):
+                f.write("\n   ")
+        f.write("\n};\n\n")
+        f.write("const RIL_Prefix RIL_PREFIX_TABLE[RIL_PREFIX_COUNT] = {\n")
+        for i in slots:
+            name, kind, key = entries[i]
+            f.write("    { %-22s %2d, RIL_PREFIX_%-18s RIL_LINE_%-12s },\n"
+                    % (c_string(key) + ",", len(key), name + ",", kind))
+        f.write("};\n")
+
+
+def main():
+    entries = parse(SPEC)
+    keys = [e[2] for e in entries]
+    seed, buckets, slots, disp = build(keys)
+    emit(entries, seed, buckets, slots, disp)
+    print("%d prefixes, %d buckets, seed 0x%04X" % (len(keys), buckets, seed))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,109 @@
+/**
+ * @file ril_replay.c
+ * @author Hamid Salehi (hamsame.dev@gmail.com)
+ * @brief Replays a buffer trace through ril_stats and recommends buffer sizes
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026 Hamid Salehi
+ *
+ * Capture the trace on target by defining RIL_STATS_TRACE, one line per
+ * sample: "<tick ms> <buffer> <used bytes>", the buffer as rx, tx, line
+ * or its RIL_BufferId. Lines starting with '#' are skipped.
+ *
+ *     make -C test replay
+ *     test/build/ril_replay [-rx size] [-tx size] [-line size] trace.txt
+ *
+ * The sizes default to the ones in ril_config.h and have to match the
+ * build the trace was taken from. Usage is held between samples, as the
+ * ticks of RIL_process would see it.
+ */
+
+#include "ril_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* const NAMES[RIL_BUFFER_COUNT] = { "rx", "tx", "line" };
+
+static int _bufferId(const char* name){
+    for (int i = 0; i < RIL_BUFFER_COUNT; i++){
+        if (strcmp(name, NAMES[i]) == 0){
+            return i;
+        }
+    }
+    if (name[0] >= '0' && name[0] < '0' + RIL_BUFFER_COUNT && name[1] == 0){
+        return name[0] - '0';
+    }
+    return -1;
+}
+
+int main(int argc, char** argv){
+    uint32_t sizes[RIL_BUFFER_COUNT] = { RIL_RX_STREAM_SIZE, RIL_TX_STREAM_SIZE, RIL_LINE_LEN };
+    const char* path = NULL;
+
+    for (int i = 1; i < argc; i++){
+        int id = argv[i][0] == '-' ? _bufferId(&argv[i][1]) : -1;
+        if (id >= 0 && i + 1 < argc){
+            sizes[id] = (uint32_t) strtoul(argv[++i], NULL, 10);
+        }
+        else if (argv[i][0] != '-' && path == NULL){
+            path = argv[i];
+        }
+        else {
+            path = NULL;
+            break;
+        }
+    }
+    FILE* file = path != NULL ? fopen(path, "r") : NULL;
+    if (file == NULL){
+        fprintf(stderr, "usage: ril_replay [-rx size] [-tx size] [-line size] trace.txt\n");
+        return 2;
+    }
+
+    RIL_BufferStats stats[RIL_BUFFER_COUNT];
+    uint32_t used[RIL_BUFFER_COUNT] = { 0 };
+    for (int i = 0; i < RIL_BUFFER_COUNT; i++){
+        RIL_bufferStats_init(&stats[i], sizes[i]);
+    }
+
+    char line[128];
+    unsigned long lineNo = 0, first = 0, last = 0, samples = 0;
+    while (fgets(line, sizeof(line), file) != NULL){
+        unsigned long now, value;
+        char name[16];
+        lineNo++;
+        if (line[0] == '#' || line[0] == '\n'){
+            continue;
+        }
+        int id = -1;
+        if (sscanf(line, "%lu %15s %lu", &now, name, &value) != 3 || (id = _bufferId(name)) < 0){
+            fprintf(stderr, "%s:%lu: expected \"<tick> <rx|tx|line> <used>\"\n", path, lineNo);
+            fclose(file);
+            return 2;
+        }
+        if (samples++ == 0){
+            first = now;
+        }
+        last = now;
+        // The other buffers kept their usage up to this tick
+        for (int i = 0; i < RIL_BUFFER_COUNT; i++){
+            RIL_bufferStats_tick(&stats[i], used[i], (uint32_t) now);
+        }
+        RIL_bufferStats_sample(&stats[id], (uint32_t) value, (uint32_t) now);
+        // A clipped sample stands for a full buffer until the next one
+        used[id] = value < sizes[id] ? (uint32_t) value : sizes[id];
+    }
+    fclose(file);
+
+    printf("%lu samples over %lu ms\n", samples, last - first);
+    printf("%-5s %6s %6s %9s %12s %8s %12s\n", "", "size", "peak", "samples", "near overrun", "% >75", "recommended");
+    for (int i = 0; i < RIL_BUFFER_COUNT; i++){
+        const RIL_BufferStats* s = &stats[i];
+        printf("%-5s %6lu %6lu %9lu %12lu %7.1f%% %12lu\n", NAMES[i], (unsigned long) s->Size,
+               (unsigned long) s->HighWater, (unsigned long) s->Samples, (unsigned long) s->NearOverrun,
+               last > first ? 100.0 * s->TimeAbove75 / (double) (last - first) : 0.0,
+               (unsigned long) RIL_bufferStats_recommend(s));
+    }
+    return 0;
+}